@@ -0,0 +1,404 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace Excalibur
+{
+
+/*
+
+Linear (bump) arena. Allocation is a pointer increment, individual deallocations are ignored
+(except for the most recent one, which is rolled back). All the memory is recycled at once with reset().
+
+Typical use: per-frame/per-request tables. Reset the arena only after all the tables using it are destroyed.
+Not thread-safe.
+
+*/
+class Arena
+{
+    struct Chunk
+    {
+        char* begin;
+        size_t size;
+    };
+
+    static inline constexpr size_t k_ChunkAlignment = 64;
+
+  public:
+    explicit Arena(size_t chunkSize = size_t(1) << 20) noexcept
+        : m_chunkSize(chunkSize)
+    {
+    }
+
+    ~Arena() noexcept
+    {
+        for (const Chunk& chunk : m_chunks)
+        {
+            EXLBR_FREE(chunk.begin);
+        }
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    [[nodiscard]] void* allocate(size_t numBytes, size_t alignment) noexcept
+    {
+        EXLBR_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        while (true)
+        {
+            if (m_chunkIndex < m_chunks.size())
+            {
+                const Chunk& chunk = m_chunks[m_chunkIndex];
+                const size_t offset = (m_cursor + (alignment - 1)) & ~(alignment - 1);
+                if (offset + numBytes <= chunk.size)
+                {
+                    m_cursor = offset + numBytes;
+                    m_numBytesUsed += numBytes;
+                    return chunk.begin + offset;
+                }
+
+                // try the next (already allocated) chunk
+                if (m_chunkIndex + 1 < m_chunks.size())
+                {
+                    m_chunkIndex++;
+                    m_cursor = 0;
+                    continue;
+                }
+            }
+
+            const size_t chunkAlignment = std::max(alignment, k_ChunkAlignment);
+            size_t chunkSize = std::max(m_chunkSize, numBytes);
+            chunkSize = (chunkSize + (chunkAlignment - 1)) & ~(chunkAlignment - 1);
+            char* begin = reinterpret_cast<char*>(EXLBR_ALLOC(chunkSize, chunkAlignment));
+            if (begin == nullptr)
+            {
+                return nullptr;
+            }
+            m_chunks.push_back(Chunk{begin, chunkSize});
+            m_chunkIndex = m_chunks.size() - 1;
+            m_cursor = 0;
+        }
+    }
+
+    void deallocate(void* ptr, size_t numBytes) noexcept
+    {
+        if (m_chunkIndex >= m_chunks.size())
+        {
+            return;
+        }
+        // only the most recent allocation can be given back
+        char* const chunkBegin = m_chunks[m_chunkIndex].begin;
+        if (reinterpret_cast<char*>(ptr) + numBytes == chunkBegin + m_cursor)
+        {
+            m_cursor -= numBytes;
+            m_numBytesUsed -= numBytes;
+        }
+    }
+
+    // recycles all the memory (chunks are kept for the next round)
+    void reset() noexcept
+    {
+        m_chunkIndex = 0;
+        m_cursor = 0;
+        m_numBytesUsed = 0;
+    }
+
+    [[nodiscard]] size_t getNumBytesUsed() const noexcept { return m_numBytesUsed; }
+
+    [[nodiscard]] size_t getNumBytesReserved() const noexcept
+    {
+        size_t res = 0;
+        for (const Chunk& chunk : m_chunks)
+        {
+            res += chunk.size;
+        }
+        return res;
+    }
+
+  private:
+    std::vector<Chunk> m_chunks;
+    size_t m_chunkSize;
+    size_t m_chunkIndex = 0;
+    size_t m_cursor = 0;
+    size_t m_numBytesUsed = 0;
+};
+
+struct ArenaAllocator
+{
+    explicit ArenaAllocator(Arena& arena) noexcept
+        : m_arena(&arena)
+    {
+    }
+
+    [[nodiscard]] inline void* allocate(size_t numBytes, size_t alignment) noexcept { return m_arena->allocate(numBytes, alignment); }
+    inline void deallocate(void* ptr, size_t numBytes, size_t /*alignment*/) noexcept { m_arena->deallocate(ptr, numBytes); }
+
+    Arena* m_arena;
+};
+
+/*
+
+Pool of freed blocks. Freed blocks are cached per (size, alignment) and handed out again without touching the system allocator.
+Hash table storage sizes are always power-of-two multiples of the item size, so a pool quickly covers all the sizes a table goes through.
+Not thread-safe (use one pool per thread).
+
+*/
+class Pool
+{
+    struct Bin
+    {
+        size_t size;
+        size_t alignment;
+        void* head;
+    };
+
+    struct FreeBlock
+    {
+        void* next;
+    };
+
+    [[nodiscard]] Bin& getBin(size_t numBytes, size_t alignment)
+    {
+        for (Bin& bin : m_bins)
+        {
+            if (bin.size == numBytes && bin.alignment == alignment)
+            {
+                return bin;
+            }
+        }
+        m_bins.push_back(Bin{numBytes, alignment, nullptr});
+        return m_bins.back();
+    }
+
+  public:
+    Pool() = default;
+    ~Pool() noexcept { trim(); }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    [[nodiscard]] void* allocate(size_t numBytes, size_t alignment)
+    {
+        // freed block has to be able to hold the free list link
+        numBytes = std::max(numBytes, sizeof(FreeBlock));
+        alignment = std::max(alignment, alignof(FreeBlock));
+        numBytes = (numBytes + (alignment - 1)) & ~(alignment - 1);
+
+        Bin& bin = getBin(numBytes, alignment);
+        if (bin.head)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(bin.head);
+            bin.head = block->next;
+            m_numBytesCached -= numBytes;
+            return block;
+        }
+        return EXLBR_ALLOC(numBytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t numBytes, size_t alignment)
+    {
+        numBytes = std::max(numBytes, sizeof(FreeBlock));
+        alignment = std::max(alignment, alignof(FreeBlock));
+        numBytes = (numBytes + (alignment - 1)) & ~(alignment - 1);
+
+        Bin& bin = getBin(numBytes, alignment);
+        FreeBlock* block = new (ptr) FreeBlock();
+        block->next = bin.head;
+        bin.head = block;
+        m_numBytesCached += numBytes;
+    }
+
+    // gives all the cached blocks back to the system
+    void trim() noexcept
+    {
+        for (Bin& bin : m_bins)
+        {
+            while (bin.head)
+            {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(bin.head);
+                bin.head = block->next;
+                EXLBR_FREE(block);
+            }
+        }
+        m_numBytesCached = 0;
+    }
+
+    [[nodiscard]] size_t getNumBytesCached() const noexcept { return m_numBytesCached; }
+
+  private:
+    std::vector<Bin> m_bins;
+    size_t m_numBytesCached = 0;
+};
+
+struct PoolAllocator
+{
+    explicit PoolAllocator(Pool& pool) noexcept
+        : m_pool(&pool)
+    {
+    }
+
+    [[nodiscard]] inline void* allocate(size_t numBytes, size_t alignment) { return m_pool->allocate(numBytes, alignment); }
+    inline void deallocate(void* ptr, size_t numBytes, size_t alignment) { m_pool->deallocate(ptr, numBytes, alignment); }
+
+    Pool* m_pool;
+};
+
+enum class HugePageMode
+{
+    // madvise(MADV_HUGEPAGE), the kernel backs the range with 2MB pages when it can
+    Transparent,
+    // mmap(MAP_HUGETLB), requires pre-reserved huge pages (vm.nr_hugepages), falls back to Transparent if there are none
+    Explicit
+};
+
+enum class NumaPolicy
+{
+    // first touch (the thread that creates the table)
+    Default,
+    // all the pages on the nodes from the mask
+    Bind,
+    // pages are spread round-robin over the nodes from the mask
+    Interleave
+};
+
+struct HugePageOptions
+{
+    static inline constexpr size_t k_HugePageSize = size_t(2) << 20;
+
+    // smaller allocations go to EXLBR_ALLOC
+    size_t threshold = k_HugePageSize;
+    HugePageMode mode = HugePageMode::Transparent;
+    NumaPolicy numaPolicy = NumaPolicy::Default;
+    // bit N = NUMA node N
+    uint64_t numaNodeMask = 1;
+};
+
+/*
+
+Backs large bucket arrays with 2MB huge pages (fewer TLB misses on random probes) and optionally binds or interleaves them across NUMA nodes.
+Allocations smaller than the threshold go to EXLBR_ALLOC. On platforms without mmap everything goes to EXLBR_ALLOC.
+
+The NUMA policy is applied with the raw mbind syscall (no libnuma dependency) before the pages are touched.
+Huge pages and NUMA placement are best effort: if the kernel refuses, the memory is still valid, just backed by regular pages.
+
+*/
+class HugePageAllocator
+{
+  public:
+    static inline constexpr size_t k_HugePageSize = HugePageOptions::k_HugePageSize;
+
+    HugePageAllocator() noexcept = default;
+    explicit HugePageAllocator(const HugePageOptions& options) noexcept
+        : m_options(options)
+    {
+    }
+
+    [[nodiscard]] static inline size_t roundToHugePage(size_t numBytes) noexcept { return (numBytes + (k_HugePageSize - 1)) & ~(k_HugePageSize - 1); }
+
+    [[nodiscard]] inline const HugePageOptions& getOptions() const noexcept { return m_options; }
+
+    [[nodiscard]] void* allocate(size_t numBytes, size_t alignment) const noexcept
+    {
+#if defined(__linux__)
+        if (numBytes >= m_options.threshold)
+        {
+            EXLBR_ASSERT(alignment <= k_HugePageSize);
+            const size_t numBytesMapped = roundToHugePage(numBytes);
+            void* res = nullptr;
+    #if defined(MAP_HUGETLB)
+            if (m_options.mode == HugePageMode::Explicit)
+            {
+                void* raw = mmap(nullptr, numBytesMapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                res = (raw == MAP_FAILED) ? nullptr : raw;
+            }
+    #endif
+            if (res == nullptr)
+            {
+                res = mapTransparent(numBytesMapped);
+            }
+            if (res)
+            {
+                applyNumaPolicy(res, numBytesMapped);
+            }
+            return res;
+        }
+#endif
+        return EXLBR_ALLOC(numBytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t numBytes, size_t /*alignment*/) const noexcept
+    {
+#if defined(__linux__)
+        if (numBytes >= m_options.threshold)
+        {
+            munmap(ptr, roundToHugePage(numBytes));
+            return;
+        }
+#endif
+        EXLBR_FREE(ptr);
+    }
+
+  private:
+#if defined(__linux__)
+    [[nodiscard]] static void* mapTransparent(size_t numBytesMapped) noexcept
+    {
+        // over-allocate to be able to align the block to the huge page boundary
+        const size_t numBytesReserved = numBytesMapped + k_HugePageSize;
+        void* raw = mmap(nullptr, numBytesReserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        char* const begin = reinterpret_cast<char*>(raw);
+        char* const aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(begin) + (k_HugePageSize - 1)) & ~uintptr_t(k_HugePageSize - 1));
+        const size_t head = size_t(aligned - begin);
+        const size_t tail = numBytesReserved - head - numBytesMapped;
+        if (head)
+        {
+            munmap(begin, head);
+        }
+        if (tail)
+        {
+            munmap(aligned + numBytesMapped, tail);
+        }
+    #if defined(MADV_HUGEPAGE)
+        madvise(aligned, numBytesMapped, MADV_HUGEPAGE);
+    #endif
+        return aligned;
+    }
+
+    void applyNumaPolicy(void* ptr, size_t numBytesMapped) const noexcept
+    {
+    #if defined(SYS_mbind)
+        if (m_options.numaPolicy == NumaPolicy::Default || m_options.numaNodeMask == 0)
+        {
+            return;
+        }
+        // values from <numaif.h>
+        const long kMpolBind = 2;
+        const long kMpolInterleave = 3;
+        const long mode = (m_options.numaPolicy == NumaPolicy::Bind) ? kMpolBind : kMpolInterleave;
+        const unsigned long nodeMask = (unsigned long)m_options.numaNodeMask;
+        // note: kernel reads 'maxnode - 1' bits
+        const unsigned long maxNode = sizeof(nodeMask) * 8 + 1;
+        syscall(SYS_mbind, ptr, numBytesMapped, mode, &nodeMask, maxNode, 0);
+    #else
+        (void)ptr;
+        (void)numBytesMapped;
+    #endif
+    }
+#endif
+
+    HugePageOptions m_options;
+};
+
+} // namespace Excalibur
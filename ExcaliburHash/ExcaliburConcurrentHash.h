@@ -0,0 +1,708 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace Excalibur
+{
+
+namespace detail
+{
+
+// Process-wide epoch based reclamation domain.
+// Every thread that touches a concurrent table owns a slot where it publishes the epoch it entered with (0 = not inside).
+// Memory retired at epoch E can be freed once no thread is inside with an epoch <= E.
+class EpochDomain
+{
+  public:
+    // slots are allocated in blocks, a new block is appended once all the existing slots are in use
+    static inline constexpr uint32_t kSlotsPerBlock = 64;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint32_t> used{0};
+    };
+
+    struct SlotBlock
+    {
+        Slot slots[kSlotsPerBlock];
+        std::atomic<SlotBlock*> next{nullptr};
+    };
+
+    static EpochDomain& get() noexcept
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    [[nodiscard]] Slot& getThreadSlot() noexcept
+    {
+        struct ThreadSlot
+        {
+            Slot* slot;
+            ThreadSlot() noexcept
+                : slot(&EpochDomain::get().acquireSlot())
+            {
+            }
+            ~ThreadSlot() noexcept { slot->used.store(0); }
+        };
+        thread_local ThreadSlot threadSlot;
+        return *threadSlot.slot;
+    }
+
+    // note: all operations are seq_cst, the ordering between the epoch publication and the table pointer load matters
+    void enter(Slot& slot) noexcept { slot.epoch.store(m_globalEpoch.load()); }
+
+    void leave(Slot& slot) noexcept { slot.epoch.store(0); }
+
+    [[nodiscard]] uint64_t advance() noexcept { return m_globalEpoch.fetch_add(1); }
+
+    // returns the smallest epoch any thread is currently inside with (or UINT64_MAX)
+    [[nodiscard]] uint64_t getMinActiveEpoch() const noexcept
+    {
+        uint64_t minEpoch = UINT64_MAX;
+        for (const SlotBlock* block = &m_firstBlock; block != nullptr; block = block->next.load())
+        {
+            for (const Slot& slot : block->slots)
+            {
+                const uint64_t epoch = slot.epoch.load();
+                minEpoch = (epoch != 0 && epoch < minEpoch) ? epoch : minEpoch;
+            }
+        }
+        return minEpoch;
+    }
+
+    ~EpochDomain()
+    {
+        SlotBlock* block = m_firstBlock.next.load();
+        while (block != nullptr)
+        {
+            SlotBlock* next = block->next.load();
+            delete block;
+            block = next;
+        }
+    }
+
+  private:
+    EpochDomain() = default;
+
+    // a free slot (slots of exited threads are reused), blocks are never released while the domain is alive
+    [[nodiscard]] Slot& acquireSlot() noexcept
+    {
+        SlotBlock* block = &m_firstBlock;
+        while (true)
+        {
+            for (Slot& slot : block->slots)
+            {
+                uint32_t expected = 0;
+                if (slot.used.load(std::memory_order_relaxed) == 0 && slot.used.compare_exchange_strong(expected, 1))
+                {
+                    return slot;
+                }
+            }
+
+            SlotBlock* next = block->next.load();
+            if (next == nullptr)
+            {
+                // more threads than slots: append a block (or use the one another thread appended in the meantime)
+                SlotBlock* newBlock = new SlotBlock();
+                if (block->next.compare_exchange_strong(next, newBlock))
+                {
+                    next = newBlock;
+                }
+                else
+                {
+                    delete newBlock;
+                }
+            }
+            block = next;
+        }
+    }
+
+    std::atomic<uint64_t> m_globalEpoch{1};
+    SlotBlock m_firstBlock;
+};
+
+class EpochGuard
+{
+  public:
+    EpochGuard() noexcept
+        : m_slot(EpochDomain::get().getThreadSlot())
+    {
+        // nested guards keep the outer (older) epoch
+        m_isOuter = (m_slot.epoch.load(std::memory_order_relaxed) == 0);
+        if (m_isOuter)
+        {
+            EpochDomain::get().enter(m_slot);
+        }
+    }
+
+    ~EpochGuard() noexcept
+    {
+        if (m_isOuter)
+        {
+            EpochDomain::get().leave(m_slot);
+        }
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+  private:
+    EpochDomain::Slot& m_slot;
+    bool m_isOuter;
+};
+
+} // namespace detail
+
+/*
+
+Concurrent read-mostly hash table (linear probing, same item layout and KeyInfo contract as HashTable).
+
+Readers are lock-free: they never write to shared memory. Buckets are split into stripes (contiguous ranges of buckets),
+every stripe has a sequence counter that is odd while a writer modifies it (seqlock). Readers copy the key/value
+and retry the slot if the sequence counter changed.
+
+Writers lock the stripes covered by their probe sequence (always in ascending order), so writers working on
+different parts of the table don't block each other.
+
+Growth locks all stripes, copies items into a new bucket array, publishes it and retires the old array.
+The old array is freed once no reader can reference it anymore (epoch based reclamation).
+
+Keys and values have to be trivially copyable since readers copy them while a writer might be modifying them.
+Slots never go back from valid/tombstone to empty, this is what makes a lock-free probe stop at the right place.
+
+*/
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>> class ConcurrentHashTable
+{
+    static_assert(std::is_trivially_copyable<TKey>::value, "Concurrent readers copy keys without locking, key type must be trivially copyable");
+    static_assert(std::is_trivially_copyable<TValue>::value,
+                  "Concurrent readers copy values without locking, value type must be trivially copyable");
+
+    static inline constexpr uint32_t k_MinNumberOfBuckets = 64;
+    static inline constexpr uint32_t k_MaxNumStripes = 64;
+
+    struct TItem
+    {
+        TKey m_key;
+        TValue m_value;
+    };
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint32_t> seq{0};
+        std::atomic<uint32_t> lock{0};
+    };
+
+    struct Buckets
+    {
+        Stripe stripes[k_MaxNumStripes];
+        TItem* items;
+        uint32_t numBuckets;
+        uint32_t numStripes;
+        uint32_t stripeShift;
+
+        [[nodiscard]] inline Stripe& getStripe(size_t index) noexcept { return stripes[index >> stripeShift]; }
+    };
+
+    using StripeMask = uint64_t;
+    static_assert(sizeof(StripeMask) * 8 >= k_MaxNumStripes, "Stripe mask is too small");
+
+    [[nodiscard]] static inline uint32_t log2(uint32_t v) noexcept
+    {
+        uint32_t res = 0;
+        while ((1u << res) < v)
+        {
+            res++;
+        }
+        return res;
+    }
+
+    [[nodiscard]] static Buckets* createBuckets(uint32_t numBuckets)
+    {
+        EXLBR_ASSERT((numBuckets & (numBuckets - 1)) == 0);
+        Buckets* buckets = new Buckets();
+        buckets->numBuckets = numBuckets;
+        buckets->numStripes = std::min(numBuckets, k_MaxNumStripes);
+        buckets->stripeShift = log2(numBuckets) - log2(buckets->numStripes);
+
+        const size_t alignment = std::max(alignof(TItem), size_t(64));
+        const size_t numBytes = ((sizeof(TItem) * numBuckets) + (alignment - 1)) & ~(alignment - 1);
+        void* raw = EXLBR_ALLOC(numBytes, alignment);
+        EXLBR_ASSERT(raw);
+        buckets->items = reinterpret_cast<TItem*>(raw);
+
+        const TKey emptyKey = TKeyInfo::getEmpty();
+        for (uint32_t i = 0; i < numBuckets; i++)
+        {
+            memcpy(&buckets->items[i].m_key, &emptyKey, sizeof(TKey));
+        }
+        return buckets;
+    }
+
+    static void destroyBuckets(Buckets* buckets) noexcept
+    {
+        EXLBR_FREE(buckets->items);
+        delete buckets;
+    }
+
+    template <typename T> [[nodiscard]] static inline T readRacy(const T* src) noexcept
+    {
+        T res;
+        memcpy(&res, src, sizeof(T));
+        return res;
+    }
+
+    static inline void lockStripe(Stripe& stripe) noexcept
+    {
+        while (stripe.lock.exchange(1, std::memory_order_acquire) != 0)
+        {
+            while (stripe.lock.load(std::memory_order_relaxed) != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    static inline void unlockStripe(Stripe& stripe) noexcept { stripe.lock.store(0, std::memory_order_release); }
+
+    static void lockStripes(Buckets* buckets, StripeMask mask) noexcept
+    {
+        // ascending order = no deadlocks
+        for (uint32_t i = 0; i < buckets->numStripes; i++)
+        {
+            if (mask & (StripeMask(1) << i))
+            {
+                lockStripe(buckets->stripes[i]);
+            }
+        }
+    }
+
+    static void unlockStripes(Buckets* buckets, StripeMask mask) noexcept
+    {
+        for (uint32_t i = 0; i < buckets->numStripes; i++)
+        {
+            if (mask & (StripeMask(1) << i))
+            {
+                unlockStripe(buckets->stripes[i]);
+            }
+        }
+    }
+
+    // mask of all stripes covering buckets [firstIndex, lastIndex] (with wrap around)
+    [[nodiscard]] static StripeMask getStripeMask(const Buckets* buckets, size_t firstIndex, size_t lastIndex) noexcept
+    {
+        const uint32_t shift = buckets->stripeShift;
+        size_t stripe = firstIndex >> shift;
+        const size_t lastStripe = lastIndex >> shift;
+        const size_t stripeMask = buckets->numStripes - 1;
+        StripeMask mask = StripeMask(1) << stripe;
+        if (firstIndex > lastIndex && stripe == lastStripe)
+        {
+            // wrapped around the whole table
+            return ~StripeMask(0);
+        }
+        while (stripe != lastStripe)
+        {
+            stripe = (stripe + 1) & stripeMask;
+            mask |= StripeMask(1) << stripe;
+        }
+        return mask;
+    }
+
+    // seqlock write section
+    template <typename TFunc> static inline void writeSlot(Stripe& stripe, TFunc&& func) noexcept
+    {
+        const uint32_t seq = stripe.seq.load(std::memory_order_relaxed);
+        stripe.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        func();
+        stripe.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // seqlock read section, returns a consistent copy of the slot key (and the value if 'value' is set and 'needValue(key)' is true)
+    template <typename TPredicate>
+    [[nodiscard]] static inline TKey readSlot(Stripe& stripe, const TItem* item, TValue* value, TPredicate&& needValue) noexcept
+    {
+        while (true)
+        {
+            const uint32_t seq = stripe.seq.load(std::memory_order_acquire);
+            if (seq & 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            TKey key = readRacy(&item->m_key);
+            if (value && needValue(key))
+            {
+                *value = readRacy(&item->m_value);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (stripe.seq.load(std::memory_order_relaxed) == seq)
+            {
+                return key;
+            }
+        }
+    }
+
+    [[nodiscard]] static inline TKey readSlotKey(Stripe& stripe, const TItem* item) noexcept
+    {
+        return readSlot(stripe, item, nullptr, [](const TKey&) { return false; });
+    }
+
+    struct ProbeResult
+    {
+        size_t foundIndex;  // index of the key or SIZE_MAX
+        size_t insertIndex; // first tombstone or empty slot (SIZE_MAX if the table is full)
+        size_t lastIndex;   // last probed index
+    };
+
+    // if 'isLocked' is set, the caller holds the locks for the probe range and seqlock validation is not needed
+    [[nodiscard]] static ProbeResult probe(Buckets* buckets, const TKey& key, size_t hashValue, bool isLocked) noexcept
+    {
+        const size_t numBuckets = buckets->numBuckets;
+        const size_t mask = numBuckets - 1;
+        size_t index = hashValue & mask;
+        ProbeResult res{SIZE_MAX, SIZE_MAX, index};
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            TItem* item = buckets->items + index;
+            const TKey itemKey = isLocked ? item->m_key : readSlotKey(buckets->getStripe(index), item);
+            res.lastIndex = index;
+            if (TKeyInfo::isEqual(key, itemKey))
+            {
+                res.foundIndex = index;
+                return res;
+            }
+
+            if (detail::isEmptyKey<TKeyInfo>(itemKey))
+            {
+                res.insertIndex = (res.insertIndex == SIZE_MAX) ? index : res.insertIndex;
+                return res;
+            }
+
+            if (res.insertIndex == SIZE_MAX && detail::isTombstoneKey<TKeyInfo>(itemKey))
+            {
+                res.insertIndex = index;
+            }
+            index = (index + 1) & mask;
+        }
+        return res;
+    }
+
+    [[nodiscard]] inline bool isGrowthRequired(const Buckets* buckets) const noexcept
+    {
+        const uint32_t numBuckets = buckets->numBuckets;
+        const uint32_t numBucketsThreshold = (numBuckets >> 1) + (numBuckets >> 2) + 1;
+        return (m_numElements.load(std::memory_order_relaxed) + m_numTombstones.load(std::memory_order_relaxed)) >= numBucketsThreshold;
+    }
+
+    void grow(Buckets* buckets)
+    {
+        const StripeMask allStripes = getStripeMask(buckets, 0, buckets->numBuckets - 1);
+        lockStripes(buckets, allStripes);
+        if (m_buckets.load() != buckets || !isGrowthRequired(buckets))
+        {
+            // somebody else already did it
+            unlockStripes(buckets, allStripes);
+            return;
+        }
+
+        // lots of tombstones = rehash in place
+        const uint32_t numElements = m_numElements.load(std::memory_order_relaxed);
+        const uint32_t numBucketsNew = (numElements < (buckets->numBuckets >> 2)) ? buckets->numBuckets : buckets->numBuckets * 2;
+        Buckets* bucketsNew = createBuckets(numBucketsNew);
+        const size_t maskNew = numBucketsNew - 1;
+        for (uint32_t i = 0; i < buckets->numBuckets; i++)
+        {
+            const TItem& item = buckets->items[i];
+            if (!TKeyInfo::isValid(item.m_key))
+            {
+                continue;
+            }
+            size_t index = TKeyInfo::hash(item.m_key) & maskNew;
+            while (!detail::isEmptyKey<TKeyInfo>(bucketsNew->items[index].m_key))
+            {
+                index = (index + 1) & maskNew;
+            }
+            memcpy(&bucketsNew->items[index], &item, sizeof(TItem));
+        }
+        m_numTombstones.store(0, std::memory_order_relaxed);
+        m_buckets.store(bucketsNew);
+
+        // writers waiting for the old stripes will notice that the table pointer has changed
+        unlockStripes(buckets, allStripes);
+        retire(buckets);
+    }
+
+    void retire(Buckets* buckets)
+    {
+        std::lock_guard<std::mutex> lock(m_retiredLock);
+        const uint64_t epoch = detail::EpochDomain::get().advance();
+        m_retired.push_back(std::make_pair(epoch, buckets));
+    }
+
+    void reclaimLocked() noexcept
+    {
+        const uint64_t minActiveEpoch = detail::EpochDomain::get().getMinActiveEpoch();
+        size_t numLeft = 0;
+        for (size_t i = 0; i < m_retired.size(); i++)
+        {
+            if (m_retired[i].first < minActiveEpoch)
+            {
+                destroyBuckets(m_retired[i].second);
+            }
+            else
+            {
+                m_retired[numLeft++] = m_retired[i];
+            }
+        }
+        m_retired.resize(numLeft);
+    }
+
+    enum class InsertMode
+    {
+        Insert,
+        Assign
+    };
+
+    enum class InsertResult
+    {
+        Inserted,
+        Exists,
+        Retry
+    };
+
+    InsertResult tryInsert(Buckets* buckets, const TKey& key, const TValue& value, size_t hashValue, InsertMode mode)
+    {
+        // optimistic probe to find out which stripes we need
+        const ProbeResult optimistic = probe(buckets, key, hashValue, false);
+        const size_t firstIndex = hashValue & (buckets->numBuckets - 1);
+        const StripeMask stripes = getStripeMask(buckets, firstIndex, optimistic.lastIndex);
+        lockStripes(buckets, stripes);
+
+        // now the probe range can't change, check again
+        const ProbeResult res = probe(buckets, key, hashValue, true);
+        if (m_buckets.load() != buckets || res.lastIndex != optimistic.lastIndex)
+        {
+            unlockStripes(buckets, stripes);
+            return InsertResult::Retry;
+        }
+
+        if (res.foundIndex != SIZE_MAX)
+        {
+            if (mode == InsertMode::Assign)
+            {
+                TItem* item = buckets->items + res.foundIndex;
+                writeSlot(buckets->getStripe(res.foundIndex), [&]() { memcpy(&item->m_value, &value, sizeof(TValue)); });
+            }
+            unlockStripes(buckets, stripes);
+            return InsertResult::Exists;
+        }
+
+        // several writers could pass the growth check at the same time
+        if (res.insertIndex == SIZE_MAX || isGrowthRequired(buckets))
+        {
+            unlockStripes(buckets, stripes);
+            return InsertResult::Retry;
+        }
+
+        TItem* item = buckets->items + res.insertIndex;
+        const bool isTombstone = detail::isTombstoneKey<TKeyInfo>(item->m_key);
+        writeSlot(buckets->getStripe(res.insertIndex),
+                  [&]()
+                  {
+                      memcpy(&item->m_value, &value, sizeof(TValue));
+                      memcpy(&item->m_key, &key, sizeof(TKey));
+                  });
+        m_numElements.fetch_add(1, std::memory_order_relaxed);
+        if (isTombstone)
+        {
+            m_numTombstones.fetch_sub(1, std::memory_order_relaxed);
+        }
+        unlockStripes(buckets, stripes);
+        return InsertResult::Inserted;
+    }
+
+    bool insert(const TKey& key, const TValue& value, InsertMode mode)
+    {
+        EXLBR_ASSERT(TKeyInfo::isValid(key));
+        const size_t hashValue = TKeyInfo::hash(key);
+        while (true)
+        {
+            bool isGrown = false;
+            {
+                detail::EpochGuard guard;
+                Buckets* buckets = m_buckets.load();
+                if (isGrowthRequired(buckets))
+                {
+                    grow(buckets);
+                    isGrown = true;
+                }
+                else
+                {
+                    const InsertResult res = tryInsert(buckets, key, value, hashValue, mode);
+                    if (res != InsertResult::Retry)
+                    {
+                        return res == InsertResult::Inserted;
+                    }
+                }
+            }
+
+            // outside of the guard, otherwise this thread would keep the old bucket array alive
+            if (isGrown)
+            {
+                reclaim();
+            }
+        }
+    }
+
+  public:
+    ConcurrentHashTable()
+        : m_buckets(createBuckets(k_MinNumberOfBuckets))
+        , m_numElements(0)
+        , m_numTombstones(0)
+    {
+    }
+
+    explicit ConcurrentHashTable(uint32_t numBuckets)
+        : m_buckets(createBuckets(std::max(numBuckets, k_MinNumberOfBuckets)))
+        , m_numElements(0)
+        , m_numTombstones(0)
+    {
+        EXLBR_ASSERT((numBuckets & (numBuckets - 1)) == 0);
+    }
+
+    // note: no other thread may access the table at this point
+    ~ConcurrentHashTable()
+    {
+        destroyBuckets(m_buckets.load());
+        for (const auto& retired : m_retired)
+        {
+            destroyBuckets(retired.second);
+        }
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    // returns false if the key already exists (the value is not modified)
+    inline bool emplace(const TKey& key, const TValue& value) { return insert(key, value, InsertMode::Insert); }
+
+    // returns true if a new item was inserted, false if the value of an existing item was replaced
+    inline bool insertOrAssign(const TKey& key, const TValue& value) { return insert(key, value, InsertMode::Assign); }
+
+    // lock-free lookup, copies the value into 'outValue' if the key exists
+    [[nodiscard]] inline bool find(const TKey& key, TValue& outValue) const noexcept
+    {
+        EXLBR_ASSERT(TKeyInfo::isValid(key));
+        detail::EpochGuard guard;
+        Buckets* buckets = m_buckets.load();
+        const size_t numBuckets = buckets->numBuckets;
+        const size_t mask = numBuckets - 1;
+        size_t index = TKeyInfo::hash(key) & mask;
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            TValue value{};
+            const TKey itemKey = readSlot(buckets->getStripe(index), buckets->items + index, &value,
+                                          [&key](const TKey& k) { return TKeyInfo::isEqual(key, k); });
+            if (EXLBR_LIKELY(TKeyInfo::isEqual(key, itemKey)))
+            {
+                outValue = value;
+                return true;
+            }
+
+            if (detail::isEmptyKey<TKeyInfo>(itemKey))
+            {
+                return false;
+            }
+            index = (index + 1) & mask;
+        }
+        return false;
+    }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept
+    {
+        TValue value{};
+        return find(key, value);
+    }
+
+    inline bool erase(const TKey& key)
+    {
+        EXLBR_ASSERT(TKeyInfo::isValid(key));
+        const size_t hashValue = TKeyInfo::hash(key);
+        while (true)
+        {
+            detail::EpochGuard guard;
+            Buckets* buckets = m_buckets.load();
+            const ProbeResult optimistic = probe(buckets, key, hashValue, false);
+            if (optimistic.foundIndex == SIZE_MAX)
+            {
+                return false;
+            }
+
+            Stripe& stripe = buckets->getStripe(optimistic.foundIndex);
+            lockStripe(stripe);
+            TItem* item = buckets->items + optimistic.foundIndex;
+            if (m_buckets.load() != buckets || !TKeyInfo::isEqual(key, item->m_key))
+            {
+                unlockStripe(stripe);
+                continue;
+            }
+
+            const TKey tombstone = TKeyInfo::getTombstone();
+            writeSlot(stripe, [&]() { memcpy(&item->m_key, &tombstone, sizeof(TKey)); });
+            m_numElements.fetch_sub(1, std::memory_order_relaxed);
+            m_numTombstones.fetch_add(1, std::memory_order_relaxed);
+            unlockStripe(stripe);
+            return true;
+        }
+    }
+
+    // frees retired bucket arrays that are no longer referenced by readers
+    inline void reclaim()
+    {
+        std::lock_guard<std::mutex> lock(m_retiredLock);
+        reclaimLocked();
+    }
+
+    [[nodiscard]] inline uint32_t size() const noexcept { return m_numElements.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] inline uint32_t capacity() const noexcept { return m_buckets.load()->numBuckets; }
+    [[nodiscard]] inline uint32_t getNumTombstones() const noexcept { return m_numTombstones.load(std::memory_order_relaxed); }
+
+    // note: not synchronized with writers, each item is read consistently but the snapshot as a whole is not
+    template <typename TFunc> inline void forEach(TFunc&& func) const
+    {
+        detail::EpochGuard guard;
+        Buckets* buckets = m_buckets.load();
+        for (size_t index = 0; index < buckets->numBuckets; index++)
+        {
+            TValue value{};
+            const TKey itemKey =
+                readSlot(buckets->getStripe(index), buckets->items + index, &value, [](const TKey& k) { return TKeyInfo::isValid(k); });
+            if (TKeyInfo::isValid(itemKey))
+            {
+                func(itemKey, value);
+            }
+        }
+    }
+
+  private:
+    std::atomic<Buckets*> m_buckets;
+    std::atomic<uint32_t> m_numElements;
+    std::atomic<uint32_t> m_numTombstones;
+    std::mutex m_retiredLock;
+    std::vector<std::pair<uint64_t, Buckets*>> m_retired;
+};
+
+// hashmap declaration
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>>
+using ConcurrentHashMap = ConcurrentHashTable<TKey, TValue, TKeyInfo>;
+
+} // namespace Excalibur
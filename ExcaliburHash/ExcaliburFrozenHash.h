@@ -0,0 +1,393 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <vector>
+
+namespace Excalibur
+{
+
+/*
+
+Read-only hash map built once from an existing HashTable (PTHash-style minimal perfect hashing).
+
+Keys are split into ~n/4 buckets by their hash and every bucket stores a 16-bit "pilot": a displacement that sends all the keys
+of the bucket to distinct free slots. Buckets are placed from the largest to the smallest one, trying pilots 0, 1, 2, ...
+Slots are taken out of a range slightly larger than the number of keys (98% load) to keep the search short,
+the few slots past the end are remapped into the holes left below it. The result is a dense item array with no empty slots:
+
+  find(key) = one hash, one pilot load, one slot, one key compare
+
+Memory per item is sizeof(key + value) plus ~0.6 bytes of pilots/remap, vs 1.33x..2.67x sizeof(key + value) for HashTable.
+
+Keys whose hash collides with another key (all 64 bits, or all 32 bits on 32-bit platforms) can't be separated by any pilot.
+They end up in a small regular HashTable that is only queried when the key at the slot doesn't match (empty almost always).
+
+*/
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>> class FrozenHashTable
+{
+    struct has_values : std::bool_constant<!std::is_same<std::nullptr_t, typename std::remove_reference<TValue>::type>::value>
+    {
+    };
+
+    template <typename TK> using enable_if_transparent = std::enable_if_t<detail::is_transparent_key<TKeyInfo, TKey, TK>::value>;
+
+    static inline constexpr uint32_t k_AvgBucketSize = 4;
+    static inline constexpr uint32_t k_MaxPilot = 0xffff;
+    static inline constexpr uint64_t k_Seed = 0x9E3779B97F4A7C15ull;
+
+    template <bool hasValue, typename dummy = void> struct Storage
+    {
+        struct TItem
+        {
+            TKey key;
+            TValue value;
+        };
+    };
+
+    template <typename dummy> struct Storage<false, dummy>
+    {
+        struct TItem
+        {
+            TKey key;
+        };
+    };
+
+  public:
+    using TItem = typename Storage<has_values::value>::TItem;
+
+  private:
+    using TOverflow = HashTable<TKey, TValue, 1, TKeyInfo>;
+
+    // maps a 32-bit value to [0, range) without a division
+    [[nodiscard]] static inline uint32_t fastRange(uint32_t v, uint32_t range) noexcept { return uint32_t((uint64_t(v) * range) >> 32); }
+
+    template <typename TK> [[nodiscard]] static inline uint64_t getKeyHash(const TK& key) noexcept
+    {
+        return detail::fmix64(uint64_t(TKeyInfo::hash(key)) ^ k_Seed);
+    }
+
+    [[nodiscard]] static inline uint32_t getPosition(uint64_t keyHash, uint32_t pilot, uint32_t tableSize) noexcept
+    {
+        return fastRange(uint32_t(detail::fmix64(keyHash + uint64_t(pilot) * k_Seed)), tableSize);
+    }
+
+    template <typename TK> [[nodiscard]] inline const TItem* findItem(const TK& key) const noexcept
+    {
+        if (EXLBR_UNLIKELY(m_items.empty()))
+        {
+            return nullptr;
+        }
+        const uint64_t keyHash = getKeyHash(key);
+        const uint32_t bucketIndex = fastRange(uint32_t(keyHash >> 32), uint32_t(m_pilots.size()));
+        const uint32_t position = getPosition(keyHash, m_pilots[bucketIndex], m_tableSize);
+        // positions past the last item are remapped into the holes (m_remap[0] always exists, so this is a select, not a branch)
+        const uint32_t numItems = uint32_t(m_items.size());
+        const bool isRemapped = (position >= numItems);
+        const uint32_t remapped = m_remap[isRemapped ? position - numItems : 0];
+        const TItem* item = m_items.data() + (isRemapped ? remapped : position);
+        return TKeyInfo::isEqual(key, item->key) ? item : nullptr;
+    }
+
+    template <typename TK> [[nodiscard]] inline const TValue* findValue(const TK& key) const noexcept
+    {
+        const TItem* item = findItem(key);
+        if (EXLBR_LIKELY(item != nullptr))
+        {
+            return &item->value;
+        }
+        if (EXLBR_LIKELY(m_overflow.empty()))
+        {
+            return nullptr;
+        }
+        auto it = m_overflow.find(key);
+        return (it != m_overflow.iend()) ? &it.value() : nullptr;
+    }
+
+    template <typename TK> [[nodiscard]] inline bool hasImpl(const TK& key) const noexcept
+    {
+        return (findItem(key) != nullptr) || (!m_overflow.empty() && m_overflow.has(key));
+    }
+
+    void build(std::vector<TItem>&& items)
+    {
+        const size_t numKeys = items.size();
+        EXLBR_ASSERT(numKeys < size_t(UINT32_MAX / 2));
+        if (numKeys == 0)
+        {
+            return;
+        }
+
+        std::vector<uint64_t> hashes(numKeys);
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            hashes[i] = getKeyHash(items[i].key);
+        }
+
+        // keys with identical hashes always land in the same slot
+        std::vector<uint32_t> order(numKeys);
+        for (uint32_t i = 0; i < uint32_t(numKeys); i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&hashes](uint32_t a, uint32_t b) { return hashes[a] < hashes[b]; });
+        std::vector<bool> isOverflow(numKeys, false);
+        for (size_t i = 1; i < numKeys; i++)
+        {
+            if (hashes[order[i]] == hashes[order[i - 1]])
+            {
+                isOverflow[order[i]] = true;
+            }
+        }
+
+        // group keys by bucket (counting sort)
+        const uint32_t numBuckets = uint32_t((numKeys + k_AvgBucketSize - 1) / k_AvgBucketSize);
+        std::vector<uint32_t> bucketStart(size_t(numBuckets) + 1, 0);
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            bucketStart[fastRange(uint32_t(hashes[i] >> 32), numBuckets) + 1]++;
+        }
+        for (uint32_t b = 0; b < numBuckets; b++)
+        {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        std::vector<uint32_t> bucketKeys(numKeys);
+        {
+            std::vector<uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+            for (uint32_t i = 0; i < uint32_t(numKeys); i++)
+            {
+                bucketKeys[cursor[fastRange(uint32_t(hashes[i] >> 32), numBuckets)]++] = i;
+            }
+        }
+
+        // largest buckets first (they are the hardest to place)
+        std::vector<uint32_t> buckets(numBuckets);
+        for (uint32_t b = 0; b < numBuckets; b++)
+        {
+            buckets[b] = b;
+        }
+        std::stable_sort(buckets.begin(), buckets.end(), [&bucketStart](uint32_t a, uint32_t b) {
+            return (bucketStart[a + 1] - bucketStart[a]) > (bucketStart[b + 1] - bucketStart[b]);
+        });
+
+        const uint32_t tableSize = uint32_t(numKeys + numKeys / 50 + 1);
+        std::vector<bool> isTaken(tableSize, false);
+        std::vector<uint32_t> positions(numKeys, 0);
+        std::vector<uint32_t> bucketPositions;
+        m_pilots.assign(numBuckets, 0);
+        for (uint32_t b : buckets)
+        {
+            const uint32_t* first = bucketKeys.data() + bucketStart[b];
+            const uint32_t* last = bucketKeys.data() + bucketStart[b + 1];
+            bool isPlaced = false;
+            for (uint32_t pilot = 0; pilot <= k_MaxPilot && !isPlaced; pilot++)
+            {
+                bucketPositions.clear();
+                isPlaced = true;
+                for (const uint32_t* key = first; key != last; key++)
+                {
+                    if (isOverflow[*key])
+                    {
+                        continue;
+                    }
+                    const uint32_t position = getPosition(hashes[*key], pilot, tableSize);
+                    if (isTaken[position])
+                    {
+                        isPlaced = false;
+                        break;
+                    }
+                    isTaken[position] = true;
+                    bucketPositions.push_back(position);
+                    positions[*key] = position;
+                }
+                if (!isPlaced)
+                {
+                    for (uint32_t position : bucketPositions)
+                    {
+                        isTaken[position] = false;
+                    }
+                    continue;
+                }
+                m_pilots[b] = uint16_t(pilot);
+            }
+
+            // practically unreachable, but keeps the build from failing
+            if (!isPlaced)
+            {
+                for (const uint32_t* key = first; key != last; key++)
+                {
+                    isOverflow[*key] = true;
+                }
+            }
+        }
+
+        // overflow keys go to a regular hash table
+        uint32_t numItems = 0;
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            if (!isOverflow[i])
+            {
+                numItems++;
+                continue;
+            }
+            if constexpr (has_values::value)
+            {
+                m_overflow.emplace(std::move(items[i].key), std::move(items[i].value));
+            }
+            else
+            {
+                m_overflow.emplace(std::move(items[i].key));
+            }
+        }
+
+        // remap the taken slots >= numItems into the free slots < numItems
+        m_tableSize = tableSize;
+        m_remap.assign(size_t(tableSize - numItems), 0);
+        uint32_t freeSlot = 0;
+        for (uint32_t position = numItems; position < tableSize; position++)
+        {
+            if (!isTaken[position])
+            {
+                continue;
+            }
+            while (isTaken[freeSlot])
+            {
+                freeSlot++;
+            }
+            m_remap[position - numItems] = freeSlot++;
+        }
+
+        // move items to their final slots
+        std::vector<uint32_t> slotToKey(numItems, 0);
+        for (uint32_t i = 0; i < uint32_t(numKeys); i++)
+        {
+            if (!isOverflow[i])
+            {
+                const uint32_t position = positions[i];
+                slotToKey[(position >= numItems) ? m_remap[position - numItems] : position] = i;
+            }
+        }
+        m_items.reserve(numItems);
+        for (uint32_t slot = 0; slot < numItems; slot++)
+        {
+            m_items.push_back(std::move(items[slotToKey[slot]]));
+        }
+    }
+
+    template <typename TTable> static std::vector<TItem> copyItems(const TTable& table)
+    {
+        std::vector<TItem> items;
+        items.reserve(table.size());
+        for (auto it = table.ibegin(); it != table.iend(); ++it)
+        {
+            if constexpr (has_values::value)
+            {
+                items.push_back(TItem{it.key(), it.value()});
+            }
+            else
+            {
+                items.push_back(TItem{it.key()});
+            }
+        }
+        return items;
+    }
+
+    template <typename TTable> static std::vector<TItem> moveItems(TTable& table)
+    {
+        // note: keys are copied, the source table would be left with moved-from keys otherwise
+        std::vector<TItem> items;
+        items.reserve(table.size());
+        for (auto it = table.ibegin(); it != table.iend(); ++it)
+        {
+            if constexpr (has_values::value)
+            {
+                items.push_back(TItem{it.key(), std::move(it.value())});
+            }
+            else
+            {
+                items.push_back(TItem{it.key()});
+            }
+        }
+        table.clear();
+        return items;
+    }
+
+  public:
+    FrozenHashTable() = default;
+
+    template <unsigned kNumInlineItems, typename TProbing, typename TAllocator, typename TShrinkPolicy>
+    explicit FrozenHashTable(const HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>& table)
+    {
+        build(copyItems(table));
+    }
+
+    // values are moved out, the source table is left empty
+    template <unsigned kNumInlineItems, typename TProbing, typename TAllocator, typename TShrinkPolicy>
+    explicit FrozenHashTable(HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>&& table)
+    {
+        build(moveItems(table));
+    }
+
+    [[nodiscard]] inline uint32_t size() const noexcept { return uint32_t(m_items.size()) + m_overflow.size(); }
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept { return hasImpl(key); }
+    template <typename TK, typename = enable_if_transparent<TK>> [[nodiscard]] inline bool has(const TK& key) const noexcept
+    {
+        return hasImpl(key);
+    }
+
+    // nullptr if the key doesn't exist (maps only)
+    [[nodiscard]] inline const TValue* find(const TKey& key) const noexcept { return findValue(key); }
+    template <typename TK, typename = enable_if_transparent<TK>> [[nodiscard]] inline const TValue* find(const TK& key) const noexcept
+    {
+        return findValue(key);
+    }
+
+    // iterates over all the items (forEach(const TKey& key, const TValue& value) for maps, forEach(const TKey& key) for sets)
+    template <typename TFunc> inline void forEach(TFunc&& func) const
+    {
+        for (const TItem& item : m_items)
+        {
+            if constexpr (has_values::value)
+            {
+                func(item.key, item.value);
+            }
+            else
+            {
+                func(item.key);
+            }
+        }
+        for (auto it = m_overflow.ibegin(); it != m_overflow.iend(); ++it)
+        {
+            if constexpr (has_values::value)
+            {
+                func(it.key(), it.value());
+            }
+            else
+            {
+                func(it.key());
+            }
+        }
+    }
+
+    // number of bytes used by the lookup structure (excluding the heap memory owned by keys/values)
+    [[nodiscard]] inline size_t getMemoryUsage() const noexcept
+    {
+        return m_items.capacity() * sizeof(TItem) + m_pilots.capacity() * sizeof(uint16_t) + m_remap.capacity() * sizeof(uint32_t) +
+               size_t(m_overflow.capacity()) * sizeof(TItem);
+    }
+
+    [[nodiscard]] inline uint32_t getNumOverflowItems() const noexcept { return m_overflow.size(); }
+
+  private:
+    std::vector<TItem> m_items;
+    std::vector<uint16_t> m_pilots;
+    std::vector<uint32_t> m_remap;
+    uint32_t m_tableSize = 0;
+    TOverflow m_overflow;
+};
+
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>> using FrozenHashMap = FrozenHashTable<TKey, TValue, TKeyInfo>;
+template <typename TKey, typename TKeyInfo = KeyInfo<TKey>> using FrozenHashSet = FrozenHashTable<TKey, std::nullptr_t, TKeyInfo>;
+
+} // namespace Excalibur
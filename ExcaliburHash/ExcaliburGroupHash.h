@@ -0,0 +1,660 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <string.h>
+
+#if !defined(EXLBR_GROUP_SSE2) && !defined(EXLBR_GROUP_NEON) && !defined(EXLBR_GROUP_SCALAR)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define EXLBR_GROUP_SSE2 (1)
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define EXLBR_GROUP_NEON (1)
+    #else
+        #define EXLBR_GROUP_SCALAR (1)
+    #endif
+#endif
+
+#if defined(EXLBR_GROUP_SSE2)
+    #include <emmintrin.h>
+#elif defined(EXLBR_GROUP_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace Excalibur
+{
+
+namespace detail
+{
+
+// Control bytes. A full slot stores the low 7 bits of the key hash (0..127),
+// so both sentinels are told apart from full slots by the sign bit alone.
+static constexpr int8_t kCtrlEmpty = int8_t(-128);
+static constexpr int8_t kCtrlTombstone = int8_t(-2);
+
+// Shared by all empty tables, so find() never has to check for a missing allocation
+alignas(16) inline constexpr int8_t kEmptyGroup[16] = {kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+                                                       kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+                                                       kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty};
+
+[[nodiscard]] inline uint32_t countTrailingZeros(uint32_t v) noexcept
+{
+    EXLBR_ASSERT(v != 0);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return uint32_t(index);
+#else
+    return uint32_t(__builtin_ctz(v));
+#endif
+}
+
+// 16 control bytes matched at once. Every method returns a bit mask with one bit per slot.
+struct Group
+{
+    static constexpr uint32_t kWidth = 16;
+
+#if defined(EXLBR_GROUP_SSE2)
+    __m128i ctrl;
+
+    explicit Group(const int8_t* EXLBR_RESTRICT pos) noexcept
+        : ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(pos)))
+    {
+    }
+
+    [[nodiscard]] inline uint32_t match(int8_t h2) const noexcept
+    {
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+    [[nodiscard]] inline uint32_t matchEmpty() const noexcept { return match(kCtrlEmpty); }
+    [[nodiscard]] inline uint32_t matchEmptyOrTombstone() const noexcept { return uint32_t(_mm_movemask_epi8(ctrl)); }
+    [[nodiscard]] inline uint32_t matchFull() const noexcept { return uint32_t(_mm_movemask_epi8(ctrl)) ^ 0xffffu; }
+
+#elif defined(EXLBR_GROUP_NEON)
+    int8x16_t ctrl;
+
+    explicit Group(const int8_t* EXLBR_RESTRICT pos) noexcept
+        : ctrl(vld1q_s8(pos))
+    {
+    }
+
+    [[nodiscard]] static inline uint32_t toMask(uint8x16_t cmp) noexcept
+    {
+        static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        uint8x16_t bits = vandq_u8(cmp, vld1q_u8(kBits));
+        return uint32_t(vaddv_u8(vget_low_u8(bits))) | (uint32_t(vaddv_u8(vget_high_u8(bits))) << 8u);
+    }
+
+    [[nodiscard]] inline uint32_t match(int8_t h2) const noexcept { return toMask(vceqq_s8(ctrl, vdupq_n_s8(h2))); }
+    [[nodiscard]] inline uint32_t matchEmpty() const noexcept { return match(kCtrlEmpty); }
+    [[nodiscard]] inline uint32_t matchEmptyOrTombstone() const noexcept { return toMask(vcltzq_s8(ctrl)); }
+    [[nodiscard]] inline uint32_t matchFull() const noexcept { return toMask(vcgezq_s8(ctrl)); }
+
+#else
+    const int8_t* ctrl;
+
+    explicit Group(const int8_t* EXLBR_RESTRICT pos) noexcept
+        : ctrl(pos)
+    {
+    }
+
+    [[nodiscard]] inline uint32_t match(int8_t h2) const noexcept
+    {
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < kWidth; i++)
+        {
+            mask |= uint32_t(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+    [[nodiscard]] inline uint32_t matchEmpty() const noexcept { return match(kCtrlEmpty); }
+    [[nodiscard]] inline uint32_t matchEmptyOrTombstone() const noexcept
+    {
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < kWidth; i++)
+        {
+            mask |= uint32_t(ctrl[i] < 0) << i;
+        }
+        return mask;
+    }
+    [[nodiscard]] inline uint32_t matchFull() const noexcept { return matchEmptyOrTombstone() ^ 0xffffu; }
+#endif
+};
+
+} // namespace detail
+
+/*
+
+Open addressing hash table with a separate array of 1-byte control words (SwissTable-like layout).
+
+Every bucket has a control byte that is either empty, tombstone or the low 7 bits of the key hash.
+Probing walks 16-slot groups and compares a whole group of control bytes with a single SIMD instruction,
+so full key comparisons only happen on fingerprint matches (~1/128 false positive rate).
+
+Unlike HashTable, keys are not used as markers, so KeyInfo only has to provide hash() and isEqual().
+Memory comes from TAllocator (see DefaultAllocator), one allocation holds both arrays.
+
+*/
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator>
+class GroupHashTable : private detail::AllocatorHolder<TAllocator>
+{
+    using TAllocatorHolder = detail::AllocatorHolder<TAllocator>;
+
+    struct has_values : std::bool_constant<!std::is_same<std::nullptr_t, typename std::remove_reference<TValue>::type>::value>
+    {
+    };
+
+    static inline constexpr uint32_t kGroupWidth = detail::Group::kWidth;
+    static inline constexpr uint32_t k_MinNumberOfBuckets = kGroupWidth;
+
+    template <typename T, class... Args> static T* construct(void* EXLBR_RESTRICT ptr, Args&&... args)
+    {
+        return new (ptr) T(std::forward<Args>(args)...);
+    }
+    template <typename T> static void destruct(T* EXLBR_RESTRICT ptr) { ptr->~T(); }
+
+    template <bool hasValue, typename dummy = void> struct Storage
+    {
+    };
+
+    template <typename dummy> struct Storage<true, dummy>
+    {
+        struct TItem
+        {
+            TKey m_key;
+            TValue m_value;
+
+            template <typename TK, class... Args>
+            inline TItem(TK&& key, Args&&... args)
+                : m_key(std::forward<TK>(key))
+                , m_value(std::forward<Args>(args)...)
+            {
+            }
+
+            [[nodiscard]] inline TKey* key() noexcept { return &m_key; }
+            [[nodiscard]] inline TValue* value() noexcept { return &m_value; }
+        };
+    };
+
+    template <typename dummy> struct Storage<false, dummy>
+    {
+        struct TItem
+        {
+            TKey m_key;
+
+            template <typename TK>
+            inline TItem(TK&& key)
+                : m_key(std::forward<TK>(key))
+            {
+            }
+
+            [[nodiscard]] inline TKey* key() noexcept { return &m_key; }
+        };
+    };
+
+    using TItem = typename Storage<has_values::value>::TItem;
+    using TIterators = detail::TableIterators<GroupHashTable, TItem, TKey, TValue>;
+    friend TIterators;
+    friend struct detail::TableRehash;
+
+    struct TStorage
+    {
+        TItem* items;
+        int8_t* ctrl;
+        uint32_t numBuckets;
+    };
+
+    [[nodiscard]] static inline int8_t h2(size_t hashValue) noexcept { return int8_t(hashValue & 0x7f); }
+    [[nodiscard]] static inline size_t h1(size_t hashValue) noexcept { return hashValue >> 7; }
+
+    [[nodiscard]] inline bool isFull(size_t index) const noexcept { return m_ctrl[index] >= 0; }
+
+    // returns the index of the first full slot starting at 'index' or m_numBuckets
+    [[nodiscard]] inline size_t findNextFull(size_t index) const noexcept
+    {
+        const size_t numBuckets = m_numBuckets;
+        while (index < numBuckets)
+        {
+            const size_t groupStart = index & ~size_t(kGroupWidth - 1);
+            const detail::Group group(m_ctrl + groupStart);
+            const uint32_t bits = group.matchFull() & (0xffffu << (index - groupStart));
+            if (bits != 0)
+            {
+                return groupStart + detail::countTrailingZeros(bits);
+            }
+            index = groupStart + kGroupWidth;
+        }
+        return numBuckets;
+    }
+
+    // iterator support (see detail::TableIterators)
+    [[nodiscard]] inline TItem* getFirstSlot() const noexcept { return m_items; }
+    [[nodiscard]] inline TItem* getEndSlot() const noexcept { return m_items + m_numBuckets; }
+    [[nodiscard]] inline TItem* findValidSlot(TItem* item) const noexcept { return m_items + findNextFull(size_t(item - m_items)); }
+    [[nodiscard]] inline const TKey* getSlotKey(const TItem* item) const noexcept
+    {
+        EXLBR_ASSERT(isFull(size_t(item - m_items)));
+        return const_cast<TItem*>(item)->key();
+    }
+    [[nodiscard]] inline const TValue* getSlotValue(const TItem* item) const noexcept
+    {
+        EXLBR_ASSERT(isFull(size_t(item - m_items)));
+        return const_cast<TItem*>(item)->value();
+    }
+
+    inline void initEmpty() noexcept
+    {
+        m_items = nullptr;
+        m_ctrl = const_cast<int8_t*>(detail::kEmptyGroup);
+        m_numBuckets = 0;
+        m_groupMask = 0;
+        m_numElements = 0;
+        m_numTombstones = 0;
+    }
+
+    // [items][control bytes], items first to keep them aligned to the cache line
+    static inline constexpr size_t k_StorageAlignment = std::max(alignof(TItem), size_t(64));
+
+    [[nodiscard]] static inline size_t getItemsSize(uint32_t numBuckets) noexcept
+    {
+        return detail::alignSize(sizeof(TItem) * size_t(numBuckets), k_StorageAlignment);
+    }
+    [[nodiscard]] static inline size_t getStorageSize(uint32_t numBuckets) noexcept
+    {
+        return detail::alignSize(getItemsSize(numBuckets) + numBuckets, k_StorageAlignment);
+    }
+
+    inline void freeStorage(TItem* items, uint32_t numBuckets) noexcept
+    {
+        this->getAllocatorRef().deallocate(items, getStorageSize(numBuckets), k_StorageAlignment);
+    }
+
+    inline void create(uint32_t numBuckets)
+    {
+        numBuckets = (numBuckets < k_MinNumberOfBuckets) ? k_MinNumberOfBuckets : numBuckets;
+        EXLBR_ASSERT((numBuckets & (numBuckets - 1)) == 0);
+
+        const size_t itemsBytes = getItemsSize(numBuckets);
+        void* raw = this->getAllocatorRef().allocate(getStorageSize(numBuckets), k_StorageAlignment);
+        EXLBR_ASSERT(raw);
+        m_items = reinterpret_cast<TItem*>(raw);
+        m_ctrl = reinterpret_cast<int8_t*>(reinterpret_cast<char*>(raw) + itemsBytes);
+        memset(m_ctrl, detail::kCtrlEmpty, numBuckets);
+
+        m_numBuckets = numBuckets;
+        m_groupMask = (numBuckets / kGroupWidth) - 1;
+        m_numElements = 0;
+        m_numTombstones = 0;
+    }
+
+    inline void destroy() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<TItem>::value)
+        {
+            for (size_t index = findNextFull(0); index < m_numBuckets; index = findNextFull(index + 1))
+            {
+                destruct(m_items + index);
+            }
+        }
+    }
+
+    inline void destroyAndFreeMemory() noexcept
+    {
+        if (m_numBuckets == 0)
+        {
+            return;
+        }
+        destroy();
+        freeStorage(m_items, m_numBuckets);
+    }
+
+    [[nodiscard]] inline TItem* findImpl(const TKey& key, size_t hashValue) const noexcept
+    {
+        const size_t groupMask = m_groupMask;
+        const int8_t fingerprint = h2(hashValue);
+        TItem* const items = m_items;
+        size_t groupIndex = h1(hashValue) & groupMask;
+        for (size_t step = 1;; step++)
+        {
+            const size_t groupStart = groupIndex * kGroupWidth;
+            const detail::Group group(m_ctrl + groupStart);
+            for (uint32_t bits = group.match(fingerprint); bits != 0; bits &= bits - 1)
+            {
+                TItem* item = items + groupStart + detail::countTrailingZeros(bits);
+                if (EXLBR_LIKELY(TKeyInfo::isEqual(key, *item->key())))
+                {
+                    return item;
+                }
+            }
+
+            // an empty slot terminates the probe sequence (see eraseImpl)
+            if (EXLBR_LIKELY(group.matchEmpty() != 0) || step > groupMask)
+            {
+                return items + m_numBuckets;
+            }
+
+            // triangular probing visits every group when the number of groups is a power of two
+            groupIndex = (groupIndex + step) & groupMask;
+        }
+    }
+
+    [[nodiscard]] inline TItem* findImpl(const TKey& key) const noexcept { return findImpl(key, TKeyInfo::hash(key)); }
+
+    [[nodiscard]] inline size_t findInsertSlot(size_t hashValue) const noexcept
+    {
+        const size_t groupMask = m_groupMask;
+        size_t groupIndex = h1(hashValue) & groupMask;
+        for (size_t step = 1;; step++)
+        {
+            const size_t groupStart = groupIndex * kGroupWidth;
+            const detail::Group group(m_ctrl + groupStart);
+            const uint32_t bits = group.matchEmptyOrTombstone();
+            if (EXLBR_LIKELY(bits != 0))
+            {
+                return groupStart + detail::countTrailingZeros(bits);
+            }
+            // the growth threshold guarantees that a free slot exists
+            EXLBR_ASSERT(step <= groupMask);
+            groupIndex = (groupIndex + step) & groupMask;
+        }
+    }
+
+    template <typename TK, class... Args> inline TItem* insertAt(size_t index, size_t hashValue, TK&& key, Args&&... args)
+    {
+        EXLBR_ASSERT(!isFull(index));
+        TItem* item = construct<TItem>(m_items + index, std::forward<TK>(key), std::forward<Args>(args)...);
+        m_numTombstones -= (m_ctrl[index] == detail::kCtrlTombstone) ? 1 : 0;
+        m_ctrl[index] = h2(hashValue);
+        m_numElements++;
+        return item;
+    }
+
+    [[nodiscard]] inline TStorage getStorage() const noexcept { return TStorage{m_items, m_ctrl, m_numBuckets}; }
+
+    inline void moveItemsAndFree(const TStorage& storage)
+    {
+        if (storage.numBuckets == 0)
+        {
+            return;
+        }
+
+        for (uint32_t index = 0; index < storage.numBuckets; index++)
+        {
+            if (storage.ctrl[index] < 0)
+            {
+                continue;
+            }
+
+            TItem* item = storage.items + index;
+            const size_t hashValue = TKeyInfo::hash(*item->key());
+            const size_t insertIndex = findInsertSlot(hashValue);
+            construct<TItem>(m_items + insertIndex, std::move(*item));
+            m_ctrl[insertIndex] = h2(hashValue);
+            m_numElements++;
+            destruct(item);
+        }
+        freeStorage(storage.items, storage.numBuckets);
+    }
+
+    template <typename TK, class... Args> inline TItem* emplaceReallocate(size_t hashValue, TK&& key, Args&&... args)
+    {
+        const uint32_t numBucketsNew = detail::getGrowSize(m_numBuckets, m_numElements, m_numTombstones, m_numBuckets != 0, k_MinNumberOfBuckets);
+        return detail::TableRehash::resizeAndInsert(*this, numBucketsNew, [&]()
+                                                    { return insertAt(findInsertSlot(hashValue), hashValue, std::forward<TK>(key), std::forward<Args>(args)...); });
+    }
+
+    inline void resize(uint32_t numBucketsNew) { detail::TableRehash::resize(*this, numBucketsNew); }
+
+    inline void copyFrom(const GroupHashTable& other)
+    {
+        if (other.m_numBuckets == 0)
+        {
+            initEmpty();
+            return;
+        }
+
+        // same capacity = same slots, no need to rehash anything
+        create(other.m_numBuckets);
+        memcpy(m_ctrl, other.m_ctrl, m_numBuckets);
+        for (size_t index = other.findNextFull(0); index < other.m_numBuckets; index = other.findNextFull(index + 1))
+        {
+            construct<TItem>(m_items + index, static_cast<const TItem&>(*(other.m_items + index)));
+        }
+        m_numElements = other.m_numElements;
+        m_numTombstones = other.m_numTombstones;
+    }
+
+    inline void moveFrom(GroupHashTable&& other) noexcept
+    {
+        m_items = other.m_items;
+        m_ctrl = other.m_ctrl;
+        m_numBuckets = other.m_numBuckets;
+        m_groupMask = other.m_groupMask;
+        m_numElements = other.m_numElements;
+        m_numTombstones = other.m_numTombstones;
+        other.initEmpty();
+    }
+
+  public:
+    using IteratorBase = typename TIterators::IteratorBase;
+    using IteratorK = typename TIterators::IteratorK;
+    template <typename TIteratorValue> using TIteratorV = typename TIterators::template TIteratorV<TIteratorValue>;
+    template <typename TIteratorValue> using TIteratorKV = typename TIterators::template TIteratorKV<TIteratorValue>;
+
+    using IteratorKV = TIteratorKV<TValue>;
+    using ConstIteratorKV = TIteratorKV<const TValue>;
+    using IteratorV = TIteratorV<TValue>;
+    using ConstIteratorV = TIteratorV<const TValue>;
+
+    GroupHashTable() noexcept { initEmpty(); }
+
+    explicit GroupHashTable(const TAllocator& allocator) noexcept
+        : TAllocatorHolder(allocator)
+    {
+        initEmpty();
+    }
+
+    ~GroupHashTable() { destroyAndFreeMemory(); }
+
+    inline void clear()
+    {
+        if (m_numBuckets == 0)
+        {
+            return;
+        }
+        destroy();
+        memset(m_ctrl, detail::kCtrlEmpty, m_numBuckets);
+        m_numElements = 0;
+        m_numTombstones = 0;
+    }
+
+    template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplace(TK&& key, Args&&... args)
+    {
+        static_assert(std::is_same<TKey, typename std::remove_const<typename std::remove_reference<TK>::type>::type>::value,
+                      "Expected unversal reference of TKey type. Wrong key type?");
+
+        const size_t hashValue = TKeyInfo::hash(key);
+        TItem* existingItem = findImpl(key, hashValue);
+        if (existingItem != m_items + m_numBuckets)
+        {
+            return std::make_pair(IteratorKV(this, existingItem), false);
+        }
+
+        if (EXLBR_UNLIKELY(m_numElements + m_numTombstones >= detail::getGrowthThreshold(m_numBuckets)))
+        {
+            TItem* item = emplaceReallocate(hashValue, std::forward<TK>(key), std::forward<Args>(args)...);
+            return std::make_pair(IteratorKV(this, item), true);
+        }
+
+        TItem* item = insertAt(findInsertSlot(hashValue), hashValue, std::forward<TK>(key), std::forward<Args>(args)...);
+        return std::make_pair(IteratorKV(this, item), true);
+    }
+
+    [[nodiscard]] inline ConstIteratorKV find(const TKey& key) const noexcept { return ConstIteratorKV(this, findImpl(key)); }
+    [[nodiscard]] inline IteratorKV find(const TKey& key) noexcept { return IteratorKV(this, findImpl(key)); }
+
+    inline TItem* eraseImpl(const IteratorBase it)
+    {
+        TItem* const endItem = m_items + m_numBuckets;
+        if (it.m_slot == endItem)
+        {
+            return endItem;
+        }
+
+        const size_t index = size_t(it.m_slot - m_items);
+        EXLBR_ASSERT(isFull(index));
+        EXLBR_ASSERT(m_numElements != 0);
+        destruct(it.m_slot);
+        m_numElements--;
+
+        // If the group still has an empty slot, no probe sequence has ever continued past this group
+        // (inserts stop at the first group with a free slot and empty slots are never created in full groups),
+        // so it is safe to mark the slot as empty instead of leaving a tombstone.
+        const size_t groupStart = index & ~size_t(kGroupWidth - 1);
+        const detail::Group group(m_ctrl + groupStart);
+        if (group.matchEmpty() != 0)
+        {
+            m_ctrl[index] = detail::kCtrlEmpty;
+        }
+        else
+        {
+            m_ctrl[index] = detail::kCtrlTombstone;
+            m_numTombstones++;
+        }
+        return m_items + findNextFull(index + 1);
+    }
+
+    inline IteratorKV erase(const IteratorKV& it) { return IteratorKV(this, eraseImpl(it)); }
+    inline ConstIteratorKV erase(const ConstIteratorKV& it) { return ConstIteratorKV(this, eraseImpl(it)); }
+
+    inline bool erase(const TKey& key)
+    {
+        auto it = find(key);
+        if (it == iend())
+        {
+            return false;
+        }
+        eraseImpl(it);
+        return true;
+    }
+
+    inline void rehash()
+    {
+        if (m_numBuckets != 0)
+        {
+            resize(m_numBuckets);
+        }
+    }
+
+    inline bool reserve(uint32_t numBucketsNew)
+    {
+        if (numBucketsNew == 0 || numBucketsNew < capacity())
+        {
+            return false;
+        }
+        resize(detail::nextPow2(numBucketsNew));
+        return true;
+    }
+
+    [[nodiscard]] inline const TAllocator& getAllocator() const noexcept { return this->getAllocatorRef(); }
+
+    [[nodiscard]] inline uint32_t getNumTombstones() const noexcept { return m_numTombstones; }
+    [[nodiscard]] inline uint32_t size() const noexcept { return m_numElements; }
+    [[nodiscard]] inline uint32_t capacity() const noexcept { return m_numBuckets; }
+    [[nodiscard]] inline bool empty() const noexcept { return (m_numElements == 0); }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept { return (findImpl(key) != m_items + m_numBuckets); }
+
+    inline TValue& operator[](const TKey& key)
+    {
+        std::pair<IteratorKV, bool> emplaceIt = emplace(key);
+        return emplaceIt.first.value();
+    }
+
+    [[nodiscard]] inline IteratorK begin() const { return TIterators::template begin<IteratorK>(*this); }
+    [[nodiscard]] inline IteratorK end() const { return TIterators::template end<IteratorK>(*this); }
+
+    [[nodiscard]] inline ConstIteratorV vbegin() const { return TIterators::template begin<ConstIteratorV>(*this); }
+    [[nodiscard]] inline ConstIteratorV vend() const { return TIterators::template end<ConstIteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vbegin() { return TIterators::template begin<IteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vend() { return TIterators::template end<IteratorV>(*this); }
+
+    [[nodiscard]] inline ConstIteratorKV ibegin() const { return TIterators::template begin<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline ConstIteratorKV iend() const { return TIterators::template end<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV ibegin() { return TIterators::template begin<IteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV iend() { return TIterators::template end<IteratorKV>(*this); }
+
+    template <typename TIterator> using TypedIteratorHelper = typename TIterators::template TypedIteratorHelper<TIterator>;
+
+    using Keys = TypedIteratorHelper<IteratorK>;
+    using Values = TypedIteratorHelper<IteratorV>;
+    using Items = TypedIteratorHelper<IteratorKV>;
+    using ConstValues = TypedIteratorHelper<ConstIteratorV>;
+    using ConstItems = TypedIteratorHelper<ConstIteratorKV>;
+
+    [[nodiscard]] inline Keys keys() const { return Keys(this); }
+    [[nodiscard]] inline ConstValues values() const { return ConstValues(this); }
+    [[nodiscard]] inline ConstItems items() const { return ConstItems(this); }
+
+    [[nodiscard]] inline Values values() { return Values(this); }
+    [[nodiscard]] inline Items items() { return Items(this); }
+
+    // copy ctor
+    GroupHashTable(const GroupHashTable& other)
+        : TAllocatorHolder(other.getAllocatorRef())
+    {
+        EXLBR_ASSERT(&other != this);
+        copyFrom(other);
+    }
+
+    // copy assignment
+    GroupHashTable& operator=(const GroupHashTable& other)
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        destroyAndFreeMemory();
+        this->getAllocatorRef() = other.getAllocatorRef();
+        copyFrom(other);
+        return *this;
+    }
+
+    // move ctor
+    GroupHashTable(GroupHashTable&& other) noexcept
+        : TAllocatorHolder(other.getAllocatorRef())
+    {
+        EXLBR_ASSERT(&other != this);
+        moveFrom(std::move(other));
+    }
+
+    // move assignment
+    GroupHashTable& operator=(GroupHashTable&& other) noexcept
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        destroyAndFreeMemory();
+        // note: the storage is moved along with the allocator that owns it
+        this->getAllocatorRef() = other.getAllocatorRef();
+        moveFrom(std::move(other));
+        return *this;
+    }
+
+  private:
+    TItem* m_items;           // 8
+    int8_t* m_ctrl;           // 8
+    uint32_t m_numBuckets;    // 4
+    uint32_t m_groupMask;     // 4
+    uint32_t m_numElements;   // 4
+    uint32_t m_numTombstones; // 4
+};
+
+// hashmap declaration
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator>
+using GroupHashMap = GroupHashTable<TKey, TValue, TKeyInfo, TAllocator>;
+
+// hashset declaration
+template <typename TKey, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator>
+using GroupHashSet = GroupHashTable<TKey, std::nullptr_t, TKeyInfo, TAllocator>;
+
+} // namespace Excalibur
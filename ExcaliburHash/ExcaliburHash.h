@@ -1,9 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
 #include <stdint.h>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #if !defined(EXLBR_ALLOC) || !defined(EXLBR_FREE)
     #if defined(_WIN32)
@@ -52,11 +56,329 @@
     #endif
 #endif
 
+#if !defined(EXLBR_PREFETCH)
+    #if defined(__GNUC__)
+        #define EXLBR_PREFETCH(ptr) __builtin_prefetch((ptr), 0, 3)
+    #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        #include <xmmintrin.h>
+        #define EXLBR_PREFETCH(ptr) _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0)
+    #else
+        #define EXLBR_PREFETCH(ptr) ((void)(ptr))
+    #endif
+#endif
+
 #include <ExcaliburKeyInfo.h>
+#include <ExcaliburSimd.h>
+#include <ExcaliburTableCommon.h>
 
 namespace Excalibur
 {
 
+// Probing policies
+
+// Classic linear probing. Erased items are marked with tombstones.
+struct LinearProbing
+{
+};
+
+// Linear probing with Robin Hood insertion (items with a longer probe distance take over the slots of "richer" items)
+// and backward-shift deletion. Erase never leaves tombstones, so tables with heavy insert/erase churn never degrade.
+struct RobinHoodProbing
+{
+};
+
+// Default allocation policy (EXLBR_ALLOC/EXLBR_FREE)
+//
+// Custom allocators have to provide
+//   void* allocate(size_t numBytes, size_t alignment);
+//   void deallocate(void* ptr, size_t numBytes, size_t alignment);
+//
+// Allocators are stored inside the hash table (stateless ones take no space) and copied along with it,
+// so stateful allocators are supposed to be cheap handles (e.g. a pointer to an arena).
+struct DefaultAllocator
+{
+    [[nodiscard]] static inline void* allocate(size_t numBytes, size_t alignment) noexcept { return EXLBR_ALLOC(numBytes, alignment); }
+    static inline void deallocate(void* ptr, size_t /*numBytes*/, size_t /*alignment*/) noexcept { EXLBR_FREE(ptr); }
+};
+
+// Shrink policies
+//
+// Custom policies have to provide
+//   static constexpr uint32_t k_MinLoadDivisor; // shrink once less than 1/k_MinLoadDivisor of the buckets are in use (0 = never)
+//   static constexpr bool k_ShrinkOnErase;      // check after erase(key), not only in clear()
+
+// Bucket memory is only released by shrink_to_fit() or by destroying the table.
+struct NoShrink
+{
+    static inline constexpr uint32_t k_MinLoadDivisor = 0;
+    static inline constexpr bool k_ShrinkOnErase = false;
+};
+
+// clear() re-allocates storage sized for the number of items it removed and erase(key) shrinks to fit
+// once the load drops below 1/kMinLoadDivisor. Growth happens at 75% load, so a shrunk table is far from both thresholds.
+template <uint32_t kMinLoadDivisor = 8, bool kShrinkOnErase = true> struct ShrinkIfSparse
+{
+    static_assert(kMinLoadDivisor >= 4, "Shrinking above 25% load would fight with the growth policy");
+    static inline constexpr uint32_t k_MinLoadDivisor = kMinLoadDivisor;
+    static inline constexpr bool k_ShrinkOnErase = kShrinkOnErase;
+};
+
+// Opt-in hash caching for keys that are expensive to hash or compare (long strings, composite keys).
+// Every item stores 32 bits of its hash: growth redistributes items without calling hash() and probing
+// rejects most mismatches with a single integer compare before calling isEqual().
+//
+// Excalibur::HashMap<std::string, int, 1, Excalibur::CachedHashKeyInfo<Excalibur::KeyInfo<std::string>>> map;
+template <typename TBaseKeyInfo> struct CachedHashKeyInfo : public TBaseKeyInfo
+{
+    static inline constexpr bool k_CacheHash = true;
+};
+
+// Runtime counters (only collected if EXLBR_ENABLE_STATS is defined, see HashTable::getStats)
+// Note: const lookups update the counters too, so concurrent readers of a table with stats enabled are a data race.
+struct HashTableStats
+{
+    uint64_t numFinds = 0;
+    uint64_t numHits = 0;
+    uint64_t numMisses = 0;
+    uint64_t totalProbeLength = 0; // number of buckets inspected by all finds
+    uint64_t maxProbeLength = 0;
+    uint64_t numResizes = 0;
+    uint64_t numBytesMoved = 0; // bytes re-inserted into the new storage during resizes
+    uint64_t numReseeds = 0;    // new seeds picked because of a long probe sequence (see SeededKeyInfo)
+};
+
+// Occupancy snapshot (see HashTable::computeProbeHistogram)
+struct ProbeHistogram
+{
+    uint32_t numBuckets = 0;
+    uint32_t numElements = 0;
+    uint32_t numTombstones = 0;
+    uint32_t maxDisplacement = 0;
+    uint32_t maxClusterLength = 0;
+    // displacement[d] = number of items stored 'd' buckets away from their home bucket
+    std::vector<uint32_t> displacement;
+    // clusterLength[n] = number of runs of 'n' consecutive non-empty buckets (tombstones included, they extend probing too)
+    std::vector<uint32_t> clusterLength;
+};
+
+namespace detail
+{
+// TKeyInfo::is_transparent enables lookups by compatible key types (i.e. std::string_view for std::string keys)
+template <typename TKeyInfo, typename TKey, typename TK, typename = void> struct is_transparent_key : std::false_type
+{
+};
+
+template <typename TKeyInfo, typename TKey, typename TK>
+struct is_transparent_key<TKeyInfo, TKey, TK,
+                          std::void_t<typename TKeyInfo::is_transparent, decltype(TKeyInfo::hash(std::declval<const TK&>())),
+                                      decltype(TKeyInfo::isEqual(std::declval<const TK&>(), std::declval<const TKey&>()))>>
+    : std::bool_constant<!std::is_same<TKey, std::decay_t<TK>>::value>
+{
+};
+
+// KeyInfo can optionally provide isEmpty(key)/isTombstone(key), so probing doesn't have to construct sentinel keys
+template <typename TKeyInfo, typename TKey, typename = void> struct has_is_empty : std::false_type
+{
+};
+template <typename TKeyInfo, typename TKey>
+struct has_is_empty<TKeyInfo, TKey, std::void_t<decltype(TKeyInfo::isEmpty(std::declval<const TKey&>()))>> : std::true_type
+{
+};
+
+template <typename TKeyInfo, typename TKey, typename = void> struct has_is_tombstone : std::false_type
+{
+};
+template <typename TKeyInfo, typename TKey>
+struct has_is_tombstone<TKeyInfo, TKey, std::void_t<decltype(TKeyInfo::isTombstone(std::declval<const TKey&>()))>> : std::true_type
+{
+};
+
+// KeyInfo can optionally provide hashN(keys, out, numKeys) to hash many keys at once (i.e. wyhash::hashN)
+template <typename TKeyInfo, typename TKey, typename = void> struct has_hash_n : std::false_type
+{
+};
+template <typename TKeyInfo, typename TKey>
+struct has_hash_n<TKeyInfo, TKey,
+                  std::void_t<decltype(TKeyInfo::hashN(std::declval<const TKey*>(), std::declval<size_t*>(), std::declval<size_t>()))>>
+    : std::true_type
+{
+};
+
+template <typename TKeyInfo, typename TKey> [[nodiscard]] inline bool isEmptyKey(const TKey& key) noexcept
+{
+    if constexpr (has_is_empty<TKeyInfo, TKey>::value)
+    {
+        return TKeyInfo::isEmpty(key);
+    }
+    else
+    {
+        return TKeyInfo::isEqual(TKeyInfo::getEmpty(), key);
+    }
+}
+
+template <typename TKeyInfo, typename TKey> [[nodiscard]] inline bool isTombstoneKey(const TKey& key) noexcept
+{
+    if constexpr (has_is_tombstone<TKeyInfo, TKey>::value)
+    {
+        return TKeyInfo::isTombstone(key);
+    }
+    else
+    {
+        return TKeyInfo::isEqual(TKeyInfo::getTombstone(), key);
+    }
+}
+
+// murmur3 finalizer (full avalanche, a bijection on 64-bit values)
+[[nodiscard]] constexpr inline uint64_t fmix64(uint64_t v) noexcept
+{
+    v ^= v >> 33;
+    v *= 0xff51afd7ed558ccdull;
+    v ^= v >> 33;
+    v *= 0xc4ceb9fe1a85ec53ull;
+    v ^= v >> 33;
+    return v;
+}
+
+// KeyInfo::k_CacheHash = true stores the hash next to every key (see CachedHashKeyInfo)
+template <typename TKeyInfo, typename = void> struct has_cached_hash : std::false_type
+{
+};
+template <typename TKeyInfo>
+struct has_cached_hash<TKeyInfo, std::void_t<decltype(TKeyInfo::k_CacheHash)>> : std::bool_constant<TKeyInfo::k_CacheHash>
+{
+};
+
+// Per item hash storage. The low 32 bits are enough to find a bucket since the number of buckets is a uint32_t.
+template <bool kCacheHash> struct ItemHash
+{
+    [[nodiscard]] static inline constexpr bool isHashEqual(size_t /*hashValue*/) noexcept { return true; }
+    inline void setHash(size_t /*hashValue*/) noexcept {}
+};
+
+template <> struct ItemHash<true>
+{
+    [[nodiscard]] inline bool isHashEqual(size_t hashValue) const noexcept { return m_hash == uint32_t(hashValue); }
+    inline void setHash(size_t hashValue) noexcept { m_hash = uint32_t(hashValue); }
+    [[nodiscard]] inline size_t getHash() const noexcept { return m_hash; }
+
+  private:
+    uint32_t m_hash = 0;
+};
+
+// empty base optimization for stateless allocators
+template <typename TAllocator, bool kIsEmpty = std::is_empty<TAllocator>::value && !std::is_final<TAllocator>::value>
+struct AllocatorHolder : private TAllocator
+{
+    AllocatorHolder() = default;
+    explicit AllocatorHolder(const TAllocator& allocator)
+        : TAllocator(allocator)
+    {
+    }
+    [[nodiscard]] inline TAllocator& getAllocatorRef() noexcept { return *this; }
+    [[nodiscard]] inline const TAllocator& getAllocatorRef() const noexcept { return *this; }
+};
+
+template <typename TAllocator> struct AllocatorHolder<TAllocator, false>
+{
+    AllocatorHolder() = default;
+    explicit AllocatorHolder(const TAllocator& allocator)
+        : m_allocator(allocator)
+    {
+    }
+    [[nodiscard]] inline TAllocator& getAllocatorRef() noexcept { return m_allocator; }
+    [[nodiscard]] inline const TAllocator& getAllocatorRef() const noexcept { return m_allocator; }
+
+  private:
+    TAllocator m_allocator;
+};
+
+// KeyInfo::k_SeededHash = true hashes keys with hash(key, seed) (see SeededKeyInfo)
+template <typename TKeyInfo, typename = void> struct has_seeded_hash : std::false_type
+{
+};
+template <typename TKeyInfo>
+struct has_seeded_hash<TKeyInfo, std::void_t<decltype(TKeyInfo::k_SeededHash)>> : std::bool_constant<TKeyInfo::k_SeededHash>
+{
+};
+
+template <typename TKeyInfo, typename TK, typename = void> struct has_hash_with_seed : std::false_type
+{
+};
+template <typename TKeyInfo, typename TK>
+struct has_hash_with_seed<TKeyInfo, TK, std::void_t<decltype(TKeyInfo::hash(std::declval<const TK&>(), uint64_t(0)))>> : std::true_type
+{
+};
+
+// KeyInfo::k_MaxProbeLength, probe length that triggers a reseed of a seeded table
+template <typename TKeyInfo, typename = void> struct max_probe_length : std::integral_constant<uint32_t, 128>
+{
+};
+template <typename TKeyInfo>
+struct max_probe_length<TKeyInfo, std::void_t<decltype(TKeyInfo::k_MaxProbeLength)>> : std::integral_constant<uint32_t, TKeyInfo::k_MaxProbeLength>
+{
+};
+
+// unpredictable from the outside: a per-process random start, the time and a counter
+[[nodiscard]] inline uint64_t generateHashSeed() noexcept
+{
+    static std::atomic<uint64_t> counter(uint64_t(reinterpret_cast<uintptr_t>(&counter)) ^
+                                         uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+    const uint64_t ticks = uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return fmix64(counter.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed) ^ fmix64(ticks));
+}
+
+// Per table seed (seeded tables only), every table starts with its own random seed
+template <bool kSeededHash> struct HashSeedHolder
+{
+    [[nodiscard]] static inline constexpr uint64_t getSeed() noexcept { return 0; }
+};
+
+template <> struct HashSeedHolder<true>
+{
+    [[nodiscard]] inline uint64_t getSeed() const noexcept { return m_seed; }
+    inline void setSeed(uint64_t seed) noexcept { m_seed = seed; }
+    // number of buckets at the last automatic reseed, at most one per table size
+    [[nodiscard]] inline uint32_t getReseedNumBuckets() const noexcept { return m_reseedNumBuckets; }
+    inline void setReseedNumBuckets(uint32_t numBuckets) noexcept { m_reseedNumBuckets = numBuckets; }
+
+  private:
+    uint64_t m_seed = generateHashSeed();
+    uint32_t m_reseedNumBuckets = 0;
+};
+
+// raw storage access for snapshots (see ExcaliburSnapshot.h)
+template <typename THashTable> struct SnapshotAccess;
+// raw storage access for incremental growth (see ExcaliburIncrementalHash.h)
+template <typename THashTable> struct IncrementalAccess;
+} // namespace detail
+
+// Opt-in seeded hashing against hash flooding (attacker-chosen keys that all probe the same buckets).
+// The table hashes keys with hash(key, seed) using its own random seed. If a single emplace has to probe more than
+// kMaxProbeLength buckets anyway, the table picks a new random seed and rehashes, at most once per table size.
+// The built-in KeyInfos provide hash(key, seed). For other base KeyInfos the unseeded hash is mixed with the seed,
+// which breaks up bucket collisions but can't fix keys with identical full hashes.
+//
+// Excalibur::HashMap<uint64_t, Session, 1, Excalibur::SeededKeyInfo<Excalibur::KeyInfo<uint64_t>>> sessions;
+template <typename TBaseKeyInfo, uint32_t kMaxProbeLength = 128> struct SeededKeyInfo : public TBaseKeyInfo
+{
+    static_assert(kMaxProbeLength > 0, "Max probe length can't be zero");
+    static inline constexpr bool k_SeededHash = true;
+    static inline constexpr uint32_t k_MaxProbeLength = kMaxProbeLength;
+
+    using TBaseKeyInfo::hash;
+    template <typename TK> [[nodiscard]] static inline size_t hash(const TK& key, uint64_t seed) noexcept
+    {
+        if constexpr (detail::has_hash_with_seed<TBaseKeyInfo, TK>::value)
+        {
+            return TBaseKeyInfo::hash(key, seed);
+        }
+        else
+        {
+            return size_t(detail::fmix64(uint64_t(TBaseKeyInfo::hash(key)) ^ seed));
+        }
+    }
+};
+
 /*
 
 TODO: Description
@@ -66,27 +388,55 @@ TODO: Design descisions/principles
 TODO: Memory layout
 
 */
-template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>> class HashTable
+template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, typename TProbing = LinearProbing,
+          typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+class HashTable : private detail::AllocatorHolder<TAllocator>, private detail::HashSeedHolder<detail::has_seeded_hash<TKeyInfo>::value>
 {
+    using TAllocatorHolder = detail::AllocatorHolder<TAllocator>;
+    using TSeedHolder = detail::HashSeedHolder<detail::has_seeded_hash<TKeyInfo>::value>;
+
     struct has_values : std::bool_constant<!std::is_same<std::nullptr_t, typename std::remove_reference<TValue>::type>::value>
     {
     };
 
+    static_assert(std::is_same<TProbing, LinearProbing>::value || std::is_same<TProbing, RobinHoodProbing>::value, "Unknown probing policy");
+    static inline constexpr bool k_RobinHood = std::is_same<TProbing, RobinHoodProbing>::value;
+
     static inline constexpr uint32_t k_MinNumberOfBuckets = 16;
 
+    static inline constexpr bool k_CacheHash = detail::has_cached_hash<TKeyInfo>::value;
+    using TItemHash = detail::ItemHash<k_CacheHash>;
+
+    static inline constexpr bool k_SeededHash = detail::has_seeded_hash<TKeyInfo>::value;
+
+    template <typename TK> using enable_if_transparent = std::enable_if_t<detail::is_transparent_key<TKeyInfo, TKey, TK>::value>;
+
     template <typename T, class... Args> static T* construct(void* EXLBR_RESTRICT ptr, Args&&... args)
     {
         return new (ptr) T(std::forward<Args>(args)...);
     }
     template <typename T> static void destruct(T* EXLBR_RESTRICT ptr) { ptr->~T(); }
 
+    // move or copy key (a key of a compatible type is converted to TKey here, i.e. only once a new slot is claimed)
+    template <typename TK> static inline void assignKey(TKey* EXLBR_RESTRICT dst, TK&& key)
+    {
+        if constexpr (std::is_assignable<TKey&, TK&&>::value)
+        {
+            *dst = std::forward<TK>(key);
+        }
+        else
+        {
+            *dst = TKey(std::forward<TK>(key));
+        }
+    }
+
     template <bool hasValue, typename dummy = void> struct Storage
     {
     };
 
     template <typename dummy> struct Storage<true, dummy>
     {
-        struct TItem
+        struct TItem : public TItemHash
         {
             using TValueStorage = typename std::aligned_storage<sizeof(TValue), alignof(TValue)>::type;
             TKey m_key;
@@ -98,9 +448,9 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             }
 
             [[nodiscard]] inline bool isValid() const noexcept { return TKeyInfo::isValid(m_key); }
-            [[nodiscard]] inline bool isEmpty() const noexcept { return TKeyInfo::isEqual(TKeyInfo::getEmpty(), m_key); }
-            [[nodiscard]] inline bool isTombstone() const noexcept { return TKeyInfo::isEqual(TKeyInfo::getTombstone(), m_key); }
-            [[nodiscard]] inline bool isEqual(const TKey& key) const noexcept { return TKeyInfo::isEqual(key, m_key); }
+            [[nodiscard]] inline bool isEmpty() const noexcept { return detail::isEmptyKey<TKeyInfo>(m_key); }
+            [[nodiscard]] inline bool isTombstone() const noexcept { return detail::isTombstoneKey<TKeyInfo>(m_key); }
+            template <typename TK> [[nodiscard]] inline bool isEqual(const TK& key) const noexcept { return TKeyInfo::isEqual(key, m_key); }
 
             [[nodiscard]] inline TKey* key() noexcept { return &m_key; }
             [[nodiscard]] inline TValue* value() noexcept
@@ -113,7 +463,7 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
     template <typename dummy> struct Storage<false, dummy>
     {
-        struct TItem
+        struct TItem : public TItemHash
         {
             TKey m_key;
 
@@ -122,9 +472,9 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             {
             }
             [[nodiscard]] inline bool isValid() const noexcept { return TKeyInfo::isValid(m_key); }
-            [[nodiscard]] inline bool isEmpty() const noexcept { return TKeyInfo::isEqual(TKeyInfo::getEmpty(), m_key); }
-            [[nodiscard]] inline bool isTombstone() const noexcept { return TKeyInfo::isEqual(TKeyInfo::getTombstone(), m_key); }
-            [[nodiscard]] inline bool isEqual(const TKey& key) const noexcept { return TKeyInfo::isEqual(key, m_key); }
+            [[nodiscard]] inline bool isEmpty() const noexcept { return detail::isEmptyKey<TKeyInfo>(m_key); }
+            [[nodiscard]] inline bool isTombstone() const noexcept { return detail::isTombstoneKey<TKeyInfo>(m_key); }
+            template <typename TK> [[nodiscard]] inline bool isEqual(const TK& key) const noexcept { return TKeyInfo::isEqual(key, m_key); }
 
             [[nodiscard]] inline TKey* key() noexcept { return &m_key; }
             // inline TValue* value() noexcept{ return nullptr; }
@@ -133,65 +483,73 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
     using TItem = typename Storage<has_values::value>::TItem;
 
-    template <typename T> static inline T shr(T v, T shift) noexcept
-    {
-        static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "Type T should be an integral unsigned type.");
-        return (v >> shift);
-    }
-
-    [[nodiscard]] inline uint32_t nextPow2(uint32_t v) noexcept
+    // Bulk paths (create/clear, iteration) use the runtime-dispatched kernels from ExcaliburSimd.h:
+    // fills need trivially copyable items, scans need built-in integer keys (compared bitwise) at the start of the item.
+    static inline constexpr bool k_SimdItems = std::is_trivially_copyable<TItem>::value && sizeof(TItem) >= 4 && sizeof(TItem) <= 64 &&
+                                               (sizeof(TItem) & (sizeof(TItem) - 1)) == 0;
+    static inline constexpr bool k_SimdKeys = k_SimdItems && !k_CacheHash && std::is_integral<TKey>::value &&
+                                              (sizeof(TKey) == 4 || sizeof(TKey) == 8) && std::is_same<TKeyInfo, KeyInfo<TKey>>::value;
+
+    // Rehash copies the keys into a small buffer and hashes them with TKeyInfo::hashN.
+    // KeyInfos derived from the built-in one usually override hash() only, so an inherited hashN() is not used.
+    static inline constexpr bool k_BulkHash =
+        !k_SeededHash && detail::has_hash_n<TKeyInfo, TKey>::value &&
+        (std::is_same<TKeyInfo, KeyInfo<TKey>>::value || !std::is_base_of<KeyInfo<TKey>, TKeyInfo>::value) &&
+        std::is_trivially_copyable<TKey>::value && std::is_default_constructible<TKey>::value;
+
+    template <typename TK = TKey> [[nodiscard]] static inline uint64_t getKeyBits(const TK& key) noexcept
     {
-        EXLBR_ASSERT(v != 0);
-        v--;
-        v |= v >> 1;
-        v |= v >> 2;
-        v |= v >> 4;
-        v |= v >> 8;
-        v |= v >> 16;
-        v++;
-        return v;
+        return uint64_t(std::make_unsigned_t<TK>(key));
     }
 
-    [[nodiscard]] static inline size_t align(size_t cursor, size_t alignment) noexcept
-    {
-        return (cursor + (alignment - 1)) & ~(alignment - 1);
-    }
-    [[nodiscard]] static inline bool isPointerAligned(void* cursor, size_t alignment) noexcept
-    {
-        return (uintptr_t(cursor) & (alignment - 1)) == 0;
-    }
+    static inline constexpr ptrdiff_t k_ScalarScanLength = 8;
 
-    template <typename TIterator> struct IteratorHelper
+    // first valid item in [item, endItem)
+    [[nodiscard]] static inline TItem* skipInvalidItems(TItem* item, TItem* endItem) noexcept
     {
-        [[nodiscard]] static TIterator begin(const HashTable& ht) noexcept
+        if constexpr (k_SimdKeys)
         {
-            if (ht.empty())
-            {
-                return end(ht);
-            }
-
-            TItem* EXLBR_RESTRICT item = ht.m_storage;
-            while (true)
+            // in a dense table a valid item is usually a few slots away, the kernel only pays off on longer runs of empty slots
+            TItem* const scalarEndItem = (endItem - item > k_ScalarScanLength) ? (item + k_ScalarScanLength) : endItem;
+            for (; item < scalarEndItem; item++)
             {
                 if (item->isValid())
                 {
-                    return TIterator(&ht, item);
+                    return item;
                 }
-                item++;
             }
+            if (item < endItem)
+            {
+                item += detail::getSimdKernels().findValidKey(item, size_t(endItem - item), sizeof(TItem), sizeof(TKey),
+                                                              getKeyBits(TKeyInfo::getEmpty()), getKeyBits(TKeyInfo::getTombstone()));
+            }
+            return item;
         }
-
-        [[nodiscard]] static TIterator end(const HashTable& ht) noexcept
+        else
         {
-            const uint32_t numBuckets = ht.m_numBuckets;
-            TItem* const endItem = ht.m_storage + numBuckets;
-            return TIterator(&ht, endItem);
+            while (item < endItem && !item->isValid())
+            {
+                item++;
+            }
+            return item;
         }
-    };
+    }
+
+    template <typename T> static inline T shr(T v, T shift) noexcept
+    {
+        static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "Type T should be an integral unsigned type.");
+        return (v >> shift);
+    }
+
+    [[nodiscard]] static inline bool isPointerAligned(void* cursor, size_t alignment) noexcept
+    {
+        return (uintptr_t(cursor) & (alignment - 1)) == 0;
+    }
 
     inline void moveFrom(HashTable&& other)
     {
         // note: the current hash table is supposed to be destroyed/non-initialized
+        static_cast<TSeedHolder&>(*this) = static_cast<const TSeedHolder&>(other);
         if (!other.isUsingInlineStorage())
         {
             // if we are not using inline storage than it's a simple pointer swap
@@ -280,6 +638,7 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
                 const bool hasValidValue = otherInlineItem->isValid();
                 // move construct key
                 inlineItem = construct<TItem>(inlineItem, std::move(*otherInlineItem->key()));
+                copyHash(inlineItem, otherInlineItem);
 
                 // move inline storage value (if any)
                 if (hasValidValue)
@@ -297,13 +656,29 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             for (unsigned i = 0; i < kNumInlineItems; i++)
             {
                 // move construct key
-                construct<TItem>((inlineItems + i), std::move(*(otherInlineItems + i)->key()));
+                TItem* inlineItem = construct<TItem>((inlineItems + i), std::move(*(otherInlineItems + i)->key()));
+                copyHash(inlineItem, otherInlineItems + i);
             }
         }
 
         return inlineItems;
     }
 
+    // note: 64 to match CPU cache line size
+    static inline constexpr size_t k_StorageAlignment = std::max(alignof(TItem), size_t(64));
+
+    [[nodiscard]] static inline size_t getStorageSize(uint32_t numBuckets) noexcept
+    {
+        const size_t numBytes = detail::alignSize(sizeof(TItem) * size_t(numBuckets), k_StorageAlignment);
+        EXLBR_ASSERT((numBytes % k_StorageAlignment) == 0);
+        return numBytes;
+    }
+
+    inline void freeStorage(TItem* storage, uint32_t numBuckets) noexcept
+    {
+        this->getAllocatorRef().deallocate(storage, getStorageSize(numBuckets), k_StorageAlignment);
+    }
+
     inline uint32_t create(uint32_t numBuckets)
     {
         numBuckets = (numBuckets < k_MinNumberOfBuckets) ? k_MinNumberOfBuckets : numBuckets;
@@ -312,13 +687,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         EXLBR_ASSERT(numBuckets > 0);
         EXLBR_ASSERT((numBuckets & (numBuckets - 1)) == 0);
 
-        size_t numBytes = sizeof(TItem) * numBuckets;
-        // note: 64 to match CPU cache line size
-        size_t alignment = std::max(alignof(TItem), size_t(64));
-        numBytes = align(numBytes, alignment);
-        EXLBR_ASSERT((numBytes % alignment) == 0);
-
-        void* raw = EXLBR_ALLOC(numBytes, alignment);
+        const size_t numBytes = getStorageSize(numBuckets);
+        void* raw = this->getAllocatorRef().allocate(numBytes, k_StorageAlignment);
         EXLBR_ASSERT(raw);
         m_storage = reinterpret_cast<TItem*>(raw);
         EXLBR_ASSERT(raw == m_storage);
@@ -328,14 +698,33 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         m_numElements = 0;
         m_numTombstones = 0;
 
-        TItem* EXLBR_RESTRICT item = m_storage;
-        TItem* const endItem = item + numBuckets;
-        for (; item != endItem; item++)
+        initializeItems(m_storage, numBuckets);
+        return numBuckets;
+    }
+
+    // constructs empty items in uninitialized memory
+    static inline void initializeItems(TItem* items, uint32_t numItems)
+    {
+        if constexpr (k_SimdItems)
+        {
+            fillEmpty(items, numItems);
+        }
+        else
         {
-            construct<TItem>(item, TKeyInfo::getEmpty());
+            TItem* EXLBR_RESTRICT item = items;
+            TItem* const endItem = item + numItems;
+            for (; item != endItem; item++)
+            {
+                construct<TItem>(item, TKeyInfo::getEmpty());
+            }
         }
+    }
 
-        return numBuckets;
+    static inline void fillEmpty(TItem* items, uint32_t numItems) noexcept
+    {
+        alignas(TItem) unsigned char emptyItem[sizeof(TItem)] = {};
+        construct<TItem>(emptyItem, TKeyInfo::getEmpty());
+        detail::getSimdKernels().fillItems(items, numItems, emptyItem, sizeof(TItem));
     }
 
     inline void destroy()
@@ -361,6 +750,12 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
     inline void destroyAndFreeMemory()
     {
+        // moved-from table doesn't own anything (but it still can be assigned to)
+        if (m_storage == nullptr)
+        {
+            return;
+        }
+
         if constexpr (!std::is_trivially_destructible<TValue>::value || !std::is_trivially_destructible<TKey>::value)
         {
             destroy();
@@ -368,220 +763,169 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
         if (!isUsingInlineStorage())
         {
-            EXLBR_FREE(m_storage);
+            freeStorage(m_storage, m_numBuckets);
+        }
+    }
+
+    template <typename TK> [[nodiscard]] inline size_t hashKey(const TK& key) const noexcept
+    {
+        if constexpr (k_SeededHash)
+        {
+            return TKeyInfo::hash(key, this->getSeed());
+        }
+        else
+        {
+            return TKeyInfo::hash(key);
+        }
+    }
+
+    [[nodiscard]] inline size_t getItemHash(const TItem* item) const noexcept
+    {
+        if constexpr (k_CacheHash)
+        {
+            return item->getHash();
+        }
+        else
+        {
+            return hashKey(*const_cast<TItem*>(item)->key());
+        }
+    }
+
+    static inline void copyHash(TItem* EXLBR_RESTRICT dst, const TItem* EXLBR_RESTRICT src) noexcept
+    {
+        if constexpr (k_CacheHash)
+        {
+            dst->setHash(src->getHash());
+        }
+    }
+
+    // distance between the item's home bucket and the bucket it actually occupies
+    [[nodiscard]] inline size_t getProbeDistance(const TItem* item, size_t numBuckets) const noexcept
+    {
+        const size_t bucketIndex = size_t(item - m_storage);
+        const size_t homeIndex = getItemHash(item) & (numBuckets - 1);
+        return (bucketIndex - homeIndex) & (numBuckets - 1);
+    }
+
+    // Robin Hood iteration starts right after the first empty bucket. Erasing shifts items back, but never into
+    // that bucket, so no item is moved from the already visited part of the table into the part that is not visited yet.
+    // note: a completely full table (only possible with inline storage) is iterated from the first bucket
+    [[nodiscard]] inline TItem* getIterationStart() const noexcept
+    {
+        TItem* const endItem = m_storage + m_numBuckets;
+        for (TItem* item = m_storage; item < endItem; item++)
+        {
+            if (item->isEmpty())
+            {
+                return item + 1;
+            }
+        }
+        return m_storage;
+    }
+
+    // iterator support (see detail::TableIterators)
+    [[nodiscard]] inline TItem* getFirstSlot() const noexcept { return m_storage; }
+    [[nodiscard]] inline TItem* getEndSlot() const noexcept { return m_storage + m_numBuckets; }
+    [[nodiscard]] inline TItem* findValidSlot(TItem* item) const noexcept { return skipInvalidItems(item, m_storage + m_numBuckets); }
+    [[nodiscard]] inline TItem* findValidSlot(TItem* item, TItem* endItem) const noexcept { return skipInvalidItems(item, endItem); }
+    [[nodiscard]] inline const TKey* getSlotKey(TItem* item) const noexcept
+    {
+        EXLBR_ASSERT(item->isValid());
+        return item->key();
+    }
+    [[nodiscard]] inline const TValue* getSlotValue(TItem* item) const noexcept
+    {
+        EXLBR_ASSERT(item->isValid());
+        return item->value();
+    }
+
+    template <typename T> static inline void moveConstruct(T* EXLBR_RESTRICT dst, T* EXLBR_RESTRICT src)
+    {
+        construct<T>(dst, std::move(*src));
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            destruct(src);
         }
     }
 
-    [[nodiscard]] inline TItem* findImpl(const TKey& key) const noexcept
+    template <typename TK> [[nodiscard]] inline TItem* findImpl(const TK& key) const noexcept { return findImpl(key, hashKey(key)); }
+
+    template <typename TK> [[nodiscard]] inline TItem* findImpl(const TK& key, const size_t hashValue) const noexcept
     {
-        EXLBR_ASSERT(!TKeyInfo::isEqual(TKeyInfo::getTombstone(), key));
-        EXLBR_ASSERT(!TKeyInfo::isEqual(TKeyInfo::getEmpty(), key));
+        EXLBR_ASSERT(!TKeyInfo::isEqual(key, TKeyInfo::getTombstone()));
+        EXLBR_ASSERT(!TKeyInfo::isEqual(key, TKeyInfo::getEmpty()));
         const size_t numBuckets = m_numBuckets;
         TItem* const firstItem = m_storage;
         TItem* const endItem = firstItem + numBuckets;
-        const size_t hashValue = TKeyInfo::hash(key);
         const size_t bucketIndex = hashValue & (numBuckets - 1);
         TItem* startItem = firstItem + bucketIndex;
         TItem* EXLBR_RESTRICT currentItem = startItem;
+        size_t distance = 0;
         do
         {
-            if (EXLBR_LIKELY(currentItem->isEqual(key)))
+            if (EXLBR_LIKELY(currentItem->isHashEqual(hashValue) && currentItem->isEqual(key)))
             {
+                recordFind(getProbeLength(currentItem, startItem, numBuckets), true);
                 return currentItem;
             }
 
             if (currentItem->isEmpty())
             {
+                recordFind(getProbeLength(currentItem, startItem, numBuckets), false);
                 return endItem;
             }
 
+            if constexpr (k_RobinHood)
+            {
+                // if the key were in the table, it would have taken this slot from a closer-to-home item
+                if (getProbeDistance(currentItem, numBuckets) < distance)
+                {
+                    recordFind(getProbeLength(currentItem, startItem, numBuckets), false);
+                    return endItem;
+                }
+                distance++;
+            }
+
             currentItem++;
             currentItem = (currentItem == endItem) ? firstItem : currentItem;
         } while (currentItem != startItem);
+        recordFind(numBuckets, false);
         return endItem;
     }
 
-  public:
-    class IteratorBase
+    [[nodiscard]] static inline size_t getProbeLength(const TItem* item, const TItem* startItem, size_t numBuckets) noexcept
     {
-      protected:
-        [[nodiscard]] inline const TKey* getKey() const noexcept
-        {
-            EXLBR_ASSERT(m_item->isValid());
-            return m_item->key();
-        }
-        [[nodiscard]] inline const TValue* getValue() const noexcept
-        {
-            EXLBR_ASSERT(m_item->isValid());
-            return m_item->value();
-        }
-
-        static TItem* getNextValidItem(TItem* item, TItem* endItem) noexcept
-        {
-            do
-            {
-                item++;
-            } while (item < endItem && !item->isValid());
-            return item;
-        }
-
-        void copyFrom(const IteratorBase& other)
-        {
-            m_ht = other.m_ht;
-            m_item = other.m_item;
-        }
-
-      public:
-        IteratorBase() = delete;
-
-        IteratorBase(const IteratorBase& other) noexcept
-            : m_ht(other.m_ht)
-            , m_item(other.m_item)
-        {
-        }
-
-        IteratorBase(const HashTable* ht, TItem* item) noexcept
-            : m_ht(ht)
-            , m_item(item)
-        {
-        }
-
-        bool operator==(const IteratorBase& other) const noexcept
-        {
-            // note: m_ht comparison is redundant and hence skipped
-            return m_item == other.m_item;
-        }
-        bool operator!=(const IteratorBase& other) const noexcept
-        {
-            // note: m_ht comparison is redundant and hence skipped
-            return m_item != other.m_item;
-        }
-
-        IteratorBase& operator++() noexcept
-        {
-            TItem* endItem = m_ht->m_storage + m_ht->m_numBuckets;
-            m_item = getNextValidItem(m_item, endItem);
-            return *this;
-        }
-
-        IteratorBase operator++(int) noexcept
-        {
-            IteratorBase res = *this;
-            ++*this;
-            return res;
-        }
-
-      protected:
-        const HashTable* m_ht;
-        TItem* m_item;
-        friend class HashTable<TKey, TValue, kNumInlineItems, TKeyInfo>;
-    };
-
-    class IteratorK : public IteratorBase
-    {
-      public:
-        IteratorK() = delete;
-
-        IteratorK(const HashTable* ht, TItem* item) noexcept
-            : IteratorBase(ht, item)
-        {
-        }
-
-        [[nodiscard]] inline const TKey& operator*() const noexcept { return *IteratorBase::getKey(); }
-        [[nodiscard]] inline const TKey* operator->() const noexcept { return IteratorBase::getKey(); }
-    };
-
-    template <typename TIteratorValue> class TIteratorV : public IteratorBase
-    {
-      public:
-        TIteratorV() = delete;
-
-        TIteratorV(const HashTable* ht, TItem* item) noexcept
-            : IteratorBase(ht, item)
-        {
-        }
-
-        [[nodiscard]] inline TIteratorValue& operator*() const noexcept { return *const_cast<TIteratorValue*>(IteratorBase::getValue()); }
-        [[nodiscard]] inline TIteratorValue* operator->() const noexcept { return const_cast<TIteratorValue*>(IteratorBase::getValue()); }
-    };
+        return (size_t(item - startItem) & (numBuckets - 1)) + 1;
+    }
 
-    template <typename TIteratorValue> class TIteratorKV : public IteratorBase
+#if defined(EXLBR_ENABLE_STATS)
+    inline void recordFind(size_t probeLength, bool isHit) const noexcept
     {
-      public:
-        // pretty much similar to std::reference_wrapper, but supports late initialization
-        template <typename TYPE> struct reference
-        {
-            TYPE* ptr = nullptr;
-
-            explicit reference(TYPE* _ptr) noexcept
-                : ptr(_ptr)
-            {
-            }
-
-            reference(const reference&) noexcept = default;
-            reference(reference&&) noexcept = default;
-            reference& operator=(const reference&) noexcept = default;
-            reference& operator=(reference&&) noexcept = default;
-            void set(TYPE* _ptr) noexcept { ptr = _ptr; }
-            TYPE& get() const noexcept
-            {
-                EXLBR_ASSERT(ptr);
-                return *ptr;
-            }
-
-            operator TYPE&() const noexcept { return get(); }
-        };
-
-        using KeyValue = std::pair<const reference<const TKey>, const reference<TIteratorValue>>;
-
-      private:
-        void updateTmpKV() const noexcept
-        {
-            const reference<const TKey>& refKey = tmpKv.first;
-            const_cast<reference<const TKey>&>(refKey).set(IteratorBase::getKey());
-            const reference<TIteratorValue>& refVal = tmpKv.second;
-            const_cast<reference<TIteratorValue>&>(refVal).set(const_cast<TIteratorValue*>(IteratorBase::getValue()));
-        }
-
-      public:
-        TIteratorKV() = delete;
-
-        TIteratorKV(const TIteratorKV& other)
-            : IteratorBase(other)
-            , tmpKv(reference<const TKey>(nullptr), reference<TIteratorValue>(nullptr))
-        {
-        }
-
-        TIteratorKV& operator=(const TIteratorKV& other) noexcept
-        {
-            IteratorBase::copyFrom(other);
-            // note: we'll automatically update tmpKv on the next access = no need to copy
-            return *this;
-        }
-
-        TIteratorKV(const HashTable* ht, TItem* item) noexcept
-            : IteratorBase(ht, item)
-            , tmpKv(reference<const TKey>(nullptr), reference<TIteratorValue>(nullptr))
-        {
-        }
-
-        [[nodiscard]] inline const TKey& key() const noexcept { return *IteratorBase::getKey(); }
-        [[nodiscard]] inline TIteratorValue& value() const noexcept { return *const_cast<TIteratorValue*>(IteratorBase::getValue()); }
-        [[nodiscard]] inline KeyValue& operator*() const noexcept
-        {
-            updateTmpKV();
-            return tmpKv;
-        }
+        m_stats.numFinds++;
+        m_stats.numHits += isHit ? 1 : 0;
+        m_stats.numMisses += isHit ? 0 : 1;
+        m_stats.totalProbeLength += probeLength;
+        m_stats.maxProbeLength = std::max(m_stats.maxProbeLength, uint64_t(probeLength));
+    }
+    inline void recordResize() noexcept { m_stats.numResizes++; }
+    inline void recordMove() noexcept { m_stats.numBytesMoved += sizeof(TItem); }
+    inline void recordReseed() noexcept { m_stats.numReseeds++; }
+#else
+    static inline void recordFind(size_t /*probeLength*/, bool /*isHit*/) noexcept {}
+    static inline void recordResize() noexcept {}
+    static inline void recordMove() noexcept {}
+    static inline void recordReseed() noexcept {}
+#endif
 
-        [[nodiscard]] inline KeyValue* operator->() const noexcept
-        {
-            updateTmpKV();
-            return &tmpKv;
-        }
+    // Robin Hood tables are iterated cyclically (see getIterationStart)
+    using TIterators = detail::TableIterators<HashTable, TItem, TKey, TValue, k_RobinHood>;
+    friend TIterators;
 
-      private:
-        mutable KeyValue tmpKv;
-    };
+  public:
+    using IteratorBase = typename TIterators::IteratorBase;
+    using IteratorK = typename TIterators::IteratorK;
+    template <typename TIteratorValue> using TIteratorV = typename TIterators::template TIteratorV<TIteratorValue>;
+    template <typename TIteratorValue> using TIteratorKV = typename TIterators::template TIteratorKV<TIteratorValue>;
 
     using IteratorKV = TIteratorKV<TValue>;
     using ConstIteratorKV = TIteratorKV<const TValue>;
@@ -597,6 +941,15 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         m_storage = constructInline(TKeyInfo::getEmpty());
     }
 
+    explicit HashTable(const TAllocator& allocator) noexcept
+        : TAllocatorHolder(allocator)
+        , m_numBuckets(kNumInlineItems)
+        , m_numElements(0)
+        , m_numTombstones(0)
+    {
+        m_storage = constructInline(TKeyInfo::getEmpty());
+    }
+
     ~HashTable()
     {
         if (m_storage)
@@ -609,37 +962,178 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
     {
         if (empty())
         {
+            // a table drained by erase() still holds its peak storage
+            if (isSparse())
+            {
+                shrink_to_fit();
+            }
+            return;
+        }
+
+        if (isSparse())
+        {
+            // re-allocate storage that fits what the table held (i.e. the refill after clear won't immediately grow)
+            const uint32_t numBucketsNew = getNumBucketsRequired(m_numElements);
+            destroyAndFreeMemory();
+            create(numBucketsNew);
             return;
         }
 
         const uint32_t numBuckets = m_numBuckets;
-        TItem* EXLBR_RESTRICT item = m_storage;
-        TItem* const endItem = item + numBuckets;
-        for (; item != endItem; item++)
+        if constexpr (k_SimdItems && std::is_trivially_destructible<TValue>::value)
         {
-            // destroy value if need
-            if constexpr (!std::is_trivially_destructible<TValue>::value)
+            fillEmpty(m_storage, numBuckets);
+        }
+        else
+        {
+            TItem* EXLBR_RESTRICT item = m_storage;
+            TItem* const endItem = item + numBuckets;
+            for (; item != endItem; item++)
             {
-                if (item->isValid())
+                // destroy value if need
+                if constexpr (!std::is_trivially_destructible<TValue>::value)
                 {
-                    destruct(item->value());
+                    if (item->isValid())
+                    {
+                        destruct(item->value());
+                    }
                 }
-            }
 
-            // set key to empty
-            *item->key() = TKeyInfo::getEmpty();
+                // set key to empty
+                *item->key() = TKeyInfo::getEmpty();
+            }
         }
-        // TODO: shrink if needed?
         m_numElements = 0;
         m_numTombstones = 0;
     }
 
   private:
+    template <bool kGuardProbeLength, typename TK, class... Args>
+    inline std::pair<IteratorKV, bool> emplaceRobinHood(size_t numBuckets, const size_t hashValue, TK&& key, Args&&... args)
+    {
+        const size_t bucketIndex = hashValue & (numBuckets - 1);
+        TItem* const firstItem = m_storage;
+        TItem* const endItem = firstItem + numBuckets;
+        TItem* EXLBR_RESTRICT currentItem = firstItem + bucketIndex;
+        size_t distance = 0;
+        while (true)
+        {
+            if (currentItem->isHashEqual(hashValue) && currentItem->isEqual(key))
+            {
+                return std::make_pair(IteratorKV(this, currentItem), false);
+            }
+
+            if (currentItem->isEmpty())
+            {
+                if constexpr (kGuardProbeLength)
+                {
+                    if (EXLBR_UNLIKELY(distance >= k_MaxProbeLength) && canReseed())
+                    {
+                        return emplaceReseed(std::forward<TK>(key), std::forward<Args>(args)...);
+                    }
+                }
+                assignKey(currentItem->key(), std::forward<TK>(key));
+                currentItem->setHash(hashValue);
+                if constexpr (has_values::value)
+                {
+                    construct<TValue>(currentItem->value(), std::forward<Args>(args)...);
+                }
+                m_numElements++;
+                return std::make_pair(IteratorKV(this, currentItem), true);
+            }
+
+            const size_t residentDistance = getProbeDistance(currentItem, numBuckets);
+            if (residentDistance < distance)
+            {
+                if constexpr (kGuardProbeLength)
+                {
+                    if (EXLBR_UNLIKELY(distance >= k_MaxProbeLength) && canReseed())
+                    {
+                        return emplaceReseed(std::forward<TK>(key), std::forward<Args>(args)...);
+                    }
+                }
+                break;
+            }
+
+            distance++;
+            currentItem++;
+            currentItem = (currentItem == endItem) ? firstItem : currentItem;
+        }
+
+        // The key doesn't exist and the new item takes over the slot of a "richer" item.
+        // Build the new item first: one of the args might point to an item we are about to move.
+        TKey carryKey(std::forward<TK>(key));
+        size_t carryHash = hashValue;
+        using TValueStorage = typename std::aligned_storage<sizeof(TValue), alignof(TValue)>::type;
+        TValueStorage carryValueStorage;
+        TValue* carryValue = reinterpret_cast<TValue*>(&carryValueStorage);
+        if constexpr (has_values::value)
+        {
+            construct<TValue>(carryValue, std::forward<Args>(args)...);
+        }
+
+        TItem* insertItem = currentItem;
+        while (true)
+        {
+            if (currentItem->isEmpty())
+            {
+                *currentItem->key() = std::move(carryKey);
+                currentItem->setHash(carryHash);
+                if constexpr (has_values::value)
+                {
+                    moveConstruct(currentItem->value(), carryValue);
+                }
+                break;
+            }
+
+            const size_t residentDistance = getProbeDistance(currentItem, numBuckets);
+            if (residentDistance < distance)
+            {
+                // swap the carried item with the resident one
+                std::swap(carryKey, *currentItem->key());
+                if constexpr (k_CacheHash)
+                {
+                    const size_t residentHash = currentItem->getHash();
+                    currentItem->setHash(carryHash);
+                    carryHash = residentHash;
+                }
+                if constexpr (has_values::value)
+                {
+                    TValueStorage tmpStorage;
+                    TValue* tmp = reinterpret_cast<TValue*>(&tmpStorage);
+                    moveConstruct(tmp, currentItem->value());
+                    moveConstruct(currentItem->value(), carryValue);
+                    moveConstruct(carryValue, tmp);
+                }
+                distance = residentDistance;
+            }
+
+            distance++;
+            currentItem++;
+            currentItem = (currentItem == endItem) ? firstItem : currentItem;
+        }
+
+        m_numElements++;
+        return std::make_pair(IteratorKV(this, insertItem), true);
+    }
+
     template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplaceToExisting(size_t numBuckets, TK&& key, Args&&... args)
+    {
+        const size_t hashValue = hashKey(key);
+        // rehash moves items with the current seed and is never guarded, inserts are (see also emplaceBatchImpl)
+        return emplaceToExistingWithHash<k_SeededHash>(numBuckets, hashValue, std::forward<TK>(key), std::forward<Args>(args)...);
+    }
+
+    template <bool kGuardProbeLength = false, typename TK, class... Args>
+    inline std::pair<IteratorKV, bool> emplaceToExistingWithHash(size_t numBuckets, const size_t hashValue, TK&& key, Args&&... args)
     {
         EXLBR_ASSERT(numBuckets > 0);
         EXLBR_ASSERT(isPow2(numBuckets));
-        const size_t hashValue = TKeyInfo::hash(key);
+        if constexpr (k_RobinHood)
+        {
+            return emplaceRobinHood<kGuardProbeLength>(numBuckets, hashValue, std::forward<TK>(key), std::forward<Args>(args)...);
+        }
+
         const size_t bucketIndex = hashValue & (numBuckets - 1);
         TItem* const firstItem = m_storage;
         TItem* const endItem = firstItem + numBuckets;
@@ -649,7 +1143,7 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         while (true)
         {
             // key is already exist
-            if (currentItem->isEqual(key))
+            if (currentItem->isHashEqual(hashValue) && currentItem->isEqual(key))
             {
                 return std::make_pair(IteratorKV(this, currentItem), false);
             }
@@ -657,6 +1151,14 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             // if we found an empty bucket, the key doesn't exist in the set.
             if (currentItem->isEmpty())
             {
+                if constexpr (kGuardProbeLength)
+                {
+                    if (EXLBR_UNLIKELY(getProbeLength(currentItem, firstItem + bucketIndex, numBuckets) > k_MaxProbeLength) && canReseed())
+                    {
+                        return emplaceReseed(std::forward<TK>(key), std::forward<Args>(args)...);
+                    }
+                }
+
                 TItem* EXLBR_RESTRICT insertItem = ((foundTombstoneItem == nullptr) ? currentItem : foundTombstoneItem);
 
                 if (foundTombstoneItem)
@@ -664,8 +1166,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
                     m_numTombstones--;
                 }
 
-                // move key
-                *insertItem->key() = std::move(key);
+                assignKey(insertItem->key(), std::forward<TK>(key));
+                insertItem->setHash(hashValue);
                 // construct value if need
                 if constexpr (has_values::value)
                 {
@@ -686,31 +1188,147 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         }
     }
 
+    // Hash flooding guard (seeded tables): an insert that probes more than k_MaxProbeLength buckets picks a new seed.
+    // Reseeding is allowed once per table size, so keys with identical full hashes can't make every insert rehash the table.
+    static inline constexpr size_t k_MaxProbeLength = detail::max_probe_length<TKeyInfo>::value;
+
+    [[nodiscard]] inline bool canReseed() const noexcept { return this->getReseedNumBuckets() != m_numBuckets; }
+
+    template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplaceReseed(TK&& key, Args&&... args)
+    {
+        this->setReseedNumBuckets(m_numBuckets);
+        // one of the args might point to the storage we are about to free (see emplaceReallocate)
+        if constexpr (has_values::value)
+        {
+            TValue value(std::forward<Args>(args)...);
+            reseedImpl(detail::generateHashSeed());
+            return emplaceToExistingWithHash(size_t(m_numBuckets), hashKey(key), std::forward<TK>(key), std::move(value));
+        }
+        else
+        {
+            reseedImpl(detail::generateHashSeed());
+            return emplaceToExistingWithHash(size_t(m_numBuckets), hashKey(key), std::forward<TK>(key));
+        }
+    }
+
+    inline void reseedImpl(uint64_t seed)
+    {
+        recordReseed();
+        this->setSeed(seed);
+        if constexpr (k_CacheHash)
+        {
+            // rehash redistributes items by their cached hashes
+            TItem* const endItem = m_storage + m_numBuckets;
+            for (TItem* item = m_storage; item != endItem; item++)
+            {
+                if (item->isValid())
+                {
+                    item->setHash(hashKey(*item->key()));
+                }
+            }
+        }
+        resize(m_numBuckets);
+    }
+
+    // number of keys hashed at once by rehash (TKeyInfo::hashN)
+    static inline constexpr size_t k_HashBatchSize = 64;
+
+    // moves a valid item to the new storage and destroys the old one
+    inline void reinsertItem(size_t numBucketsNew, TItem* item, size_t hashValue) noexcept
+    {
+        recordMove();
+        if constexpr (has_values::value)
+        {
+            emplaceToExistingWithHash(numBucketsNew, hashValue, std::move(*item->key()), std::move(*item->value()));
+        }
+        else
+        {
+            emplaceToExistingWithHash(numBucketsNew, hashValue, std::move(*item->key()));
+        }
+
+        // destroy old value if need
+        if constexpr ((!std::is_trivially_destructible<TValue>::value) && (has_values::value))
+        {
+            destruct(item->value());
+        }
+
+        // note: this won't automatically call value dtors!
+        destruct(item);
+    }
+
     inline void reinsert(size_t numBucketsNew, TItem* EXLBR_RESTRICT item, TItem* const enditem) noexcept
     {
         // re-insert existing elements
-        for (; item != enditem; item++)
+        if constexpr (k_BulkHash && !k_CacheHash)
         {
-            if (item->isValid())
+            TItem* items[k_HashBatchSize];
+            TKey keys[k_HashBatchSize] = {};
+            size_t hashes[k_HashBatchSize];
+            while (item != enditem)
             {
-                if constexpr (has_values::value)
+                size_t numItems = 0;
+                for (; item != enditem && numItems < k_HashBatchSize; item++)
                 {
-                    emplaceToExisting(numBucketsNew, std::move(*item->key()), std::move(*item->value()));
+                    if (item->isValid())
+                    {
+                        items[numItems] = item;
+                        keys[numItems] = *item->key();
+                        numItems++;
+                    }
+                    else
+                    {
+                        destruct(item);
+                    }
                 }
-                else
+
+                // the hashes are known in advance, so the target buckets can be prefetched as well
+                TKeyInfo::hashN(keys, hashes, numItems);
+                const size_t numPrologue = std::min(k_PrefetchDistance, numItems);
+                for (size_t i = 0; i < numPrologue; i++)
                 {
-                    emplaceToExisting(numBucketsNew, std::move(*item->key()));
+                    EXLBR_PREFETCH(m_storage + (hashes[i] & (numBucketsNew - 1)));
                 }
-
-                // destroy old value if need
-                if constexpr ((!std::is_trivially_destructible<TValue>::value) && (has_values::value))
+                for (size_t i = 0; i < numItems; i++)
                 {
-                    destruct(item->value());
+                    if (i + k_PrefetchDistance < numItems)
+                    {
+                        EXLBR_PREFETCH(m_storage + (hashes[i + k_PrefetchDistance] & (numBucketsNew - 1)));
+                    }
+                    reinsertItem(numBucketsNew, items[i], hashes[i]);
+                }
+            }
+        }
+        else
+        {
+            for (; item != enditem; item++)
+            {
+                if (item->isValid())
+                {
+                    // note: no need to call hash() if the hash is cached
+                    reinsertItem(numBucketsNew, item, getItemHash(item));
+                }
+                else
+                {
+                    destruct(item);
                 }
             }
+        }
+    }
 
-            // note: this won't automatically call value dtors!
-            destruct(item);
+    template <typename TK, class... Args>
+    inline std::pair<IteratorKV, bool> emplaceReallocateRobinHood(size_t numBucketsNew, TItem* item, TItem* const enditem,
+                                                                  const size_t hashValue, TK&& key, Args&&... args)
+    {
+        if constexpr (has_values::value)
+        {
+            TValue value(std::forward<Args>(args)...);
+            reinsert(numBucketsNew, item, enditem);
+            return emplaceToExistingWithHash(numBucketsNew, hashValue, std::forward<TK>(key), std::move(value));
+        }
+        else
+        {
+            reinsert(numBucketsNew, item, enditem);
+            return emplaceToExistingWithHash(numBucketsNew, hashValue, std::forward<TK>(key));
         }
     }
 
@@ -724,7 +1342,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
         // check if such element is already exist
         // in this case we don't need to do anything
-        TItem* existingItem = findImpl(key);
+        const size_t hashValue = hashKey(key);
+        TItem* existingItem = findImpl(key, hashValue);
         if (existingItem != enditem)
         {
             return std::make_pair(IteratorKV(this, existingItem), false);
@@ -732,21 +1351,36 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
         bool isInlineStorage = isUsingInlineStorage();
 
+        recordResize();
         numBucketsNew = create(numBucketsNew);
 
+        if constexpr (k_RobinHood)
+        {
+            // Robin Hood reinsertion could displace the new item, so it has to be inserted last.
+            // Build its value up front because one of the args might point to the old storage.
+            std::pair<IteratorKV, bool> it = emplaceReallocateRobinHood(size_t(numBucketsNew), item, enditem, hashValue,
+                                                                        std::forward<TK>(key), std::forward<Args>(args)...);
+            if (!isInlineStorage)
+            {
+                freeStorage(storage, numBuckets);
+            }
+            return it;
+        }
+
         //
         // insert a new element (one of the args might still point to the old storage in case of hash table 'aliasing'
         //
         // i.e.
         // auto it = table.find("key");
         // table.emplace("another_key", it->second);   // <--- when hash table grows it->second will point to a memory we are about to free
-        std::pair<IteratorKV, bool> it = emplaceToExisting(size_t(numBucketsNew), std::forward<TK>(key), std::forward<Args>(args)...);
+        std::pair<IteratorKV, bool> it =
+            emplaceToExistingWithHash(size_t(numBucketsNew), hashValue, std::forward<TK>(key), std::forward<Args>(args)...);
 
         reinsert(size_t(numBucketsNew), item, enditem);
 
         if (!isInlineStorage)
         {
-            EXLBR_FREE(storage);
+            freeStorage(storage, numBuckets);
         }
 
         return it;
@@ -755,11 +1389,12 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
   public:
     template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplace(TK&& key, Args&&... args)
     {
-        static_assert(std::is_same<TKey, typename std::remove_const<typename std::remove_reference<TK>::type>::type>::value,
+        static_assert(std::is_same<TKey, typename std::remove_const<typename std::remove_reference<TK>::type>::type>::value ||
+                          detail::is_transparent_key<TKeyInfo, TKey, TK>::value,
                       "Expected unversal reference of TKey type. Wrong key type?");
 
-        EXLBR_ASSERT(!TKeyInfo::isEqual(TKeyInfo::getTombstone(), key));
-        EXLBR_ASSERT(!TKeyInfo::isEqual(TKeyInfo::getEmpty(), key));
+        EXLBR_ASSERT(!TKeyInfo::isEqual(key, TKeyInfo::getTombstone()));
+        EXLBR_ASSERT(!TKeyInfo::isEqual(key, TKeyInfo::getEmpty()));
         EXLBR_ASSERT(!TKeyInfo::isEqual(TKeyInfo::getEmpty(), TKeyInfo::getTombstone()));
         uint32_t numBuckets = m_numBuckets;
 
@@ -794,12 +1429,187 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         return IteratorKV(this, item);
     }
 
-    inline TItem* eraseImpl(const IteratorBase it)
+    // heterogeneous lookup (requires TKeyInfo::is_transparent), no temporary TKey is constructed
+    template <typename TK, typename = enable_if_transparent<TK>> [[nodiscard]] inline ConstIteratorKV find(const TK& key) const noexcept
+    {
+        return ConstIteratorKV(this, findImpl(key));
+    }
+    template <typename TK, typename = enable_if_transparent<TK>> [[nodiscard]] inline IteratorKV find(const TK& key) noexcept
+    {
+        return IteratorKV(this, findImpl(key));
+    }
+
+  private:
+    // number of probes in flight
+    static inline constexpr size_t k_PrefetchDistance = 16;
+
+    // Software pipeline: the home bucket of item[i + k_PrefetchDistance] is prefetched while item[i] is processed,
+    // so the cache misses of consecutive operations overlap instead of being paid one after another.
+    template <typename TIterator, typename TGetKey, typename TFunc>
+    inline void prefetchPipeline(TIterator it, size_t numItems, TGetKey&& getKey, TFunc&& func) const
+    {
+        const size_t mask = size_t(m_numBuckets) - 1;
+        size_t hashes[k_PrefetchDistance];
+        TIterator ahead = it;
+        const size_t numPrologue = std::min(k_PrefetchDistance, numItems);
+        for (size_t i = 0; i < numPrologue; i++, ++ahead)
+        {
+            const size_t hashValue = hashKey(getKey(*ahead));
+            hashes[i] = hashValue;
+            EXLBR_PREFETCH(m_storage + (hashValue & mask));
+        }
+
+        for (size_t i = 0; i < numItems; i++, ++it)
+        {
+            const size_t slot = i % k_PrefetchDistance;
+            const size_t hashValue = hashes[slot];
+            if (i + k_PrefetchDistance < numItems)
+            {
+                const size_t nextHashValue = hashKey(getKey(*ahead));
+                ++ahead;
+                hashes[slot] = nextHashValue;
+                EXLBR_PREFETCH(m_storage + (nextHashValue & mask));
+            }
+            func(i, *it, hashValue);
+        }
+    }
+
+    template <typename TFunc> inline void findBatchImpl(const TKey* keys, size_t numKeys, TFunc&& func) const noexcept
+    {
+        prefetchPipeline(
+            keys, numKeys, [](const TKey& key) -> const TKey& { return key; },
+            [this, &func](size_t index, const TKey& key, size_t hashValue) { func(index, findImpl(key, hashValue)); });
+    }
+
+    // grow once so that 'numItems' new keys fit without reallocation (assumes that all the keys are new)
+    inline void reserveForBatch(size_t numItems)
+    {
+        EXLBR_ASSERT(size_t(m_numElements) + numItems < size_t(UINT32_MAX));
+        const uint32_t numBuckets = m_numBuckets;
+        if ((size_t(m_numElements) + m_numTombstones + numItems) <= size_t((numBuckets >> 1) + (numBuckets >> 2) + 1))
+        {
+            return;
+        }
+
+        // note: resize also gets rid of all the tombstones
+        const size_t numRequired = size_t(m_numElements) + numItems;
+        uint32_t numBucketsNew = std::max(numBuckets, k_MinNumberOfBuckets);
+        while (numRequired > size_t((numBucketsNew >> 1) + (numBucketsNew >> 2) + 1))
+        {
+            numBucketsNew *= 2;
+        }
+        resize(numBucketsNew);
+    }
+
+    template <typename TIterator, typename TGetKey, typename TInsert>
+    inline uint32_t emplaceBatchImpl(TIterator first, size_t numItems, TGetKey&& getKey, TInsert&& insert)
+    {
+        reserveForBatch(numItems);
+        const uint32_t numElements = m_numElements;
+        // a seeded table can reseed in the middle of the batch (see emplaceReseed), then the hashes the pipeline
+        // has already computed ahead of the current item are stale and have to be recomputed
+        uint64_t seed = this->getSeed();
+        size_t numStaleHashes = 0;
+        prefetchPipeline(first, numItems, getKey,
+                         [this, &getKey, &insert, &seed, &numStaleHashes](size_t index, const auto& item, size_t hashValue)
+                         {
+                             // no growth check here, reserveForBatch took care of it (reseeding keeps the number of buckets)
+                             EXLBR_ASSERT((m_numElements + m_numTombstones) < ((m_numBuckets >> 1) + (m_numBuckets >> 2) + 1));
+                             if constexpr (k_SeededHash)
+                             {
+                                 if (EXLBR_UNLIKELY(numStaleHashes != 0))
+                                 {
+                                     numStaleHashes--;
+                                     hashValue = hashKey(getKey(item));
+                                 }
+                             }
+                             insert(index, item, hashValue);
+                             if constexpr (k_SeededHash)
+                             {
+                                 if (EXLBR_UNLIKELY(this->getSeed() != seed))
+                                 {
+                                     seed = this->getSeed();
+                                     numStaleHashes = k_PrefetchDistance;
+                                 }
+                             }
+                         });
+        return m_numElements - numElements;
+    }
+
+  public:
+    // out[i] = find(keys[i]), 'out' has to point to numKeys iterators (i.e. std::vector<IteratorKV> out(numKeys, ht.iend()))
+    inline void findBatch(const TKey* keys, size_t numKeys, ConstIteratorKV* out) const noexcept
+    {
+        findBatchImpl(keys, numKeys, [this, out](size_t index, TItem* item) { out[index] = ConstIteratorKV(this, item); });
+    }
+    inline void findBatch(const TKey* keys, size_t numKeys, IteratorKV* out) noexcept
+    {
+        findBatchImpl(keys, numKeys, [this, out](size_t index, TItem* item) { out[index] = IteratorKV(this, item); });
+    }
+
+    // out[i] = has(keys[i]), returns the number of keys found
+    inline size_t hasBatch(const TKey* keys, size_t numKeys, bool* out) const noexcept
+    {
+        TItem* const endItem = m_storage + m_numBuckets;
+        size_t numFound = 0;
+        findBatchImpl(keys, numKeys,
+                      [endItem, out, &numFound](size_t index, TItem* item)
+                      {
+                          const bool isFound = (item != endItem);
+                          out[index] = isFound;
+                          numFound += isFound ? 1 : 0;
+                      });
+        return numFound;
+    }
+
+    // Bulk insert: reserves once up front, then inserts with prefetching (see prefetchPipeline).
+    // Items are std::pair-like (key, value) for maps and keys for sets. Existing keys are left untouched.
+    // Seeded tables guard the probe length the same way emplace does (see SeededKeyInfo).
+    // Returns the number of inserted items.
+    template <typename TIterator> inline uint32_t insertBatch(TIterator first, TIterator last)
+    {
+        const size_t numItems = size_t(std::distance(first, last));
+        if constexpr (has_values::value)
+        {
+            return emplaceBatchImpl(
+                first, numItems, [](const auto& item) -> const TKey& { return item.first; },
+                [this](size_t /*index*/, const auto& item, size_t hashValue)
+                { emplaceToExistingWithHash<k_SeededHash>(size_t(m_numBuckets), hashValue, item.first, item.second); });
+        }
+        else
+        {
+            return emplaceBatchImpl(
+                first, numItems, [](const TKey& key) -> const TKey& { return key; },
+                [this](size_t /*index*/, const TKey& key, size_t hashValue)
+                { emplaceToExistingWithHash<k_SeededHash>(size_t(m_numBuckets), hashValue, key); });
+        }
+    }
+
+    // emplace(keys[i], values[i]) for all the items (hash map version)
+    inline uint32_t emplaceBatch(const TKey* keys, const TValue* values, size_t numItems)
+    {
+        return emplaceBatchImpl(
+            keys, numItems, [](const TKey& key) -> const TKey& { return key; },
+            [this, values](size_t index, const TKey& key, size_t hashValue)
+            { emplaceToExistingWithHash<k_SeededHash>(size_t(m_numBuckets), hashValue, key, values[index]); });
+    }
+
+    // emplace(keys[i]) for all the items (hash set version)
+    inline uint32_t emplaceBatch(const TKey* keys, size_t numItems)
+    {
+        return emplaceBatchImpl(
+            keys, numItems, [](const TKey& key) -> const TKey& { return key; },
+            [this](size_t /*index*/, const TKey& key, size_t hashValue)
+            { emplaceToExistingWithHash<k_SeededHash>(size_t(m_numBuckets), hashValue, key); });
+    }
+
+    // kFindNext = false skips the search for the next valid item (i.e. the return value is unused)
+    template <bool kFindNext = true> inline TItem* eraseImpl(const IteratorBase it)
     {
         TItem* EXLBR_RESTRICT item = m_storage;
         TItem* const endItem = item + m_numBuckets;
 
-        if (it == IteratorHelper<IteratorBase>::end(*this))
+        if (it == TIterators::template end<IteratorBase>(*this))
         {
             return endItem;
         }
@@ -813,6 +1623,11 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             destruct(itemValue);
         }
 
+        if constexpr (k_RobinHood)
+        {
+            return eraseBackwardShift<kFindNext>(it.m_slot, it.getStartSlot(), endItem);
+        }
+
         TKey* itemKey = const_cast<TKey*>(it.getKey());
         if (m_numElements == 0)
         {
@@ -821,29 +1636,121 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             return endItem;
         }
 
-        // overwrite key with empty key
-        *itemKey = TKeyInfo::getTombstone();
-        m_numTombstones++;
-        return IteratorBase::getNextValidItem(it.m_item, endItem);
+        // no probe sequence continues past an empty slot, so neither the erased item nor the tombstones right before it are needed
+        TItem* const firstItem = m_storage;
+        TItem* nextItem = it.m_slot + 1;
+        nextItem = (nextItem == endItem) ? firstItem : nextItem;
+        if (nextItem->isEmpty())
+        {
+            *itemKey = TKeyInfo::getEmpty();
+            TItem* prevItem = it.m_slot;
+            while (true)
+            {
+                prevItem = (prevItem == firstItem) ? endItem - 1 : prevItem - 1;
+                if (!prevItem->isTombstone())
+                {
+                    break;
+                }
+                *prevItem->key() = TKeyInfo::getEmpty();
+                m_numTombstones--;
+            }
+        }
+        else
+        {
+            // overwrite key with empty key
+            *itemKey = TKeyInfo::getTombstone();
+            m_numTombstones++;
+        }
+
+        if constexpr (kFindNext)
+        {
+            return skipInvalidItems(it.m_slot + 1, endItem);
+        }
+        return endItem;
+    }
+
+  private:
+    template <bool kFindNext> inline TItem* eraseBackwardShift(TItem* erasedItem, TItem* startItem, TItem* const endItem)
+    {
+        // note: the value of the erased item is already destroyed
+        const size_t numBuckets = m_numBuckets;
+        TItem* const firstItem = m_storage;
+        TItem* EXLBR_RESTRICT holeItem = erasedItem;
+        while (true)
+        {
+            TItem* nextItem = holeItem + 1;
+            nextItem = (nextItem == endItem) ? firstItem : nextItem;
+            if (nextItem->isEmpty() || getProbeDistance(nextItem, numBuckets) == 0)
+            {
+                break;
+            }
+
+            // shift the next item one slot back (closer to its home bucket)
+            *holeItem->key() = std::move(*nextItem->key());
+            copyHash(holeItem, nextItem);
+            if constexpr (has_values::value)
+            {
+                moveConstruct(holeItem->value(), nextItem->value());
+            }
+            holeItem = nextItem;
+        }
+        *holeItem->key() = TKeyInfo::getEmpty();
+
+        if constexpr (!kFindNext)
+        {
+            return endItem;
+        }
+
+        // Items only move one slot back and never across the empty bucket in front of startItem,
+        // so an item shifted into the erased slot hasn't been visited by the iterator yet.
+        if (erasedItem->isValid())
+        {
+            return erasedItem;
+        }
+        return TIterators::getNextSlot(this, erasedItem, startItem);
     }
 
+  public:
     inline IteratorKV erase(const IteratorKV& it)
     {
         TItem* item = eraseImpl(it);
-        return IteratorKV(this, item);
+        return IteratorKV(this, item, it.getStartSlot());
     }
 
     inline ConstIteratorKV erase(const ConstIteratorKV& it)
     {
         TItem* item = eraseImpl(it);
-        return ConstIteratorKV(this, item);
+        return ConstIteratorKV(this, item, it.getStartSlot());
     }
 
     inline bool erase(const TKey& key)
     {
         auto it = find(key);
-        erase(it);
-        return (it != iend());
+        eraseImpl<false>(it);
+        const bool isErased = (it != iend());
+        if constexpr (TShrinkPolicy::k_ShrinkOnErase)
+        {
+            if (isErased && isSparse())
+            {
+                shrink_to_fit();
+            }
+        }
+        return isErased;
+    }
+
+    template <typename TK, typename = enable_if_transparent<TK>> inline bool erase(const TK& key)
+    {
+        auto it = find(key);
+        eraseImpl<false>(it);
+        const bool isErased = (it != iend());
+        if constexpr (TShrinkPolicy::k_ShrinkOnErase)
+        {
+            if (isErased && isSparse())
+            {
+                shrink_to_fit();
+            }
+        }
+        return isErased;
     }
 
   private:
@@ -856,36 +1763,231 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         TItem* const enditem = item + numBuckets;
         bool isInlineStorage = isUsingInlineStorage();
 
+        recordResize();
         numBucketsNew = create(numBucketsNew);
 
         reinsert(numBucketsNew, item, enditem);
 
         if (!isInlineStorage)
         {
-            EXLBR_FREE(storage);
+            freeStorage(storage, numBuckets);
+        }
+    }
+
+    // smallest number of buckets that holds 'numItems' without growing
+    [[nodiscard]] static inline uint32_t getNumBucketsRequired(uint32_t numItems) noexcept
+    {
+        uint32_t numBuckets = k_MinNumberOfBuckets;
+        while (numItems >= (numBuckets >> 1) + (numBuckets >> 2) + 1)
+        {
+            numBuckets *= 2;
+        }
+        return numBuckets;
+    }
+
+    // 'true' if the shrink policy wants to release some of the bucket memory
+    [[nodiscard]] inline bool isSparse() const noexcept
+    {
+        if constexpr (TShrinkPolicy::k_MinLoadDivisor == 0)
+        {
+            return false;
+        }
+        else
+        {
+            const uint32_t numBuckets = m_numBuckets;
+            return numBuckets > k_MinNumberOfBuckets && m_numElements < (numBuckets / TShrinkPolicy::k_MinLoadDivisor);
         }
     }
 
   public:
     inline void rehash() { resize(m_numBuckets); }
 
+    // seed of a seeded table (see SeededKeyInfo), random from construction on
+    [[nodiscard]] inline uint64_t getHashSeed() const noexcept { return this->getSeed(); }
+
+    // rehashes a seeded table with a new seed (i.e. a fixed one for reproducible tests)
+    inline void reseed(uint64_t seed)
+    {
+        static_assert(k_SeededHash, "Only tables with a seeded KeyInfo can be reseeded (see SeededKeyInfo)");
+        reseedImpl(seed);
+    }
+    inline void reseed() { reseed(detail::generateHashSeed()); }
+
+    // Removes all the tombstones without allocating a second bucket array (unlike rehash).
+    // Slots are visited once in probe order, starting right after an empty slot, and every item is moved to the first free slot
+    // of its probe sequence. The home bucket of an item is always visited before the item itself (no probe sequence crosses
+    // an empty slot), so an item only moves backwards into the already cleaned part of the table.
+    inline void purgeTombstones()
+    {
+        if (m_numTombstones == 0)
+        {
+            return;
+        }
+
+        const size_t numBuckets = m_numBuckets;
+        TItem* const firstItem = m_storage;
+        TItem* const endItem = firstItem + numBuckets;
+        size_t startIndex = 0;
+        while (startIndex < numBuckets && !(firstItem + startIndex)->isEmpty())
+        {
+            startIndex++;
+        }
+        if (startIndex == numBuckets)
+        {
+            // tiny inline tables can be completely full (elements + tombstones)
+            rehash();
+            return;
+        }
+
+        TItem* currentItem = firstItem + startIndex;
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            currentItem++;
+            currentItem = (currentItem == endItem) ? firstItem : currentItem;
+            if (currentItem->isTombstone())
+            {
+                *currentItem->key() = TKeyInfo::getEmpty();
+                continue;
+            }
+            if (!currentItem->isValid())
+            {
+                continue;
+            }
+
+            TItem* targetItem = firstItem + (getItemHash(currentItem) & (numBuckets - 1));
+            while (targetItem != currentItem && !targetItem->isEmpty())
+            {
+                targetItem++;
+                targetItem = (targetItem == endItem) ? firstItem : targetItem;
+            }
+            if (targetItem == currentItem)
+            {
+                continue;
+            }
+
+            *targetItem->key() = std::move(*currentItem->key());
+            copyHash(targetItem, currentItem);
+            if constexpr (has_values::value)
+            {
+                moveConstruct(targetItem->value(), currentItem->value());
+            }
+            *currentItem->key() = TKeyInfo::getEmpty();
+        }
+        m_numTombstones = 0;
+    }
+
+    // releases as much bucket memory as possible (an empty table goes back to its inline storage)
+    inline void shrink_to_fit()
+    {
+        if (empty())
+        {
+            if (!isUsingInlineStorage())
+            {
+                destroyAndFreeMemory();
+                m_storage = constructInline(TKeyInfo::getEmpty());
+                m_numBuckets = kNumInlineItems;
+                m_numElements = 0;
+                m_numTombstones = 0;
+            }
+            return;
+        }
+
+        const uint32_t numBucketsNew = getNumBucketsRequired(m_numElements);
+        if (numBucketsNew < m_numBuckets)
+        {
+            resize(numBucketsNew);
+        }
+    }
+
     inline bool reserve(uint32_t numBucketsNew)
     {
         if (numBucketsNew == 0 || numBucketsNew < capacity())
         {
             return false;
         }
-        numBucketsNew = nextPow2(numBucketsNew);
+        numBucketsNew = detail::nextPow2(numBucketsNew);
         resize(numBucketsNew);
         return true;
     }
 
+    [[nodiscard]] inline const TAllocator& getAllocator() const noexcept { return this->getAllocatorRef(); }
+
     [[nodiscard]] inline uint32_t getNumTombstones() const noexcept { return m_numTombstones; }
+
+#if defined(EXLBR_ENABLE_STATS)
+    [[nodiscard]] inline const HashTableStats& getStats() const noexcept { return m_stats; }
+    inline void resetStats() noexcept { m_stats = HashTableStats(); }
+#endif
+
+    // walks the whole storage, O(capacity)
+    [[nodiscard]] ProbeHistogram computeProbeHistogram() const
+    {
+        ProbeHistogram res;
+        const uint32_t numBuckets = m_numBuckets;
+        res.numBuckets = numBuckets;
+        res.numElements = m_numElements;
+        res.numTombstones = m_numTombstones;
+
+        const TItem* const firstItem = m_storage;
+        const TItem* const endItem = firstItem + numBuckets;
+        for (const TItem* item = firstItem; item != endItem; item++)
+        {
+            if (item->isValid())
+            {
+                const uint32_t distance = uint32_t(getProbeDistance(item, numBuckets));
+                if (distance >= res.displacement.size())
+                {
+                    res.displacement.resize(size_t(distance) + 1, 0);
+                }
+                res.displacement[distance]++;
+                res.maxDisplacement = std::max(res.maxDisplacement, distance);
+            }
+        }
+
+        // start right after an empty bucket so that clusters that wrap around the end of the storage are counted once
+        uint32_t startIndex = 0;
+        while (startIndex < numBuckets && !(firstItem + startIndex)->isEmpty())
+        {
+            startIndex++;
+        }
+        if (startIndex == numBuckets)
+        {
+            res.clusterLength.resize(size_t(numBuckets) + 1, 0);
+            res.clusterLength[numBuckets] = 1;
+            res.maxClusterLength = numBuckets;
+            return res;
+        }
+
+        uint32_t runLength = 0;
+        for (uint32_t i = 1; i <= numBuckets; i++)
+        {
+            if (!(firstItem + ((startIndex + i) & (numBuckets - 1)))->isEmpty())
+            {
+                runLength++;
+                continue;
+            }
+            if (runLength != 0)
+            {
+                if (runLength >= res.clusterLength.size())
+                {
+                    res.clusterLength.resize(size_t(runLength) + 1, 0);
+                }
+                res.clusterLength[runLength]++;
+                res.maxClusterLength = std::max(res.maxClusterLength, runLength);
+                runLength = 0;
+            }
+        }
+        return res;
+    }
     [[nodiscard]] inline uint32_t size() const noexcept { return m_numElements; }
     [[nodiscard]] inline uint32_t capacity() const noexcept { return m_numBuckets; }
     [[nodiscard]] inline bool empty() const noexcept { return (m_numElements == 0); }
 
     [[nodiscard]] inline bool has(const TKey& key) const noexcept { return (find(key) != iend()); }
+    template <typename TK, typename = enable_if_transparent<TK>> [[nodiscard]] inline bool has(const TK& key) const noexcept
+    {
+        return (find(key) != iend());
+    }
 
     inline TValue& operator[](const TKey& key)
     {
@@ -893,29 +1995,26 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
         return emplaceIt.first.value();
     }
 
-    [[nodiscard]] inline IteratorK begin() const { return IteratorHelper<IteratorK>::begin(*this); }
-    [[nodiscard]] inline IteratorK end() const { return IteratorHelper<IteratorK>::end(*this); }
+    template <typename TK, typename = enable_if_transparent<TK>> inline TValue& operator[](const TK& key)
+    {
+        std::pair<IteratorKV, bool> emplaceIt = emplace(key);
+        return emplaceIt.first.value();
+    }
+
+    [[nodiscard]] inline IteratorK begin() const { return TIterators::template begin<IteratorK>(*this); }
+    [[nodiscard]] inline IteratorK end() const { return TIterators::template end<IteratorK>(*this); }
 
-    [[nodiscard]] inline ConstIteratorV vbegin() const { return IteratorHelper<ConstIteratorV>::begin(*this); }
-    [[nodiscard]] inline ConstIteratorV vend() const { return IteratorHelper<ConstIteratorV>::end(*this); }
-    [[nodiscard]] inline IteratorV vbegin() { return IteratorHelper<IteratorV>::begin(*this); }
-    [[nodiscard]] inline IteratorV vend() { return IteratorHelper<IteratorV>::end(*this); }
+    [[nodiscard]] inline ConstIteratorV vbegin() const { return TIterators::template begin<ConstIteratorV>(*this); }
+    [[nodiscard]] inline ConstIteratorV vend() const { return TIterators::template end<ConstIteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vbegin() { return TIterators::template begin<IteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vend() { return TIterators::template end<IteratorV>(*this); }
 
-    [[nodiscard]] inline ConstIteratorKV ibegin() const { return IteratorHelper<ConstIteratorKV>::begin(*this); }
-    [[nodiscard]] inline ConstIteratorKV iend() const { return IteratorHelper<ConstIteratorKV>::end(*this); }
-    [[nodiscard]] inline IteratorKV ibegin() { return IteratorHelper<IteratorKV>::begin(*this); }
-    [[nodiscard]] inline IteratorKV iend() { return IteratorHelper<IteratorKV>::end(*this); }
+    [[nodiscard]] inline ConstIteratorKV ibegin() const { return TIterators::template begin<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline ConstIteratorKV iend() const { return TIterators::template end<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV ibegin() { return TIterators::template begin<IteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV iend() { return TIterators::template end<IteratorKV>(*this); }
 
-    template <typename TIterator> struct TypedIteratorHelper
-    {
-        const HashTable* ht;
-        TypedIteratorHelper(const HashTable* _ht)
-            : ht(_ht)
-        {
-        }
-        TIterator begin() { return IteratorHelper<TIterator>::begin(*ht); }
-        TIterator end() { return IteratorHelper<TIterator>::end(*ht); }
-    };
+    template <typename TIterator> using TypedIteratorHelper = typename TIterators::template TypedIteratorHelper<TIterator>;
 
     using Keys = TypedIteratorHelper<IteratorK>;
     using Values = TypedIteratorHelper<IteratorV>;
@@ -932,6 +2031,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
     // copy ctor
     HashTable(const HashTable& other)
+        : TAllocatorHolder(other.getAllocatorRef())
+        , TSeedHolder(other)
     {
         EXLBR_ASSERT(&other != this);
         m_storage = constructInline(TKeyInfo::getEmpty());
@@ -947,6 +2048,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             return *this;
         }
         destroyAndFreeMemory();
+        this->getAllocatorRef() = other.getAllocatorRef();
+        static_cast<TSeedHolder&>(*this) = static_cast<const TSeedHolder&>(other);
         m_storage = constructInline(TKeyInfo::getEmpty());
         create(other.m_numBuckets);
         copyFrom(other);
@@ -955,7 +2058,8 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 
     // move ctor
     HashTable(HashTable&& other) noexcept
-    //: m_storage(nullptr)
+        : TAllocatorHolder(other.getAllocatorRef())
+    //, m_storage(nullptr)
     //, m_numBuckets(1)
     //, m_numElements(0)
     {
@@ -971,17 +2075,25 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
             return *this;
         }
         destroyAndFreeMemory();
+        // note: the storage is moved along with the allocator that owns it
+        this->getAllocatorRef() = other.getAllocatorRef();
         moveFrom(std::move(other));
         return *this;
     }
 
   private:
+    template <typename THashTable> friend struct detail::SnapshotAccess;
+    template <typename THashTable> friend struct detail::IncrementalAccess;
+
     // prefix m_ to be able to easily see member access from the code (it could be more expensive in the inner loop)
     TItem* m_storage;         // 8
     uint32_t m_numBuckets;    // 4
     uint32_t m_numElements;   // 4
     uint32_t m_numTombstones; // 4
     // padding 4
+#if defined(EXLBR_ENABLE_STATS)
+    mutable HashTableStats m_stats;
+#endif
 
     template <typename INTEGRAL_TYPE> inline static constexpr bool isPow2(INTEGRAL_TYPE x) noexcept
     {
@@ -998,11 +2110,13 @@ template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename
 };
 
 // hashmap declaration
-template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>>
-using HashMap = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo>;
+template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, typename TProbing = LinearProbing,
+          typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+using HashMap = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
 
 // hashset declaration
-template <typename TKey, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>>
-using HashSet = HashTable<TKey, std::nullptr_t, kNumInlineItems, TKeyInfo>;
+template <typename TKey, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, typename TProbing = LinearProbing,
+          typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+using HashSet = HashTable<TKey, std::nullptr_t, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
 
 } // namespace Excalibur
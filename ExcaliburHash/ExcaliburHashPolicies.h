@@ -0,0 +1,220 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+
+// Integer hash policies selectable per table (see HashPolicyKeyInfo).
+// CRC32C uses SSE4.2 / ARMv8 CRC instructions. If the compiler doesn't target them, x86-64 checks the CPU once at runtime,
+// everything else falls back to a table-driven version. All code paths return the same values.
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define EXLBR_CRC32C_X86 (1)
+    #include <nmmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+    #if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+        #define EXLBR_CRC32C_NATIVE (1)
+        #define EXLBR_TARGET_SSE42
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define EXLBR_TARGET_SSE42 __attribute__((target("sse4.2")))
+    #else
+        #define EXLBR_TARGET_SSE42
+    #endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    #define EXLBR_CRC32C_ARM (1)
+    #define EXLBR_CRC32C_NATIVE (1)
+    #include <arm_acle.h>
+#endif
+
+namespace Excalibur
+{
+
+namespace crc32c
+{
+
+namespace detail
+{
+// reflected Castagnoli polynomial
+struct Table
+{
+    uint32_t v[256];
+    constexpr Table()
+        : v()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? UINT32_C(0x82F63B78) : 0);
+            }
+            v[i] = crc;
+        }
+    }
+};
+
+inline constexpr Table k_Table{};
+
+// crc = CRC32C state, the bytes of 'v' are fed in little-endian order (what the hardware instructions do)
+[[nodiscard]] inline uint32_t updateSoftware(uint32_t crc, uint64_t v, int numBytes) noexcept
+{
+    for (int i = 0; i < numBytes; i++)
+    {
+        crc = (crc >> 8) ^ k_Table.v[(crc ^ uint32_t(v >> (i * 8))) & 0xff];
+    }
+    return crc;
+}
+
+#if defined(EXLBR_CRC32C_X86)
+EXLBR_TARGET_SSE42 inline uint32_t updateHardware(uint32_t crc, uint64_t v) noexcept { return uint32_t(_mm_crc32_u64(crc, v)); }
+EXLBR_TARGET_SSE42 inline uint32_t updateHardware(uint32_t crc, uint32_t v) noexcept { return _mm_crc32_u32(crc, v); }
+
+    #if !defined(EXLBR_CRC32C_NATIVE)
+[[nodiscard]] inline bool detectHardware() noexcept
+{
+        #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+        #else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+        #endif
+}
+    #endif
+#elif defined(EXLBR_CRC32C_ARM)
+inline uint32_t updateHardware(uint32_t crc, uint64_t v) noexcept { return __crc32cd(crc, v); }
+inline uint32_t updateHardware(uint32_t crc, uint32_t v) noexcept { return __crc32cw(crc, v); }
+#endif
+} // namespace detail
+
+// true if the CRC32C instructions are used
+[[nodiscard]] inline bool isHardwareAccelerated() noexcept
+{
+#if defined(EXLBR_CRC32C_NATIVE)
+    return true;
+#elif defined(EXLBR_CRC32C_X86)
+    static const bool hasHardware = detail::detectHardware();
+    return hasHardware;
+#else
+    return false;
+#endif
+}
+
+// standard CRC32C of the 8/4 little-endian bytes of 'v'
+[[nodiscard]] inline uint32_t hash(uint64_t v) noexcept
+{
+#if defined(EXLBR_CRC32C_NATIVE)
+    return ~detail::updateHardware(UINT32_C(0xffffffff), v);
+#else
+    #if defined(EXLBR_CRC32C_X86)
+    if (isHardwareAccelerated())
+    {
+        return ~detail::updateHardware(UINT32_C(0xffffffff), v);
+    }
+    #endif
+    return ~detail::updateSoftware(UINT32_C(0xffffffff), v, 8);
+#endif
+}
+
+[[nodiscard]] inline uint32_t hash(uint32_t v) noexcept
+{
+#if defined(EXLBR_CRC32C_NATIVE)
+    return ~detail::updateHardware(UINT32_C(0xffffffff), v);
+#else
+    #if defined(EXLBR_CRC32C_X86)
+    if (isHardwareAccelerated())
+    {
+        return ~detail::updateHardware(UINT32_C(0xffffffff), v);
+    }
+    #endif
+    return ~detail::updateSoftware(UINT32_C(0xffffffff), v, 4);
+#endif
+}
+
+} // namespace crc32c
+
+namespace detail
+{
+template <typename T> [[nodiscard]] inline constexpr size_t foldToSizeT(T v) noexcept
+{
+    if constexpr (sizeof(T) > sizeof(size_t))
+    {
+        return size_t(uint64_t(v) >> 32U) ^ size_t(v);
+    }
+    else
+    {
+        return size_t(v);
+    }
+}
+} // namespace detail
+
+//
+// Hash policies for integer keys: static size_t hash(T key) for any integral T
+//
+
+// wyhash::hash (what the built-in KeyInfo uses), good quality and fast
+struct WyHash
+{
+    template <typename T> [[nodiscard]] static inline size_t hash(T key) noexcept
+    {
+        static_assert(std::is_integral<T>::value, "Integer keys only");
+        if constexpr (sizeof(T) <= 4)
+        {
+            return wyhash::hash(uint32_t(std::make_unsigned_t<T>(key)));
+        }
+        else
+        {
+            return wyhash::hash(uint64_t(key));
+        }
+    }
+};
+
+// CRC32C (32-bit result), one instruction with SSE4.2 / ARMv8 CRC.
+// A bijection for 32-bit keys, but it is linear: keys that only differ in a few high bits may share the low bits.
+struct Crc32cHash
+{
+    template <typename T> [[nodiscard]] static inline size_t hash(T key) noexcept
+    {
+        static_assert(std::is_integral<T>::value, "Integer keys only");
+        if constexpr (sizeof(T) <= 4)
+        {
+            return size_t(crc32c::hash(uint32_t(std::make_unsigned_t<T>(key))));
+        }
+        else
+        {
+            return size_t(crc32c::hash(uint64_t(key)));
+        }
+    }
+};
+
+// murmur3 finalizer, full avalanche (two multiplications)
+struct Fmix64Hash
+{
+    template <typename T> [[nodiscard]] static inline size_t hash(T key) noexcept
+    {
+        static_assert(std::is_integral<T>::value, "Integer keys only");
+        return detail::foldToSizeT(detail::fmix64(uint64_t(std::make_unsigned_t<T>(key))));
+    }
+};
+
+// the key itself, only for keys that are already well distributed hashes (the low bits pick the bucket)
+struct IdentityHash
+{
+    template <typename T> [[nodiscard]] static inline size_t hash(T key) noexcept
+    {
+        static_assert(std::is_integral<T>::value, "Integer keys only");
+        return detail::foldToSizeT(std::make_unsigned_t<T>(key));
+    }
+};
+
+// TBaseKeyInfo with hash() replaced by THashPolicy::hash(), i.e.
+// Excalibur::HashMap<uint64_t, Value, 1, Excalibur::HashPolicyKeyInfo<Excalibur::KeyInfo<uint64_t>, Excalibur::Crc32cHash>> map;
+template <typename TBaseKeyInfo, typename THashPolicy> struct HashPolicyKeyInfo : public TBaseKeyInfo
+{
+    template <typename T> [[nodiscard]] static inline size_t hash(const T& key) noexcept { return THashPolicy::hash(key); }
+};
+
+} // namespace Excalibur
+
+#undef EXLBR_TARGET_SSE42
@@ -0,0 +1,522 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+
+namespace Excalibur
+{
+
+namespace detail
+{
+template <typename TKey, typename TValue, unsigned kNumInlineItems, typename TKeyInfo, typename TProbing, typename TAllocator, typename TShrinkPolicy>
+struct IncrementalAccess<HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>>
+{
+    using TTable = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
+    using TItem = typename TTable::TItem;
+
+    static_assert(std::is_same<TProbing, LinearProbing>::value, "Items are erased from the previous array by writing tombstones");
+
+    [[nodiscard]] static inline TItem* allocateItems(TTable& table, uint32_t numBuckets) noexcept
+    {
+        void* raw = table.getAllocatorRef().allocate(TTable::getStorageSize(numBuckets), TTable::k_StorageAlignment);
+        EXLBR_ASSERT(raw);
+        return reinterpret_cast<TItem*>(raw);
+    }
+
+    static inline void initializeItems(TItem* items, uint32_t numItems) { TTable::initializeItems(items, numItems); }
+
+    // 'numInitialized' items at the beginning were initialized (and are still empty)
+    static inline void freeItems(TTable& table, TItem* items, uint32_t numBuckets, uint32_t numInitialized) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<TItem>::value)
+        {
+            for (uint32_t i = 0; i < numInitialized; i++)
+            {
+                TTable::destruct(items + i);
+            }
+        }
+        table.freeStorage(items, numBuckets);
+    }
+
+    // replaces the storage of an empty table with fully initialized items
+    static inline void adoptItems(TTable& table, TItem* items, uint32_t numBuckets) noexcept
+    {
+        EXLBR_ASSERT(table.empty());
+        table.destroyAndFreeMemory();
+        table.m_storage = items;
+        table.m_numBuckets = numBuckets;
+        table.m_numElements = 0;
+        table.m_numTombstones = 0;
+    }
+
+    [[nodiscard]] static inline TItem* getItem(TTable& table, uint32_t bucketIndex) noexcept
+    {
+        EXLBR_ASSERT(bucketIndex < table.m_numBuckets);
+        return table.m_storage + bucketIndex;
+    }
+
+    // nullptr if there is no such key
+    [[nodiscard]] static inline TItem* findItem(const TTable& table, const TKey& key) noexcept
+    {
+        TItem* item = table.findImpl(key);
+        return (item != table.m_storage + table.m_numBuckets) ? item : nullptr;
+    }
+
+    // O(1) erase: always leaves a tombstone (no clean-up of the tombstones around it, no search for the next item)
+    static inline void eraseItem(TTable& table, TItem* item) noexcept
+    {
+        EXLBR_ASSERT(item->isValid());
+        if constexpr (TTable::has_values::value && !std::is_trivially_destructible<TValue>::value)
+        {
+            TTable::destruct(item->value());
+        }
+        *item->key() = TKeyInfo::getTombstone();
+        table.m_numElements--;
+        table.m_numTombstones++;
+    }
+};
+} // namespace detail
+
+/*
+
+Hash table with incremental (amortized) growth.
+
+Once the current bucket array is half full, a new array of twice the size is allocated (but not initialized). Every following
+emplace/erase (and non-const find) initializes the next k_NumInitBucketsPerStep buckets of it, so it is ready by the time the
+current array reaches its growth threshold. Then the current array becomes the 'previous' one and every operation moves the items
+of the next kMigrationStep buckets from the previous array into the new one. Lookups check both arrays until the migration is finished.
+
+No single operation touches more than max(k_NumInitBucketsPerStep, kMigrationStep) buckets for growth. Large allocations don't
+touch the memory, but the cost of the allocation call itself depends on TAllocator.
+Small tables (less than k_MinIncrementalBuckets buckets) grow in one go.
+
+TAllocator and TShrinkPolicy are passed to both inner HashTables. Probing is always linear: items are erased from the previous
+array by writing tombstones and an insert must not move the items it doesn't touch.
+
+*/
+template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, unsigned kMigrationStep = 4,
+          typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+class IncrementalHashTable
+{
+    using TTable = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, LinearProbing, TAllocator, TShrinkPolicy>;
+    using TAccess = detail::IncrementalAccess<TTable>;
+    using TItem = typename TAccess::TItem;
+
+    // The previous array has N buckets and at most 3/4 N items, the new one gets full after another 3/4 N inserts.
+    // Every insert migrates kMigrationStep buckets, so the whole previous array is migrated after N / kMigrationStep inserts.
+    static_assert(kMigrationStep >= 2, "Migration has to outpace insertion, otherwise the new array could fill up before it is finished");
+
+    static inline constexpr uint32_t k_MinIncrementalBuckets = 4096;
+    // 2N buckets to initialize between 1/2 N and 3/4 N items, i.e. in N / 4 inserts (at least 8 buckets per insert)
+    static inline constexpr uint32_t k_NumInitBucketsPerStep = 64;
+
+  public:
+    using IteratorKV = typename TTable::IteratorKV;
+    using ConstIteratorKV = typename TTable::ConstIteratorKV;
+
+    // iterates over the previous array first and then continues with the current one
+    template <typename TIterator> class TChainedIterator : public TIterator
+    {
+      public:
+        TChainedIterator(const IncrementalHashTable* owner, const TIterator& it) noexcept
+            : TIterator(it)
+            , m_owner(owner)
+        {
+            skipPrevious();
+        }
+
+        TChainedIterator& operator++() noexcept
+        {
+            TIterator::operator++();
+            skipPrevious();
+            return *this;
+        }
+
+        TChainedIterator operator++(int) noexcept
+        {
+            TChainedIterator res = *this;
+            ++*this;
+            return res;
+        }
+
+      private:
+        void skipPrevious() noexcept
+        {
+            if (static_cast<const TIterator&>(*this) == m_owner->m_previous.iend())
+            {
+                TIterator::operator=(typename TTable::template TypedIteratorHelper<TIterator>(&m_owner->m_current).begin());
+            }
+        }
+
+        const IncrementalHashTable* m_owner;
+    };
+
+    template <typename TIterator> struct TypedIteratorHelper
+    {
+        const IncrementalHashTable* ht;
+        TypedIteratorHelper(const IncrementalHashTable* _ht)
+            : ht(_ht)
+        {
+        }
+        TChainedIterator<TIterator> begin()
+        {
+            return TChainedIterator<TIterator>(ht, typename TTable::template TypedIteratorHelper<TIterator>(&ht->m_previous).begin());
+        }
+        TChainedIterator<TIterator> end()
+        {
+            return TChainedIterator<TIterator>(ht, typename TTable::template TypedIteratorHelper<TIterator>(&ht->m_current).end());
+        }
+    };
+
+    using Keys = TypedIteratorHelper<typename TTable::IteratorK>;
+    using Values = TypedIteratorHelper<typename TTable::IteratorV>;
+    using Items = TypedIteratorHelper<IteratorKV>;
+    using ConstValues = TypedIteratorHelper<typename TTable::ConstIteratorV>;
+    using ConstItems = TypedIteratorHelper<ConstIteratorKV>;
+
+  private:
+    [[nodiscard]] static inline bool isGrowthRequired(const TTable& table) noexcept
+    {
+        // must match the growth condition of HashTable::emplace
+        const uint32_t numBuckets = table.capacity();
+        const uint32_t numBucketsThreshold = (numBuckets >> 1u) + (numBuckets >> 2u) + 1;
+        return (table.size() + table.getNumTombstones()) >= numBucketsThreshold;
+    }
+
+    [[nodiscard]] static inline bool isPreparationRequired(const TTable& table) noexcept
+    {
+        const uint32_t numBuckets = table.capacity();
+        return numBuckets >= k_MinIncrementalBuckets && (table.size() + table.getNumTombstones()) >= (numBuckets >> 1u);
+    }
+
+    inline void migrateBucket(uint32_t bucketIndex)
+    {
+        TItem* item = TAccess::getItem(m_previous, bucketIndex);
+        if (!item->isValid())
+        {
+            return;
+        }
+
+        TKey& key = *item->key();
+        if constexpr (std::is_same<std::nullptr_t, typename std::remove_reference<TValue>::type>::value)
+        {
+            m_current.emplace(std::move(key));
+        }
+        else
+        {
+            m_current.emplace(std::move(key), std::move(*item->value()));
+        }
+        TAccess::eraseItem(m_previous, item);
+    }
+
+    inline void finishMigrationIfDone()
+    {
+        if (m_previous.empty())
+        {
+            m_previous = TTable(getAllocator());
+            m_migrateBucket = 0;
+        }
+    }
+
+    // allocates the next bucket array, it is initialized later in small steps (see initializeNext)
+    inline void prepareNext()
+    {
+        EXLBR_ASSERT(m_nextItems == nullptr);
+        m_nextNumBuckets = m_current.capacity() * 2;
+        m_nextNumInitialized = 0;
+        m_nextItems = TAccess::allocateItems(m_current, m_nextNumBuckets);
+    }
+
+    inline void initializeNext(uint32_t numBuckets)
+    {
+        EXLBR_ASSERT(m_nextItems != nullptr);
+        numBuckets = std::min(numBuckets, m_nextNumBuckets - m_nextNumInitialized);
+        TAccess::initializeItems(m_nextItems + m_nextNumInitialized, numBuckets);
+        m_nextNumInitialized += numBuckets;
+    }
+
+    inline void freeNext() noexcept
+    {
+        if (m_nextItems != nullptr)
+        {
+            TAccess::freeItems(m_current, m_nextItems, m_nextNumBuckets, m_nextNumInitialized);
+            m_nextItems = nullptr;
+            m_nextNumBuckets = 0;
+            m_nextNumInitialized = 0;
+        }
+    }
+
+    inline void startMigration()
+    {
+        EXLBR_ASSERT(m_previous.empty());
+        if (m_nextItems != nullptr && m_nextNumBuckets != m_current.capacity() * 2)
+        {
+            freeNext();
+        }
+
+        // fallback: the next array wasn't prepared in time (should not happen, every insert makes progress)
+        if (m_nextItems == nullptr)
+        {
+            prepareNext();
+        }
+        initializeNext(UINT32_MAX);
+
+        m_previous = std::move(m_current);
+        m_current = TTable(m_previous.getAllocator());
+        TAccess::adoptItems(m_current, m_nextItems, m_nextNumBuckets);
+        m_nextItems = nullptr;
+        m_nextNumBuckets = 0;
+        m_nextNumInitialized = 0;
+        m_migrateBucket = 0;
+    }
+
+    // a bounded amount of growth work, called by every modifying operation
+    inline void step()
+    {
+        if (isMigrating())
+        {
+            migrate(kMigrationStep);
+        }
+        else if (m_nextItems != nullptr)
+        {
+            initializeNext(k_NumInitBucketsPerStep);
+        }
+        else if (isPreparationRequired(m_current))
+        {
+            prepareNext();
+        }
+    }
+
+  public:
+    IncrementalHashTable() noexcept = default;
+
+    explicit IncrementalHashTable(const TAllocator& allocator) noexcept
+        : m_current(allocator)
+        , m_previous(allocator)
+    {
+    }
+
+    // note: the next bucket array isn't copied, the copy prepares its own one.
+    // The copy of the previous array might have a different layout, so its migration starts over from the first bucket.
+    IncrementalHashTable(const IncrementalHashTable& other)
+        : m_current(other.m_current)
+        , m_previous(other.m_previous)
+    {
+    }
+
+    IncrementalHashTable(IncrementalHashTable&& other) noexcept
+        : m_current(std::move(other.m_current))
+        , m_previous(std::move(other.m_previous))
+        , m_nextItems(other.m_nextItems)
+        , m_nextNumBuckets(other.m_nextNumBuckets)
+        , m_nextNumInitialized(other.m_nextNumInitialized)
+        , m_migrateBucket(other.m_migrateBucket)
+    {
+        other.m_current = TTable(other.getAllocator());
+        other.m_previous = TTable(other.getAllocator());
+        other.m_nextItems = nullptr;
+        other.m_nextNumBuckets = 0;
+        other.m_nextNumInitialized = 0;
+        other.m_migrateBucket = 0;
+    }
+
+    ~IncrementalHashTable() { freeNext(); }
+
+    IncrementalHashTable& operator=(const IncrementalHashTable& other)
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        freeNext();
+        m_current = other.m_current;
+        m_previous = other.m_previous;
+        m_migrateBucket = 0;
+        return *this;
+    }
+
+    IncrementalHashTable& operator=(IncrementalHashTable&& other) noexcept
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        freeNext();
+        m_current = std::move(other.m_current);
+        m_previous = std::move(other.m_previous);
+        m_nextItems = other.m_nextItems;
+        m_nextNumBuckets = other.m_nextNumBuckets;
+        m_nextNumInitialized = other.m_nextNumInitialized;
+        m_migrateBucket = other.m_migrateBucket;
+        other.m_current = TTable(other.getAllocator());
+        other.m_previous = TTable(other.getAllocator());
+        other.m_nextItems = nullptr;
+        other.m_nextNumBuckets = 0;
+        other.m_nextNumInitialized = 0;
+        other.m_migrateBucket = 0;
+        return *this;
+    }
+
+    // moves the items of up to 'numBuckets' buckets of the previous array, returns true if there is nothing left to migrate
+    inline bool migrate(uint32_t numBuckets)
+    {
+        if (isMigrating())
+        {
+            const uint32_t numBucketsLeft = m_previous.capacity() - m_migrateBucket;
+            const uint32_t endBucket = m_migrateBucket + std::min(numBuckets, numBucketsLeft);
+            for (; m_migrateBucket < endBucket && !m_previous.empty(); m_migrateBucket++)
+            {
+                migrateBucket(m_migrateBucket);
+            }
+            EXLBR_ASSERT(m_migrateBucket < m_previous.capacity() || m_previous.empty());
+            finishMigrationIfDone();
+        }
+        return !isMigrating();
+    }
+
+    inline void finishMigration() { migrate(UINT32_MAX); }
+
+    [[nodiscard]] inline bool isMigrating() const noexcept { return !m_previous.empty(); }
+
+    template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplace(TK&& key, Args&&... args)
+    {
+        if (isMigrating())
+        {
+            // note: no migration here, it could move the item we are about to return
+            IteratorKV it = m_previous.find(key);
+            if (it != m_previous.iend())
+            {
+                return std::make_pair(it, false);
+            }
+        }
+
+        if (isGrowthRequired(m_current) && m_current.capacity() >= k_MinIncrementalBuckets)
+        {
+            // fallback: current array is full before migration is finished (should not happen with kMigrationStep >= 2)
+            finishMigration();
+
+            startMigration();
+            IteratorKV it = m_previous.find(key);
+            if (it != m_previous.iend())
+            {
+                return std::make_pair(it, false);
+            }
+        }
+
+        // Insert first and migrate after: args might point to items of the previous array.
+        // Linear probing never moves existing items, so the returned iterator stays valid.
+        std::pair<IteratorKV, bool> res = m_current.emplace(std::forward<TK>(key), std::forward<Args>(args)...);
+        if (res.second)
+        {
+            step();
+        }
+        return res;
+    }
+
+    [[nodiscard]] inline IteratorKV find(const TKey& key)
+    {
+        step();
+        if (isMigrating())
+        {
+            IteratorKV it = m_previous.find(key);
+            if (it != m_previous.iend())
+            {
+                return it;
+            }
+        }
+        return m_current.find(key);
+    }
+
+    // note: doesn't migrate anything, so it is safe to call from several readers at once
+    [[nodiscard]] inline ConstIteratorKV find(const TKey& key) const noexcept
+    {
+        if (isMigrating())
+        {
+            ConstIteratorKV it = static_cast<const TTable&>(m_previous).find(key);
+            if (it != m_previous.iend())
+            {
+                return it;
+            }
+        }
+        return static_cast<const TTable&>(m_current).find(key);
+    }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept { return find(key) != iend(); }
+
+    inline bool erase(const TKey& key)
+    {
+        step();
+        if (isMigrating())
+        {
+            TItem* item = TAccess::findItem(m_previous, key);
+            if (item != nullptr)
+            {
+                TAccess::eraseItem(m_previous, item);
+                finishMigrationIfDone();
+                return true;
+            }
+        }
+        return m_current.erase(key);
+    }
+
+    inline TValue& operator[](const TKey& key)
+    {
+        std::pair<IteratorKV, bool> emplaceIt = emplace(key);
+        return emplaceIt.first.value();
+    }
+
+    inline void clear()
+    {
+        freeNext();
+        m_previous = TTable(getAllocator());
+        m_migrateBucket = 0;
+        m_current.clear();
+    }
+
+    inline bool reserve(uint32_t numBucketsNew)
+    {
+        finishMigration();
+        freeNext();
+        return m_current.reserve(numBucketsNew);
+    }
+
+    [[nodiscard]] inline uint32_t size() const noexcept { return m_current.size() + m_previous.size(); }
+    [[nodiscard]] inline uint32_t capacity() const noexcept { return m_current.capacity(); }
+    [[nodiscard]] inline bool empty() const noexcept { return m_current.empty() && m_previous.empty(); }
+
+    [[nodiscard]] inline const TAllocator& getAllocator() const noexcept { return m_current.getAllocator(); }
+
+    [[nodiscard]] inline ConstIteratorKV iend() const { return m_current.iend(); }
+    [[nodiscard]] inline IteratorKV iend() { return m_current.iend(); }
+
+    [[nodiscard]] inline TChainedIterator<typename TTable::IteratorK> begin() const { return keys().begin(); }
+    [[nodiscard]] inline TChainedIterator<typename TTable::IteratorK> end() const { return keys().end(); }
+
+    [[nodiscard]] inline Keys keys() const { return Keys(this); }
+    [[nodiscard]] inline ConstValues values() const { return ConstValues(this); }
+    [[nodiscard]] inline ConstItems items() const { return ConstItems(this); }
+
+    [[nodiscard]] inline Values values() { return Values(this); }
+    [[nodiscard]] inline Items items() { return Items(this); }
+
+  private:
+    TTable m_current;
+    TTable m_previous;
+    // next (bigger) bucket array, allocated in advance and initialized up to m_nextNumInitialized
+    TItem* m_nextItems = nullptr;
+    uint32_t m_nextNumBuckets = 0;
+    uint32_t m_nextNumInitialized = 0;
+    // next bucket of the previous array to migrate
+    uint32_t m_migrateBucket = 0;
+};
+
+// hashmap declaration
+template <typename TKey, typename TValue, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator,
+          typename TShrinkPolicy = NoShrink>
+using IncrementalHashMap = IncrementalHashTable<TKey, TValue, kNumInlineItems, TKeyInfo, 4, TAllocator, TShrinkPolicy>;
+
+// hashset declaration
+template <typename TKey, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator,
+          typename TShrinkPolicy = NoShrink>
+using IncrementalHashSet = IncrementalHashTable<TKey, std::nullptr_t, kNumInlineItems, TKeyInfo, 4, TAllocator, TShrinkPolicy>;
+
+} // namespace Excalibur
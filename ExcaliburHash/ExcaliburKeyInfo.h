@@ -1,7 +1,9 @@
 #pragma once
 #ifndef EXLBR_IGNORE_BUILTIN_KEYINFO
 
+    #include <string.h>
     #include <string>
+    #include <string_view>
 
     #include "wyhash.h"
 
@@ -20,6 +22,16 @@ template <typename T> struct KeyInfo
     //    static inline size_t hash(const T& key) noexcept;
     //    static inline bool isEqual(const T& lhs, const T& rhs) noexcept;
     //    static inline bool isValid(const T& key) noexcept;
+    //
+    // optional, used instead of comparing against getEmpty()/getTombstone() results
+    //    static inline bool isEmpty(const T& key) noexcept;
+    //    static inline bool isTombstone(const T& key) noexcept;
+    //
+    // optional, bulk version of hash() used by rehash and the batch operations (out[i] = hash(keys[i]))
+    //    static inline void hashN(const T* keys, size_t* out, size_t numKeys) noexcept;
+    //
+    // optional, seeded version of hash() used by tables with k_SeededHash = true (see SeededKeyInfo)
+    //    static inline size_t hash(const T& key, uint64_t seed) noexcept;
 };
 
 template <> struct KeyInfo<int32_t>
@@ -27,11 +39,15 @@ template <> struct KeyInfo<int32_t>
     static inline bool isValid(const int32_t& key) noexcept { return key < INT32_C(0x7ffffffe); }
     static inline int32_t getTombstone() noexcept { return INT32_C(0x7fffffff); }
     static inline int32_t getEmpty() noexcept { return INT32_C(0x7ffffffe); }
+    static inline bool isTombstone(const int32_t& key) noexcept { return key == INT32_C(0x7fffffff); }
+    static inline bool isEmpty(const int32_t& key) noexcept { return key == INT32_C(0x7ffffffe); }
     #if EXLBR_USE_SIMPLE_HASH
     static inline size_t hash(const int32_t& key) noexcept { return key * 37U; }
     #else
     static inline size_t hash(const int32_t& key) noexcept { return Excalibur::wyhash::hash(key); }
+    static inline void hashN(const int32_t* keys, size_t* out, size_t numKeys) noexcept { Excalibur::wyhash::hashN(keys, out, numKeys); }
     #endif
+    static inline size_t hash(const int32_t& key, uint64_t seed) noexcept { return Excalibur::wyhash::hash(uint64_t(uint32_t(key)), seed); }
     static inline bool isEqual(const int32_t& lhs, const int32_t& rhs) noexcept { return lhs == rhs; }
 };
 
@@ -40,11 +56,15 @@ template <> struct KeyInfo<uint32_t>
     static inline bool isValid(const uint32_t& key) noexcept { return key < UINT32_C(0xfffffffe); }
     static inline uint32_t getTombstone() noexcept { return UINT32_C(0xfffffffe); }
     static inline uint32_t getEmpty() noexcept { return UINT32_C(0xffffffff); }
+    static inline bool isTombstone(const uint32_t& key) noexcept { return key == UINT32_C(0xfffffffe); }
+    static inline bool isEmpty(const uint32_t& key) noexcept { return key == UINT32_C(0xffffffff); }
     #if EXLBR_USE_SIMPLE_HASH
     static inline size_t hash(const uint32_t& key) noexcept { return key * 37U; }
     #else
     static inline size_t hash(const uint32_t& key) noexcept { return Excalibur::wyhash::hash(key); }
+    static inline void hashN(const uint32_t* keys, size_t* out, size_t numKeys) noexcept { Excalibur::wyhash::hashN(keys, out, numKeys); }
     #endif
+    static inline size_t hash(const uint32_t& key, uint64_t seed) noexcept { return Excalibur::wyhash::hash(uint64_t(key), seed); }
     static inline bool isEqual(const uint32_t& lhs, const uint32_t& rhs) noexcept { return lhs == rhs; }
 };
 
@@ -53,11 +73,15 @@ template <> struct KeyInfo<int64_t>
     static inline bool isValid(const int64_t& key) noexcept { return key < INT64_C(0x7ffffffffffffffe); }
     static inline int64_t getTombstone() noexcept { return INT64_C(0x7fffffffffffffff); }
     static inline int64_t getEmpty() noexcept { return INT64_C(0x7ffffffffffffffe); }
+    static inline bool isTombstone(const int64_t& key) noexcept { return key == INT64_C(0x7fffffffffffffff); }
+    static inline bool isEmpty(const int64_t& key) noexcept { return key == INT64_C(0x7ffffffffffffffe); }
     #if EXLBR_USE_SIMPLE_HASH
     static inline size_t hash(const int64_t& key) noexcept { return key * 37ULL; }
     #else
     static inline size_t hash(const int64_t& key) noexcept { return Excalibur::wyhash::hash(key); }
+    static inline void hashN(const int64_t* keys, size_t* out, size_t numKeys) noexcept { Excalibur::wyhash::hashN(keys, out, numKeys); }
     #endif
+    static inline size_t hash(const int64_t& key, uint64_t seed) noexcept { return Excalibur::wyhash::hash(uint64_t(uint64_t(key)), seed); }
     static inline bool isEqual(const int64_t& lhs, const int64_t& rhs) noexcept { return lhs == rhs; }
 };
 
@@ -66,11 +90,15 @@ template <> struct KeyInfo<uint64_t>
     static inline bool isValid(const uint64_t& key) noexcept { return key < UINT64_C(0xfffffffffffffffe); }
     static inline uint64_t getTombstone() noexcept { return UINT64_C(0xfffffffffffffffe); }
     static inline uint64_t getEmpty() noexcept { return UINT64_C(0xffffffffffffffff); }
+    static inline bool isTombstone(const uint64_t& key) noexcept { return key == UINT64_C(0xfffffffffffffffe); }
+    static inline bool isEmpty(const uint64_t& key) noexcept { return key == UINT64_C(0xffffffffffffffff); }
     #if EXLBR_USE_SIMPLE_HASH
     static inline size_t hash(const uint64_t& key) noexcept { return key * 37ULL; }
     #else
     static inline size_t hash(const uint64_t& key) noexcept { return Excalibur::wyhash::hash(key); }
+    static inline void hashN(const uint64_t* keys, size_t* out, size_t numKeys) noexcept { Excalibur::wyhash::hashN(keys, out, numKeys); }
     #endif
+    static inline size_t hash(const uint64_t& key, uint64_t seed) noexcept { return Excalibur::wyhash::hash(uint64_t(key), seed); }
     static inline bool isEqual(const uint64_t& lhs, const uint64_t& rhs) noexcept { return lhs == rhs; }
 };
 
@@ -83,8 +111,56 @@ template <> struct KeyInfo<std::string>
         return std::string(1, char(1));
     }
     static inline std::string getEmpty() noexcept { return std::string(); }
-    static inline size_t hash(const std::string& key) noexcept { return std::hash<std::string>{}(key); }
+    static inline bool isTombstone(const std::string& key) noexcept { return key.size() == 1 && key[0] == char(1); }
+    static inline bool isEmpty(const std::string& key) noexcept { return key.empty(); }
+    static inline size_t hash(const std::string& key) noexcept { return Excalibur::wyhash::hashBytes(key.data(), key.size()); }
+    static inline size_t hash(const std::string& key, uint64_t seed) noexcept
+    {
+        return Excalibur::wyhash::hashBytes(key.data(), key.size(), seed);
+    }
     static inline bool isEqual(const std::string& lhs, const std::string& rhs) noexcept { return lhs == rhs; }
+
+    // std::string_view and const char* lookups don't construct a temporary std::string
+    using is_transparent = void;
+    static inline size_t hash(std::string_view key) noexcept { return Excalibur::wyhash::hashBytes(key.data(), key.size()); }
+    static inline size_t hash(const char* key) noexcept { return hash(std::string_view(key)); }
+    static inline size_t hash(std::string_view key, uint64_t seed) noexcept { return Excalibur::wyhash::hashBytes(key.data(), key.size(), seed); }
+    static inline size_t hash(const char* key, uint64_t seed) noexcept { return hash(std::string_view(key), seed); }
+    static inline bool isEqual(std::string_view lhs, const std::string& rhs) noexcept { return lhs == rhs; }
+    static inline bool isEqual(const char* lhs, const std::string& rhs) noexcept { return rhs == lhs; }
+};
+
+// non-owning keys: the referenced characters have to outlive the table, the same sentinels as KeyInfo<std::string>
+template <> struct KeyInfo<std::string_view>
+{
+    static inline bool isValid(const std::string_view& key) noexcept { return !key.empty() && key[0] != char(1); }
+    static inline std::string_view getTombstone() noexcept { return std::string_view("\1", 1); }
+    static inline std::string_view getEmpty() noexcept { return std::string_view(); }
+    static inline bool isTombstone(const std::string_view& key) noexcept { return key.size() == 1 && key[0] == char(1); }
+    static inline bool isEmpty(const std::string_view& key) noexcept { return key.empty(); }
+    static inline size_t hash(const std::string_view& key) noexcept { return Excalibur::wyhash::hashBytes(key.data(), key.size()); }
+    static inline size_t hash(const std::string_view& key, uint64_t seed) noexcept
+    {
+        return Excalibur::wyhash::hashBytes(key.data(), key.size(), seed);
+    }
+    static inline bool isEqual(const std::string_view& lhs, const std::string_view& rhs) noexcept { return lhs == rhs; }
+};
+
+// null-terminated strings compared by content (not by address), nullptr is the empty key
+template <> struct KeyInfo<const char*>
+{
+    static inline bool isValid(const char* const& key) noexcept { return key != nullptr && key[0] != char(1); }
+    static inline const char* getTombstone() noexcept { return "\1"; }
+    static inline const char* getEmpty() noexcept { return nullptr; }
+    static inline bool isTombstone(const char* const& key) noexcept { return key != nullptr && key[0] == char(1) && key[1] == 0; }
+    static inline bool isEmpty(const char* const& key) noexcept { return key == nullptr; }
+    static inline size_t hash(const char* const& key) noexcept { return Excalibur::wyhash::hashBytes(key, strlen(key)); }
+    static inline size_t hash(const char* const& key, uint64_t seed) noexcept { return Excalibur::wyhash::hashBytes(key, strlen(key), seed); }
+    static inline bool isEqual(const char* const& lhs, const char* const& rhs) noexcept
+    {
+        // probing compares against empty slots too
+        return (lhs == rhs) || (lhs != nullptr && rhs != nullptr && strcmp(lhs, rhs) == 0);
+    }
 };
 
 } // namespace Excalibur
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <mutex>
+#include <utility>
+
+namespace Excalibur
+{
+
+/*
+
+Sharded hash table for multi-core write scaling.
+
+The top bits of the key hash select one of kNumShards independent HashTables, each one guarded by its own lock
+and padded to its own cache line. Writers that hit different shards never touch the same memory, and every shard
+grows on its own, so a resize only blocks the threads working with that shard.
+
+HashTable uses the low bits of the same hash to select a bucket, so the shard selection doesn't degrade the bucket distribution.
+
+Lookups copy the value out (or call a visitor under the shard lock), iterators would outlive the lock.
+items()/keys()/values() iterate over all shards without locking, use them only when no other thread is modifying the map
+(or use forEach which locks one shard at a time).
+
+TProbing, TAllocator and TShrinkPolicy are passed to every shard, a stateful allocator is copied into each of them.
+
+*/
+template <typename TKey, typename TValue, unsigned kNumShards = 16, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>,
+          typename TProbing = LinearProbing, typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+class ShardedHashTable
+{
+    static_assert(kNumShards > 0 && (kNumShards & (kNumShards - 1)) == 0, "Number of shards must be a power of two");
+
+    using TTable = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
+
+    struct alignas(64) Shard
+    {
+        Shard() = default;
+        explicit Shard(const TAllocator& allocator)
+            : table(allocator)
+        {
+        }
+
+        mutable std::mutex lock;
+        TTable table;
+    };
+
+    template <size_t... kIndices>
+    ShardedHashTable(const TAllocator& allocator, std::index_sequence<kIndices...>)
+        : m_shards{((void)kIndices, Shard(allocator))...}
+    {
+    }
+
+    [[nodiscard]] static inline constexpr unsigned log2(unsigned v) noexcept { return (v <= 1) ? 0 : 1 + log2(v >> 1); }
+    static inline constexpr unsigned k_ShardBits = log2(kNumShards);
+
+  public:
+    using IteratorKV = typename TTable::IteratorKV;
+    using ConstIteratorKV = typename TTable::ConstIteratorKV;
+
+    // iterates over all the shards one after another
+    template <typename TIterator> class TShardedIterator : public TIterator
+    {
+      public:
+        TShardedIterator(const ShardedHashTable* owner, uint32_t shardIndex, const TIterator& it) noexcept
+            : TIterator(it)
+            , m_owner(owner)
+            , m_shardIndex(shardIndex)
+        {
+            skipEmptyShards();
+        }
+
+        TShardedIterator& operator++() noexcept
+        {
+            TIterator::operator++();
+            skipEmptyShards();
+            return *this;
+        }
+
+        TShardedIterator operator++(int) noexcept
+        {
+            TShardedIterator res = *this;
+            ++*this;
+            return res;
+        }
+
+      private:
+        void skipEmptyShards() noexcept
+        {
+            while (m_shardIndex < (kNumShards - 1) && static_cast<const TIterator&>(*this) == m_owner->m_shards[m_shardIndex].table.iend())
+            {
+                m_shardIndex++;
+                TIterator::operator=(typename TTable::template TypedIteratorHelper<TIterator>(&m_owner->m_shards[m_shardIndex].table).begin());
+            }
+        }
+
+        const ShardedHashTable* m_owner;
+        uint32_t m_shardIndex;
+    };
+
+    template <typename TIterator> struct TypedIteratorHelper
+    {
+        const ShardedHashTable* ht;
+        TypedIteratorHelper(const ShardedHashTable* _ht)
+            : ht(_ht)
+        {
+        }
+        TShardedIterator<TIterator> begin()
+        {
+            return TShardedIterator<TIterator>(ht, 0, typename TTable::template TypedIteratorHelper<TIterator>(&ht->m_shards[0].table).begin());
+        }
+        TShardedIterator<TIterator> end()
+        {
+            return TShardedIterator<TIterator>(ht, kNumShards - 1,
+                                               typename TTable::template TypedIteratorHelper<TIterator>(&ht->m_shards[kNumShards - 1].table).end());
+        }
+    };
+
+    using Keys = TypedIteratorHelper<typename TTable::IteratorK>;
+    using Values = TypedIteratorHelper<typename TTable::IteratorV>;
+    using Items = TypedIteratorHelper<IteratorKV>;
+    using ConstValues = TypedIteratorHelper<typename TTable::ConstIteratorV>;
+    using ConstItems = TypedIteratorHelper<ConstIteratorKV>;
+
+    ShardedHashTable() = default;
+
+    explicit ShardedHashTable(const TAllocator& allocator)
+        : ShardedHashTable(allocator, std::make_index_sequence<kNumShards>())
+    {
+    }
+
+    ShardedHashTable(const ShardedHashTable&) = delete;
+    ShardedHashTable& operator=(const ShardedHashTable&) = delete;
+
+    [[nodiscard]] static inline uint32_t getShardIndex(const TKey& key) noexcept
+    {
+        if constexpr (k_ShardBits == 0)
+        {
+            return 0;
+        }
+        else
+        {
+            const size_t hashValue = TKeyInfo::hash(key);
+            return uint32_t(hashValue >> (sizeof(size_t) * 8 - k_ShardBits));
+        }
+    }
+
+    [[nodiscard]] static inline constexpr uint32_t getNumShards() noexcept { return kNumShards; }
+
+    // returns true if the item was inserted, false if the key already exists
+    template <typename TK, class... Args> inline bool emplace(TK&& key, Args&&... args)
+    {
+        Shard& shard = m_shards[getShardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.emplace(std::forward<TK>(key), std::forward<Args>(args)...).second;
+    }
+
+    // copies the value into 'outValue' if the key exists
+    [[nodiscard]] inline bool find(const TKey& key, TValue& outValue) const
+    {
+        const Shard& shard = m_shards[getShardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        ConstIteratorKV it = shard.table.find(key);
+        if (it == shard.table.iend())
+        {
+            return false;
+        }
+        outValue = it.value();
+        return true;
+    }
+
+    // calls func(value) under the shard lock if the key exists
+    template <typename TFunc> inline bool visit(const TKey& key, TFunc&& func)
+    {
+        Shard& shard = m_shards[getShardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        IteratorKV it = shard.table.find(key);
+        if (it == shard.table.iend())
+        {
+            return false;
+        }
+        func(it.value());
+        return true;
+    }
+
+    [[nodiscard]] inline bool has(const TKey& key) const
+    {
+        const Shard& shard = m_shards[getShardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.has(key);
+    }
+
+    inline bool erase(const TKey& key)
+    {
+        Shard& shard = m_shards[getShardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.erase(key);
+    }
+
+    // calls func(key, value) for every item, locks one shard at a time
+    template <typename TFunc> inline void forEach(TFunc&& func)
+    {
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            for (auto it = shard.table.ibegin(); it != shard.table.iend(); ++it)
+            {
+                func(it.key(), it.value());
+            }
+        }
+    }
+
+    inline void clear()
+    {
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            shard.table.clear();
+        }
+    }
+
+    inline bool reserve(uint32_t shardIndex, uint32_t numBucketsNew)
+    {
+        EXLBR_ASSERT(shardIndex < kNumShards);
+        Shard& shard = m_shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.reserve(numBucketsNew);
+    }
+
+    // reserves 'numBucketsPerShard' in every shard
+    inline bool reserve(uint32_t numBucketsPerShard)
+    {
+        bool res = false;
+        for (uint32_t i = 0; i < kNumShards; i++)
+        {
+            res |= reserve(i, numBucketsPerShard);
+        }
+        return res;
+    }
+
+    // note: not a snapshot, shards are summed up one by one
+    [[nodiscard]] inline uint32_t size() const
+    {
+        uint32_t res = 0;
+        for (const Shard& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            res += shard.table.size();
+        }
+        return res;
+    }
+
+    [[nodiscard]] inline bool empty() const { return size() == 0; }
+
+    [[nodiscard]] inline const TAllocator& getAllocator(uint32_t shardIndex) const noexcept
+    {
+        EXLBR_ASSERT(shardIndex < kNumShards);
+        return m_shards[shardIndex].table.getAllocator();
+    }
+
+    [[nodiscard]] inline uint32_t getShardSize(uint32_t shardIndex) const
+    {
+        EXLBR_ASSERT(shardIndex < kNumShards);
+        const Shard& shard = m_shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.size();
+    }
+
+    [[nodiscard]] inline uint32_t getShardCapacity(uint32_t shardIndex) const
+    {
+        EXLBR_ASSERT(shardIndex < kNumShards);
+        const Shard& shard = m_shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        return shard.table.capacity();
+    }
+
+    [[nodiscard]] inline TShardedIterator<typename TTable::IteratorK> begin() const { return keys().begin(); }
+    [[nodiscard]] inline TShardedIterator<typename TTable::IteratorK> end() const { return keys().end(); }
+
+    [[nodiscard]] inline Keys keys() const { return Keys(this); }
+    [[nodiscard]] inline ConstValues values() const { return ConstValues(this); }
+    [[nodiscard]] inline ConstItems items() const { return ConstItems(this); }
+
+    [[nodiscard]] inline Values values() { return Values(this); }
+    [[nodiscard]] inline Items items() { return Items(this); }
+
+  private:
+    Shard m_shards[kNumShards];
+};
+
+// hashmap declaration
+template <typename TKey, typename TValue, unsigned kNumShards = 16, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>,
+          typename TProbing = LinearProbing, typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+using ShardedHashMap = ShardedHashTable<TKey, TValue, kNumShards, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
+
+// hashset declaration
+template <typename TKey, unsigned kNumShards = 16, unsigned kNumInlineItems = 1, typename TKeyInfo = KeyInfo<TKey>,
+          typename TProbing = LinearProbing, typename TAllocator = DefaultAllocator, typename TShrinkPolicy = NoShrink>
+using ShardedHashSet = ShardedHashTable<TKey, std::nullptr_t, kNumShards, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
+
+} // namespace Excalibur
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "wyhash.h"
+
+// Runtime CPU dispatch for the bulk paths of HashTable (see SimdLevel).
+// Kernels for every instruction set are compiled into the same binary using per-function target attributes,
+// the best one supported by the CPU is picked once on first use. Define EXLBR_DISABLE_SIMD_DISPATCH to only use scalar code.
+
+#if !defined(EXLBR_DISABLE_SIMD_DISPATCH)
+    #if defined(__x86_64__) || defined(_M_X64)
+        #define EXLBR_SIMD_X86 (1)
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define EXLBR_SIMD_NEON (1)
+    #endif
+#endif
+
+#if defined(EXLBR_SIMD_X86)
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+    #if defined(__GNUC__) || defined(__clang__)
+        #define EXLBR_TARGET_AVX2 __attribute__((target("avx2")))
+        #define EXLBR_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+    #else
+        #define EXLBR_TARGET_AVX2
+        #define EXLBR_TARGET_AVX512
+    #endif
+#elif defined(EXLBR_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace Excalibur
+{
+
+enum class SimdLevel : uint8_t
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+namespace detail
+{
+
+// One set of bulk kernels per instruction set.
+// Items are 'itemSize' bytes apart (a power of two, 4..64). Keys are 4 or 8 byte integers stored at the start of an item,
+// 'emptyKey'/'tombstoneKey' are their zero-extended values.
+struct SimdKernels
+{
+    SimdLevel level;
+
+    // writes 'numItems' copies of 'item'
+    void (*fillItems)(void* dst, size_t numItems, const void* item, size_t itemSize);
+
+    // index of the first item whose key is neither empty nor tombstone (numItems if there is none)
+    size_t (*findValidKey)(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey, uint64_t tombstoneKey);
+
+    // out[i] = wyhash::hash(keys[i]) for 'numKeys' contiguous 4 or 8 byte keys (bit-identical to the scalar version)
+    void (*hashKeys)(const void* keys, size_t numKeys, size_t keySize, size_t* out);
+};
+
+[[nodiscard]] inline uint32_t countTrailingZeros64(uint64_t v) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return uint32_t(index);
+#else
+    return uint32_t(__builtin_ctzll(v));
+#endif
+}
+
+[[nodiscard]] inline uint64_t loadKey(const uint8_t* ptr, size_t keySize) noexcept
+{
+    if (keySize == 4)
+    {
+        uint32_t key;
+        memcpy(&key, ptr, sizeof(key));
+        return key;
+    }
+    uint64_t key;
+    memcpy(&key, ptr, sizeof(key));
+    return key;
+}
+
+inline void storeKey(uint8_t* ptr, size_t keySize, uint64_t key) noexcept
+{
+    if (keySize == 4)
+    {
+        const uint32_t key32 = uint32_t(key);
+        memcpy(ptr, &key32, sizeof(key32));
+        return;
+    }
+    memcpy(ptr, &key, sizeof(key));
+}
+
+// 64 bytes = one cache line worth of items, the SIMD kernels process one block per iteration
+static constexpr size_t kSimdBlockSize = 64;
+
+inline void makeItemBlock(uint8_t* block, const void* item, size_t itemSize) noexcept
+{
+    for (size_t offset = 0; offset < kSimdBlockSize; offset += itemSize)
+    {
+        memcpy(block + offset, item, itemSize);
+    }
+}
+
+// one bit at the first byte of every item (indexed by log2 of the item size)
+static constexpr uint64_t kItemStartMasks[7] = {0xffffffffffffffffull, 0x5555555555555555ull, 0x1111111111111111ull, 0x0101010101010101ull,
+                                                0x0001000100010001ull, 0x0000000100000001ull, 0x0000000000000001ull};
+
+// byte equality mask -> bit N is set if all 'keySize' bytes starting at N are equal
+[[nodiscard]] inline uint64_t matchKeys(uint64_t byteMask, size_t keySize) noexcept
+{
+    uint64_t mask = byteMask & (byteMask >> 1);
+    mask &= mask >> 2;
+    return (keySize == 8) ? (mask & (mask >> 4)) : mask;
+}
+
+
+// Scalar
+
+inline void fillItemsScalar(void* dst, size_t numItems, const void* item, size_t itemSize)
+{
+    uint8_t* ptr = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < numItems; i++, ptr += itemSize)
+    {
+        memcpy(ptr, item, itemSize);
+    }
+}
+
+inline size_t findValidKeyScalar(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey,
+                                 uint64_t tombstoneKey)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(items);
+    for (size_t i = 0; i < numItems; i++, ptr += itemSize)
+    {
+        const uint64_t key = loadKey(ptr, keySize);
+        if (key != emptyKey && key != tombstoneKey)
+        {
+            return i;
+        }
+    }
+    return numItems;
+}
+
+inline void hashKeysScalar(const void* keys, size_t numKeys, size_t keySize, size_t* out)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(keys);
+    for (size_t i = 0; i < numKeys; i++, ptr += keySize)
+    {
+        out[i] = wyhash::hash(loadKey(ptr, keySize));
+    }
+}
+
+inline constexpr SimdKernels kSimdKernelsScalar = {SimdLevel::Scalar, fillItemsScalar, findValidKeyScalar, hashKeysScalar};
+
+// All kernels process whole blocks first and hand the tail over to the scalar version.
+// Macros rather than templates: intrinsics only inline into functions that carry the matching target attribute.
+#define EXLBR_SIMD_FILL_ITEMS(storeBlock)                                                                                                  \
+    uint8_t* ptr = static_cast<uint8_t*>(dst);                                                                                             \
+    const size_t itemsPerBlock = kSimdBlockSize >> countTrailingZeros64(itemSize);                                                         \
+    size_t index = 0;                                                                                                                      \
+    alignas(64) uint8_t block[kSimdBlockSize];                                                                                             \
+    makeItemBlock(block, item, itemSize);                                                                                                  \
+    for (; index + itemsPerBlock <= numItems; index += itemsPerBlock)                                                                      \
+    {                                                                                                                                      \
+        uint8_t* p = ptr + index * itemSize;                                                                                               \
+        storeBlock;                                                                                                                        \
+    }                                                                                                                                      \
+    fillItemsScalar(ptr + index * itemSize, numItems - index, item, itemSize)
+
+#define EXLBR_SIMD_FIND_VALID_KEY(TVector, broadcastKey, matchBytes)                                                                       \
+    /* keys start at multiples of keySize, so every keySize lane of a block is compared with a broadcast key */                            \
+    /* empty/tombstone keys that differ in a single bit (all the built-in KeyInfos) take one compare: (key | bit) == (empty | bit) */      \
+    const uint8_t* ptr = static_cast<const uint8_t*>(items);                                                                               \
+    const uint32_t itemShift = countTrailingZeros64(itemSize);                                                                             \
+    const size_t itemsPerBlock = kSimdBlockSize >> itemShift;                                                                              \
+    const uint64_t itemStartMask = kItemStartMasks[itemShift];                                                                             \
+    const uint64_t keyDiff = emptyKey ^ tombstoneKey;                                                                                      \
+    const uint64_t orBits = ((keyDiff & (keyDiff - 1)) == 0) ? keyDiff : 0;                                                                \
+    const TVector orPattern = broadcastKey(orBits, keySize);                                                                               \
+    const TVector emptyPattern = broadcastKey(emptyKey | orBits, keySize);                                                                 \
+    const TVector zeroPattern = broadcastKey(0, keySize);                                                                                  \
+    const TVector tombstonePattern = broadcastKey(tombstoneKey, keySize);                                                                  \
+    size_t index = 0;                                                                                                                      \
+    for (; index + itemsPerBlock <= numItems; index += itemsPerBlock)                                                                      \
+    {                                                                                                                                      \
+        const uint8_t* p = ptr + index * itemSize;                                                                                         \
+        uint64_t invalid = matchKeys(matchBytes(p, orPattern, emptyPattern), keySize);                                                     \
+        if (orBits == 0)                                                                                                                   \
+        {                                                                                                                                  \
+            invalid |= matchKeys(matchBytes(p, zeroPattern, tombstonePattern), keySize);                                                   \
+        }                                                                                                                                  \
+        const uint64_t valid = itemStartMask & ~invalid;                                                                                   \
+        if (valid != 0)                                                                                                                    \
+        {                                                                                                                                  \
+            return index + (countTrailingZeros64(valid) >> itemShift);                                                                     \
+        }                                                                                                                                  \
+    }                                                                                                                                      \
+    return index + findValidKeyScalar(ptr + index * itemSize, numItems - index, itemSize, keySize, emptyKey, tombstoneKey)
+
+#if defined(EXLBR_SIMD_X86)
+
+// SSE2 (x86-64 baseline)
+
+[[nodiscard]] inline __m128i broadcastKeySSE2(uint64_t key, size_t keySize) noexcept
+{
+    return (keySize == 8) ? _mm_set1_epi64x(int64_t(key)) : _mm_set1_epi32(int32_t(uint32_t(key)));
+}
+
+// byte equality mask of (block | orPattern) and pattern
+[[nodiscard]] inline uint64_t matchBytesSSE2(const uint8_t* p, __m128i orPattern, __m128i pattern) noexcept
+{
+    const __m128i a0 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), orPattern);
+    const __m128i a1 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), orPattern);
+    const __m128i a2 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), orPattern);
+    const __m128i a3 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), orPattern);
+    const uint64_t m0 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a0, pattern)));
+    const uint64_t m1 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a1, pattern)));
+    const uint64_t m2 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a2, pattern)));
+    const uint64_t m3 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a3, pattern)));
+    return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+}
+
+inline void fillItemsSSE2(void* dst, size_t numItems, const void* item, size_t itemSize)
+{
+    EXLBR_SIMD_FILL_ITEMS({
+        for (size_t i = 0; i < kSimdBlockSize; i += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), _mm_load_si128(reinterpret_cast<const __m128i*>(block + i)));
+        }
+    });
+}
+
+inline size_t findValidKeySSE2(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey,
+                               uint64_t tombstoneKey)
+{
+    EXLBR_SIMD_FIND_VALID_KEY(__m128i, broadcastKeySSE2, matchBytesSSE2);
+}
+
+// two lanes don't beat the scalar 64x64->128 multiply, hashing stays scalar
+inline constexpr SimdKernels kSimdKernelsSSE2 = {SimdLevel::SSE2, fillItemsSSE2, findValidKeySSE2, hashKeysScalar};
+
+// AVX2
+
+[[nodiscard]] EXLBR_TARGET_AVX2 inline __m256i broadcastKeyAVX2(uint64_t key, size_t keySize) noexcept
+{
+    return (keySize == 8) ? _mm256_set1_epi64x(int64_t(key)) : _mm256_set1_epi32(int32_t(uint32_t(key)));
+}
+
+[[nodiscard]] EXLBR_TARGET_AVX2 inline uint64_t matchBytesAVX2(const uint8_t* p, __m256i orPattern, __m256i pattern) noexcept
+{
+    const __m256i a0 = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), orPattern);
+    const __m256i a1 = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), orPattern);
+    const uint32_t lo = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a0, pattern)));
+    const uint32_t hi = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a1, pattern)));
+    return uint64_t(lo) | (uint64_t(hi) << 32);
+}
+
+EXLBR_TARGET_AVX2 inline void fillItemsAVX2(void* dst, size_t numItems, const void* item, size_t itemSize)
+{
+    EXLBR_SIMD_FILL_ITEMS({
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_load_si256(reinterpret_cast<const __m256i*>(block)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 32), _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 32)));
+    });
+}
+
+EXLBR_TARGET_AVX2 inline size_t findValidKeyAVX2(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey,
+                                                 uint64_t tombstoneKey)
+{
+    EXLBR_SIMD_FIND_VALID_KEY(__m256i, broadcastKeyAVX2, matchBytesAVX2);
+}
+
+// wyhash mix (lo ^ hi of v * 0x9E3779B97F4A7C15) per 64-bit lane, there is no 64x64->128 vector multiply,
+// so the product is assembled from four 32x32->64 multiplies. Dword shuffles instead of 64-bit shifts where possible,
+// they don't compete with the multiplies for the same execution ports.
+[[nodiscard]] EXLBR_TARGET_AVX2 inline __m256i wyhashMixAVX2(__m256i v) noexcept
+{
+    const __m256i kMulLo = _mm256_set1_epi64x(int64_t(0x7F4A7C15));
+    const __m256i kMulHi = _mm256_set1_epi64x(int64_t(0x9E3779B9));
+    const __m256i kLow32 = _mm256_set1_epi64x(int64_t(0xffffffff));
+    const __m256i vHi = _mm256_shuffle_epi32(v, 0xf5);
+    const __m256i ll = _mm256_mul_epu32(v, kMulLo);
+    const __m256i lh = _mm256_mul_epu32(v, kMulHi);
+    const __m256i hl = _mm256_mul_epu32(vHi, kMulLo);
+    const __m256i hh = _mm256_mul_epu32(vHi, kMulHi);
+    const __m256i mid =
+        _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(lh, kLow32)), _mm256_and_si256(hl, kLow32));
+    // lo = low half of ll | mid << 32
+    const __m256i lo = _mm256_blend_epi32(ll, _mm256_shuffle_epi32(mid, 0xa0), 0xaa);
+    const __m256i hi = _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32)),
+                                        _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(mid, 32)));
+    return _mm256_xor_si256(lo, hi);
+}
+
+EXLBR_TARGET_AVX2 inline void hashKeysAVX2(const void* keys, size_t numKeys, size_t keySize, size_t* out)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(keys);
+    size_t index = 0;
+    for (; index + 4 <= numKeys; index += 4)
+    {
+        const uint8_t* p = ptr + index * keySize;
+        const __m256i v = (keySize == 8) ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+                                         : _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + index), wyhashMixAVX2(v));
+    }
+    hashKeysScalar(ptr + index * keySize, numKeys - index, keySize, out + index);
+}
+
+inline constexpr SimdKernels kSimdKernelsAVX2 = {SimdLevel::AVX2, fillItemsAVX2, findValidKeyAVX2, hashKeysAVX2};
+
+// AVX-512 (F + BW)
+
+[[nodiscard]] EXLBR_TARGET_AVX512 inline __m512i broadcastKeyAVX512(uint64_t key, size_t keySize) noexcept
+{
+    return (keySize == 8) ? _mm512_set1_epi64(int64_t(key)) : _mm512_set1_epi32(int32_t(uint32_t(key)));
+}
+
+[[nodiscard]] EXLBR_TARGET_AVX512 inline uint64_t matchBytesAVX512(const uint8_t* p, __m512i orPattern, __m512i pattern) noexcept
+{
+    return uint64_t(_mm512_cmpeq_epi8_mask(_mm512_or_si512(_mm512_loadu_si512(p), orPattern), pattern));
+}
+
+EXLBR_TARGET_AVX512 inline void fillItemsAVX512(void* dst, size_t numItems, const void* item, size_t itemSize)
+{
+    EXLBR_SIMD_FILL_ITEMS(_mm512_storeu_si512(p, _mm512_load_si512(block)));
+}
+
+EXLBR_TARGET_AVX512 inline size_t findValidKeyAVX512(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey,
+                                                     uint64_t tombstoneKey)
+{
+    EXLBR_SIMD_FIND_VALID_KEY(__m512i, broadcastKeyAVX512, matchBytesAVX512);
+}
+
+// same as wyhashMixAVX2, a masked dword shuffle also does the 64-bit shifts (x >> 32 keeps the odd dwords in the even ones).
+// Zero-masking forms only: GCC warns about the _mm512_undefined_epi32() of the unmasked ones (maybe-uninitialized).
+[[nodiscard]] EXLBR_TARGET_AVX512 inline __m512i wyhashShiftRight32AVX512(__m512i v) noexcept
+{
+    return _mm512_maskz_shuffle_epi32(__mmask16(0x5555), v, _MM_PERM_DDBB);
+}
+
+[[nodiscard]] EXLBR_TARGET_AVX512 inline __m512i wyhashMixAVX512(__m512i v) noexcept
+{
+    const __mmask8 all = 0xff;
+    const __m512i kMulLo = _mm512_set1_epi64(int64_t(0x7F4A7C15));
+    const __m512i kMulHi = _mm512_set1_epi64(int64_t(0x9E3779B9));
+    const __m512i kLow32 = _mm512_set1_epi64(int64_t(0xffffffff));
+    const __m512i vHi = _mm512_maskz_shuffle_epi32(__mmask16(0xffff), v, _MM_PERM_DDBB);
+    const __m512i ll = _mm512_maskz_mul_epu32(all, v, kMulLo);
+    const __m512i lh = _mm512_maskz_mul_epu32(all, v, kMulHi);
+    const __m512i hl = _mm512_maskz_mul_epu32(all, vHi, kMulLo);
+    const __m512i hh = _mm512_maskz_mul_epu32(all, vHi, kMulHi);
+    const __m512i mid =
+        _mm512_add_epi64(_mm512_add_epi64(wyhashShiftRight32AVX512(ll), _mm512_and_si512(lh, kLow32)), _mm512_and_si512(hl, kLow32));
+    // lo = low half of ll | mid << 32
+    const __m512i lo = _mm512_mask_shuffle_epi32(ll, __mmask16(0xaaaa), mid, _MM_PERM_CCAA);
+    const __m512i hi = _mm512_add_epi64(_mm512_add_epi64(hh, wyhashShiftRight32AVX512(lh)),
+                                        _mm512_add_epi64(wyhashShiftRight32AVX512(hl), wyhashShiftRight32AVX512(mid)));
+    return _mm512_xor_si512(lo, hi);
+}
+
+EXLBR_TARGET_AVX512 inline void hashKeysAVX512(const void* keys, size_t numKeys, size_t keySize, size_t* out)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(keys);
+    size_t index = 0;
+    for (; index + 8 <= numKeys; index += 8)
+    {
+        const uint8_t* p = ptr + index * keySize;
+        const __m512i v = (keySize == 8) ? _mm512_loadu_si512(p)
+                                         : _mm512_maskz_cvtepu32_epi64(0xff, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        _mm512_storeu_si512(out + index, wyhashMixAVX512(v));
+    }
+    hashKeysScalar(ptr + index * keySize, numKeys - index, keySize, out + index);
+}
+
+inline constexpr SimdKernels kSimdKernelsAVX512 = {SimdLevel::AVX512, fillItemsAVX512, findValidKeyAVX512, hashKeysAVX512};
+
+#elif defined(EXLBR_SIMD_NEON)
+
+// NEON (AArch64 baseline)
+
+[[nodiscard]] inline uint8x16_t broadcastKeyNEON(uint64_t key, size_t keySize) noexcept
+{
+    return (keySize == 8) ? vreinterpretq_u8_u64(vdupq_n_u64(key)) : vreinterpretq_u8_u32(vdupq_n_u32(uint32_t(key)));
+}
+
+[[nodiscard]] inline uint64_t matchBytesNEON(const uint8_t* p, uint8x16_t orPattern, uint8x16_t pattern) noexcept
+{
+    static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bitValues = vld1q_u8(kBits);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < kSimdBlockSize; i += 16)
+    {
+        const uint8x16_t bits = vandq_u8(vceqq_u8(vorrq_u8(vld1q_u8(p + i), orPattern), pattern), bitValues);
+        const uint64_t mask16 = uint64_t(vaddv_u8(vget_low_u8(bits))) | (uint64_t(vaddv_u8(vget_high_u8(bits))) << 8u);
+        mask |= mask16 << i;
+    }
+    return mask;
+}
+
+inline void fillItemsNEON(void* dst, size_t numItems, const void* item, size_t itemSize)
+{
+    EXLBR_SIMD_FILL_ITEMS({
+        for (size_t i = 0; i < kSimdBlockSize; i += 16)
+        {
+            vst1q_u8(p + i, vld1q_u8(block + i));
+        }
+    });
+}
+
+inline size_t findValidKeyNEON(const void* items, size_t numItems, size_t itemSize, size_t keySize, uint64_t emptyKey,
+                               uint64_t tombstoneKey)
+{
+    EXLBR_SIMD_FIND_VALID_KEY(uint8x16_t, broadcastKeyNEON, matchBytesNEON);
+}
+
+// NEON has no 64-bit multiply, the scalar umulh is faster than emulating it
+inline constexpr SimdKernels kSimdKernelsNEON = {SimdLevel::NEON, fillItemsNEON, findValidKeyNEON, hashKeysScalar};
+
+#endif
+
+#undef EXLBR_SIMD_FILL_ITEMS
+#undef EXLBR_SIMD_FIND_VALID_KEY
+
+// nullptr if the kernels for this level are not compiled in (wrong architecture)
+[[nodiscard]] inline const SimdKernels* getSimdKernels(SimdLevel level) noexcept
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return &kSimdKernelsScalar;
+#if defined(EXLBR_SIMD_X86)
+    case SimdLevel::SSE2:
+        return &kSimdKernelsSSE2;
+    case SimdLevel::AVX2:
+        return &kSimdKernelsAVX2;
+    case SimdLevel::AVX512:
+        return &kSimdKernelsAVX512;
+#elif defined(EXLBR_SIMD_NEON)
+    case SimdLevel::NEON:
+        return &kSimdKernelsNEON;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+[[nodiscard]] inline SimdLevel detectSimdLevel() noexcept
+{
+#if defined(EXLBR_SIMD_X86)
+    #if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::AVX2;
+    }
+    #else
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    // OSXSAVE + AVX
+    const bool hasAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && hasAvx)
+    {
+        // XMM/YMM (and opmask/ZMM) state enabled by the OS
+        const uint64_t xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if ((xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0)
+        {
+            return SimdLevel::AVX512;
+        }
+        if ((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0)
+        {
+            return SimdLevel::AVX2;
+        }
+    }
+    #endif
+    return SimdLevel::SSE2;
+#elif defined(EXLBR_SIMD_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+[[nodiscard]] inline std::atomic<const SimdKernels*>& getActiveSimdKernels() noexcept
+{
+    static std::atomic<const SimdKernels*> activeKernels(getSimdKernels(detectSimdLevel()));
+    return activeKernels;
+}
+
+[[nodiscard]] inline const SimdKernels& getSimdKernels() noexcept { return *getActiveSimdKernels().load(std::memory_order_relaxed); }
+
+} // namespace detail
+
+// the best instruction set supported by this CPU (and picked by default)
+[[nodiscard]] inline SimdLevel getBestSimdLevel() noexcept
+{
+    static const SimdLevel bestLevel = detail::detectSimdLevel();
+    return bestLevel;
+}
+
+[[nodiscard]] inline bool isSimdLevelSupported(SimdLevel level) noexcept
+{
+    if (detail::getSimdKernels(level) == nullptr)
+    {
+        return false;
+    }
+    const SimdLevel bestLevel = getBestSimdLevel();
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::SSE2:
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        return bestLevel != SimdLevel::NEON && uint8_t(level) <= uint8_t(bestLevel);
+    case SimdLevel::NEON:
+        return bestLevel == SimdLevel::NEON;
+    }
+    return false;
+}
+
+// instruction set currently used by the hash tables
+[[nodiscard]] inline SimdLevel getSimdLevel() noexcept { return detail::getSimdKernels().level; }
+
+// Forces the kernels of a specific instruction set (to test every code path on one machine or to compare them).
+// Returns false (and changes nothing) if this CPU doesn't support it.
+inline bool setSimdLevel(SimdLevel level) noexcept
+{
+    if (!isSimdLevelSupported(level))
+    {
+        return false;
+    }
+    detail::getActiveSimdKernels().store(detail::getSimdKernels(level), std::memory_order_relaxed);
+    return true;
+}
+
+[[nodiscard]] inline const char* getSimdLevelName(SimdLevel level) noexcept
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return "Scalar";
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX512";
+    case SimdLevel::NEON:
+        return "NEON";
+    }
+    return "Unknown";
+}
+
+namespace wyhash
+{
+
+// Bulk version of hash(): out[i] = hash(keys[i]) for 'numKeys' keys, bit-identical to the scalar version.
+// Uses the SIMD kernels picked at runtime (see SimdLevel).
+inline void hashN(const uint64_t* keys, size_t* out, size_t numKeys) noexcept
+{
+    detail::getSimdKernels().hashKeys(keys, numKeys, sizeof(uint64_t), out);
+}
+inline void hashN(const uint32_t* keys, size_t* out, size_t numKeys) noexcept
+{
+    detail::getSimdKernels().hashKeys(keys, numKeys, sizeof(uint32_t), out);
+}
+inline void hashN(const int64_t* keys, size_t* out, size_t numKeys) noexcept
+{
+    detail::getSimdKernels().hashKeys(keys, numKeys, sizeof(int64_t), out);
+}
+inline void hashN(const int32_t* keys, size_t* out, size_t numKeys) noexcept
+{
+    detail::getSimdKernels().hashKeys(keys, numKeys, sizeof(int32_t), out);
+}
+
+} // namespace wyhash
+
+} // namespace Excalibur
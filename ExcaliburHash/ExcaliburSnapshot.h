@@ -0,0 +1,459 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Excalibur
+{
+
+/*
+
+Snapshot file format for HashTable/HashMap/HashSet with trivially copyable keys and values.
+
+  SnapshotHeader
+  padding up to header.dataOffset (a multiple of the storage alignment)
+  TItem[numBuckets] (raw bucket array, empty and tombstone slots included)
+
+The bucket array is written as is, so HashTableView can map the file and serve lookups straight from the page cache:
+opening is O(1) and the pages are shared between all the processes that map the same file.
+
+The header stores a checksum of the bucket layout (item size/offsets, sentinel keys, probing, cached hash) and a fingerprint
+of the hash function (hashes of the first stored keys). A snapshot written by an incompatible table type or a different
+hash function is rejected by HashTableView::open(). Files are native-endian (the magic doesn't match on the other byte order).
+
+*/
+
+enum class SnapshotStatus
+{
+    Ok,
+    IoError,
+    BadFormat,       // not a snapshot or truncated
+    VersionMismatch, // written by a different version of the format
+    LayoutMismatch,  // written by a table with a different key/value/item layout
+    HashMismatch,    // written with a different hash function
+};
+
+struct SnapshotHeader
+{
+    static inline constexpr uint64_t k_Magic = 0x504e5352424c5845ull; // "EXLBRSNP"
+    static inline constexpr uint32_t k_Version = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+    uint32_t numBuckets;
+    uint32_t numElements;
+    uint32_t itemSize;
+    uint32_t itemAlignment;
+    uint64_t layoutChecksum;
+    uint64_t hashFingerprint;
+};
+
+namespace detail
+{
+
+// FNV-1a
+[[nodiscard]] inline uint64_t snapshotChecksum(const void* data, size_t numBytes, uint64_t checksum = 0xcbf29ce484222325ull) noexcept
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < numBytes; i++)
+    {
+        checksum = (checksum ^ uint64_t(bytes[i])) * 0x100000001b3ull;
+    }
+    return checksum;
+}
+
+template <typename TKey, typename TValue, unsigned kNumInlineItems, typename TKeyInfo, typename TProbing, typename TAllocator,
+          typename TShrinkPolicy>
+struct SnapshotAccess<HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>>
+{
+    using TTable = HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>;
+    using TItem = typename TTable::TItem;
+    using TKeyType = TKey;
+    using TValueType = TValue;
+    using TKeyInfoType = TKeyInfo;
+
+    static inline constexpr bool k_HasValues = TTable::has_values::value;
+    static inline constexpr size_t k_StorageAlignment = TTable::k_StorageAlignment;
+    // number of keys hashed for the hash function fingerprint
+    static inline constexpr uint32_t k_NumFingerprintKeys = 32;
+
+    static_assert(std::is_trivially_copyable<TKey>::value, "Snapshots require trivially copyable keys");
+    static_assert(!k_HasValues || std::is_trivially_copyable<TValue>::value, "Snapshots require trivially copyable values");
+    static_assert(std::is_trivially_copyable<TItem>::value && std::is_trivially_destructible<TItem>::value, "Unexpected item type");
+    // views hash with TKeyInfo::hash, the seed of the table isn't part of the snapshot
+    static_assert(!detail::has_seeded_hash<TKeyInfo>::value, "Snapshots of seeded tables are not supported");
+
+    [[nodiscard]] static inline const TItem* getStorage(const TTable& table) noexcept { return table.m_storage; }
+    [[nodiscard]] static inline const TKey* getKey(const TItem* item) noexcept { return const_cast<TItem*>(item)->key(); }
+    [[nodiscard]] static inline const TValue* getValue(const TItem* item) noexcept { return const_cast<TItem*>(item)->value(); }
+    static inline void copyHash(TItem* dst, const TItem* src) noexcept { TTable::copyHash(dst, src); }
+
+    [[nodiscard]] static inline uint64_t getLayoutChecksum() noexcept
+    {
+        TItem item(TKeyInfo::getEmpty());
+        const char* itemBytes = reinterpret_cast<const char*>(&item);
+        uint64_t valueOffset = 0;
+        if constexpr (k_HasValues)
+        {
+            valueOffset = uint64_t(reinterpret_cast<const char*>(item.value()) - itemBytes);
+        }
+        const uint64_t layout[] = {sizeof(TKey),
+                                   alignof(TKey),
+                                   k_HasValues ? sizeof(TValue) : 0,
+                                   k_HasValues ? alignof(TValue) : 0,
+                                   sizeof(TItem),
+                                   alignof(TItem),
+                                   uint64_t(reinterpret_cast<const char*>(item.key()) - itemBytes),
+                                   valueOffset,
+                                   TTable::k_CacheHash ? 1u : 0u,
+                                   TTable::k_RobinHood ? 1u : 0u};
+        const TKey emptyKey = TKeyInfo::getEmpty();
+        const TKey tombstoneKey = TKeyInfo::getTombstone();
+        uint64_t checksum = snapshotChecksum(layout, sizeof(layout));
+        checksum = snapshotChecksum(&emptyKey, sizeof(TKey), checksum);
+        return snapshotChecksum(&tombstoneKey, sizeof(TKey), checksum);
+    }
+
+    [[nodiscard]] static inline uint64_t getHashFingerprint(const TItem* items, uint32_t numBuckets) noexcept
+    {
+        uint64_t checksum = snapshotChecksum(nullptr, 0);
+        uint32_t numKeys = 0;
+        for (uint32_t i = 0; i < numBuckets && numKeys < k_NumFingerprintKeys; i++)
+        {
+            if (items[i].isValid())
+            {
+                const uint64_t hashValue = uint64_t(TKeyInfo::hash(*getKey(items + i)));
+                checksum = snapshotChecksum(&hashValue, sizeof(hashValue), checksum);
+                numKeys++;
+            }
+        }
+        return checksum;
+    }
+
+    [[nodiscard]] static inline uint64_t getDataOffset() noexcept
+    {
+        return (uint64_t(sizeof(SnapshotHeader)) + k_StorageAlignment - 1) & ~uint64_t(k_StorageAlignment - 1);
+    }
+};
+
+// read-only file mapping
+class MappedFile
+{
+  public:
+    MappedFile() noexcept = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { unmap(); }
+
+    [[nodiscard]] inline bool map(const char* path) noexcept
+    {
+        unmap();
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            return false;
+        }
+        // the view keeps the mapping alive
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            return false;
+        }
+        m_data = data;
+        m_size = size_t(fileSize.QuadPart);
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        // the mapping stays valid after the descriptor is closed
+        void* data = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+        m_data = data;
+        m_size = size_t(fileStat.st_size);
+#endif
+        return true;
+    }
+
+    inline void unmap() noexcept
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(m_data, m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] inline const void* data() const noexcept { return m_data; }
+    [[nodiscard]] inline size_t size() const noexcept { return m_size; }
+
+    inline void swap(MappedFile& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+
+  private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace detail
+
+// Writes the table to 'path' (see SnapshotHeader). Tombstones are stored as is, call purgeTombstones() first to drop them.
+template <typename THashTable> SnapshotStatus saveSnapshot(const THashTable& table, const char* path)
+{
+    using TAccess = detail::SnapshotAccess<THashTable>;
+    using TItem = typename TAccess::TItem;
+
+    const TItem* items = TAccess::getStorage(table);
+    const uint32_t numBuckets = table.capacity();
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SnapshotHeader::k_Magic;
+    header.version = SnapshotHeader::k_Version;
+    header.headerSize = uint32_t(sizeof(SnapshotHeader));
+    header.dataOffset = TAccess::getDataOffset();
+    header.dataSize = uint64_t(numBuckets) * sizeof(TItem);
+    header.numBuckets = numBuckets;
+    header.numElements = table.size();
+    header.itemSize = uint32_t(sizeof(TItem));
+    header.itemAlignment = uint32_t(alignof(TItem));
+    header.layoutChecksum = TAccess::getLayoutChecksum();
+    header.hashFingerprint = TAccess::getHashFingerprint(items, numBuckets);
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        return SnapshotStatus::IoError;
+    }
+
+    // items are re-created in a zeroed buffer, so padding bytes and the value storage of empty slots don't leak into the file.
+    // The buffer has the alignment of the bucket array, TItem might be over-aligned.
+    constexpr uint32_t k_NumItemsPerChunk = 4096;
+    const size_t bufferSize = detail::alignSize(std::max(size_t(header.dataOffset), sizeof(TItem) * std::min(numBuckets, k_NumItemsPerChunk)),
+                                                TAccess::k_StorageAlignment);
+    unsigned char* buffer = reinterpret_cast<unsigned char*>(EXLBR_ALLOC(bufferSize, TAccess::k_StorageAlignment));
+    if (buffer == nullptr)
+    {
+        fclose(file);
+        return SnapshotStatus::IoError;
+    }
+    memset(buffer, 0, bufferSize);
+    memcpy(buffer, &header, sizeof(header));
+    bool isOk = fwrite(buffer, size_t(header.dataOffset), 1, file) == 1;
+
+    for (uint32_t first = 0; isOk && first < numBuckets; first += k_NumItemsPerChunk)
+    {
+        const uint32_t numItems = std::min(numBuckets - first, k_NumItemsPerChunk);
+        memset(buffer, 0, bufferSize);
+        TItem* dstItems = reinterpret_cast<TItem*>(buffer);
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            const TItem* srcItem = items + first + i;
+            TItem* dstItem = new (dstItems + i) TItem(typename TAccess::TKeyType(*TAccess::getKey(srcItem)));
+            if (srcItem->isValid())
+            {
+                TAccess::copyHash(dstItem, srcItem);
+                if constexpr (TAccess::k_HasValues)
+                {
+                    memcpy(static_cast<void*>(dstItem->value()), TAccess::getValue(srcItem), sizeof(typename TAccess::TValueType));
+                }
+            }
+        }
+        isOk = fwrite(buffer, sizeof(TItem) * numItems, 1, file) == 1;
+    }
+    EXLBR_FREE(buffer);
+
+    isOk = (fclose(file) == 0) && isOk;
+    return isOk ? SnapshotStatus::Ok : SnapshotStatus::IoError;
+}
+
+/*
+
+Read-only table that serves lookups straight from a memory-mapped snapshot (see saveSnapshot).
+THashTable is the type of the table that wrote the snapshot, e.g. HashTableView<HashMap<uint64_t, Record>>.
+
+*/
+template <typename THashTable> class HashTableView
+{
+    using TAccess = detail::SnapshotAccess<THashTable>;
+    using TItem = typename TAccess::TItem;
+    using TKey = typename TAccess::TKeyType;
+    using TValue = typename TAccess::TValueType;
+    using TKeyInfo = typename TAccess::TKeyInfoType;
+
+  public:
+    HashTableView() noexcept = default;
+    HashTableView(const HashTableView&) = delete;
+    HashTableView& operator=(const HashTableView&) = delete;
+
+    HashTableView(HashTableView&& other) noexcept { swap(other); }
+    HashTableView& operator=(HashTableView&& other) noexcept
+    {
+        HashTableView tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    [[nodiscard]] SnapshotStatus open(const char* path) noexcept
+    {
+        close();
+        detail::MappedFile file;
+        if (!file.map(path))
+        {
+            return SnapshotStatus::IoError;
+        }
+
+        if (file.size() < sizeof(SnapshotHeader))
+        {
+            return SnapshotStatus::BadFormat;
+        }
+        SnapshotHeader header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (header.magic != SnapshotHeader::k_Magic)
+        {
+            return SnapshotStatus::BadFormat;
+        }
+        if (header.version != SnapshotHeader::k_Version || header.headerSize != sizeof(SnapshotHeader))
+        {
+            return SnapshotStatus::VersionMismatch;
+        }
+        if (header.layoutChecksum != TAccess::getLayoutChecksum() || header.itemSize != sizeof(TItem) ||
+            header.itemAlignment != alignof(TItem) || header.dataOffset != TAccess::getDataOffset())
+        {
+            return SnapshotStatus::LayoutMismatch;
+        }
+        const uint32_t numBuckets = header.numBuckets;
+        if (numBuckets == 0 || (numBuckets & (numBuckets - 1)) != 0 || header.numElements > numBuckets ||
+            header.dataSize != uint64_t(numBuckets) * sizeof(TItem) || uint64_t(file.size()) != header.dataOffset + header.dataSize)
+        {
+            return SnapshotStatus::BadFormat;
+        }
+
+        const TItem* items = reinterpret_cast<const TItem*>(reinterpret_cast<const char*>(file.data()) + header.dataOffset);
+        if (header.hashFingerprint != TAccess::getHashFingerprint(items, numBuckets))
+        {
+            return SnapshotStatus::HashMismatch;
+        }
+
+        m_file.swap(file);
+        m_items = items;
+        m_numBuckets = numBuckets;
+        m_numElements = header.numElements;
+        return SnapshotStatus::Ok;
+    }
+
+    inline void close() noexcept
+    {
+        m_file.unmap();
+        m_items = nullptr;
+        m_numBuckets = 0;
+        m_numElements = 0;
+    }
+
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_items != nullptr; }
+    [[nodiscard]] inline uint32_t size() const noexcept { return m_numElements; }
+    [[nodiscard]] inline uint32_t capacity() const noexcept { return m_numBuckets; }
+    [[nodiscard]] inline bool empty() const noexcept { return m_numElements == 0; }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept { return findItem(key) != nullptr; }
+
+    // nullptr if the key doesn't exist (maps only)
+    [[nodiscard]] inline const TValue* find(const TKey& key) const noexcept
+    {
+        static_assert(TAccess::k_HasValues, "Use has() for sets");
+        const TItem* item = findItem(key);
+        return (item != nullptr) ? TAccess::getValue(item) : nullptr;
+    }
+
+  private:
+    // plain linear probing up to the first empty slot (correct for both probing policies)
+    [[nodiscard]] inline const TItem* findItem(const TKey& key) const noexcept
+    {
+        const size_t numBuckets = m_numBuckets;
+        const size_t hashValue = TKeyInfo::hash(key);
+        size_t bucketIndex = hashValue & (numBuckets - 1);
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            const TItem* item = m_items + bucketIndex;
+            if (EXLBR_LIKELY(item->isHashEqual(hashValue) && item->isEqual(key)))
+            {
+                return item;
+            }
+            if (item->isEmpty())
+            {
+                return nullptr;
+            }
+            bucketIndex = (bucketIndex + 1) & (numBuckets - 1);
+        }
+        return nullptr;
+    }
+
+    inline void swap(HashTableView& other) noexcept
+    {
+        m_file.swap(other.m_file);
+        std::swap(m_items, other.m_items);
+        std::swap(m_numBuckets, other.m_numBuckets);
+        std::swap(m_numElements, other.m_numElements);
+    }
+
+    detail::MappedFile m_file;
+    const TItem* m_items = nullptr;
+    uint32_t m_numBuckets = 0;
+    uint32_t m_numElements = 0;
+};
+
+} // namespace Excalibur
@@ -0,0 +1,547 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+
+namespace Excalibur
+{
+
+/*
+
+Open addressing hash map with a split (structure-of-arrays) memory layout.
+
+Keys live in their own dense array and values in a parallel array at the same index. Probing only touches
+the key array (64 / sizeof(TKey) keys per cache line), and the value cache line is only touched on a hit.
+This pays off for large values, where HashTable would pull a new cache line for every probe step.
+The price is a second cache miss (key line + value line) on every successful lookup, so small values
+are usually faster with HashTable.
+
+Keys are used as markers the same way as in HashTable (linear probing, tombstones, 75% load factor).
+Memory comes from TAllocator (see DefaultAllocator), one allocation holds both arrays.
+
+*/
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator>
+class SplitHashTable : private detail::AllocatorHolder<TAllocator>
+{
+    using TAllocatorHolder = detail::AllocatorHolder<TAllocator>;
+
+    static_assert(!std::is_same<std::nullptr_t, typename std::remove_reference<TValue>::type>::value,
+                  "SplitHashTable without values is the same as HashSet, use HashSet instead");
+
+    static inline constexpr uint32_t k_MinNumberOfBuckets = 16;
+
+    using TValueStorage = typename std::aligned_storage<sizeof(TValue), alignof(TValue)>::type;
+    using TIterators = detail::TableIterators<SplitHashTable, TKey, TKey, TValue>;
+    friend TIterators;
+    friend struct detail::TableRehash;
+
+    struct TStorage
+    {
+        TKey* keys;
+        TValueStorage* values;
+        uint32_t numBuckets;
+        bool hasStorage;
+    };
+
+    template <typename T, class... Args> static T* construct(void* EXLBR_RESTRICT ptr, Args&&... args)
+    {
+        return new (ptr) T(std::forward<Args>(args)...);
+    }
+    template <typename T> static void destruct(T* EXLBR_RESTRICT ptr) { ptr->~T(); }
+
+    [[nodiscard]] static inline bool isEmpty(const TKey& key) noexcept { return detail::isEmptyKey<TKeyInfo>(key); }
+    [[nodiscard]] static inline bool isTombstone(const TKey& key) noexcept { return detail::isTombstoneKey<TKeyInfo>(key); }
+
+    // note: 64 to match CPU cache line size
+    static inline constexpr size_t k_StorageAlignment = std::max(std::max(alignof(TKey), alignof(TValue)), size_t(64));
+
+    [[nodiscard]] inline TValue* valueAt(const TKey* key) const noexcept
+    {
+        TValue* value = reinterpret_cast<TValue*>(m_values + (key - m_keys));
+        return std::launder(value);
+    }
+
+    // iterator support (see detail::TableIterators)
+    [[nodiscard]] inline TKey* getFirstSlot() const noexcept { return m_keys; }
+    [[nodiscard]] inline TKey* getEndSlot() const noexcept { return m_keys + m_numBuckets; }
+    [[nodiscard]] inline TKey* findValidSlot(TKey* key) const noexcept
+    {
+        TKey* const endKey = m_keys + m_numBuckets;
+        while (key < endKey && !TKeyInfo::isValid(*key))
+        {
+            key++;
+        }
+        return key;
+    }
+    [[nodiscard]] inline const TKey* getSlotKey(const TKey* key) const noexcept
+    {
+        EXLBR_ASSERT(TKeyInfo::isValid(*key));
+        return key;
+    }
+    [[nodiscard]] inline const TValue* getSlotValue(const TKey* key) const noexcept
+    {
+        EXLBR_ASSERT(TKeyInfo::isValid(*key));
+        return valueAt(key);
+    }
+
+    inline void initEmpty() noexcept
+    {
+        // a single always empty key, so find() never has to check for a missing allocation
+        m_keys = &m_emptyKey;
+        m_values = nullptr;
+        m_numBuckets = 1;
+        m_numElements = 0;
+        m_numTombstones = 0;
+    }
+
+    [[nodiscard]] inline bool isUsingEmptyKey() const noexcept { return m_keys == &m_emptyKey; }
+
+    // [keys][values], both arrays start at a cache line boundary
+    [[nodiscard]] static inline size_t getKeysSize(uint32_t numBuckets) noexcept
+    {
+        return detail::alignSize(sizeof(TKey) * size_t(numBuckets), k_StorageAlignment);
+    }
+    [[nodiscard]] static inline size_t getStorageSize(uint32_t numBuckets) noexcept
+    {
+        return getKeysSize(numBuckets) + detail::alignSize(sizeof(TValueStorage) * size_t(numBuckets), k_StorageAlignment);
+    }
+
+    inline void freeStorage(TKey* keys, uint32_t numBuckets) noexcept
+    {
+        this->getAllocatorRef().deallocate(keys, getStorageSize(numBuckets), k_StorageAlignment);
+    }
+
+    inline void create(uint32_t numBuckets)
+    {
+        numBuckets = (numBuckets < k_MinNumberOfBuckets) ? k_MinNumberOfBuckets : numBuckets;
+        EXLBR_ASSERT((numBuckets & (numBuckets - 1)) == 0);
+
+        const size_t keysBytes = getKeysSize(numBuckets);
+        void* raw = this->getAllocatorRef().allocate(getStorageSize(numBuckets), k_StorageAlignment);
+        EXLBR_ASSERT(raw);
+        m_keys = reinterpret_cast<TKey*>(raw);
+        m_values = reinterpret_cast<TValueStorage*>(reinterpret_cast<char*>(raw) + keysBytes);
+        m_numBuckets = numBuckets;
+        m_numElements = 0;
+        m_numTombstones = 0;
+
+        TKey* EXLBR_RESTRICT key = m_keys;
+        TKey* const endKey = key + numBuckets;
+        for (; key != endKey; key++)
+        {
+            construct<TKey>(key, TKeyInfo::getEmpty());
+        }
+    }
+
+    inline void destroy() noexcept
+    {
+        TKey* EXLBR_RESTRICT key = m_keys;
+        TKey* const endKey = key + m_numBuckets;
+        for (; key != endKey; key++)
+        {
+            if constexpr (!std::is_trivially_destructible<TValue>::value)
+            {
+                if (TKeyInfo::isValid(*key))
+                {
+                    destruct(valueAt(key));
+                }
+            }
+            destruct(key);
+        }
+    }
+
+    inline void destroyAndFreeMemory() noexcept
+    {
+        if (isUsingEmptyKey())
+        {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible<TValue>::value || !std::is_trivially_destructible<TKey>::value)
+        {
+            destroy();
+        }
+        freeStorage(m_keys, m_numBuckets);
+    }
+
+    [[nodiscard]] inline TKey* findImpl(const TKey& key, size_t hashValue) const noexcept
+    {
+        EXLBR_ASSERT(!isTombstone(key));
+        EXLBR_ASSERT(!isEmpty(key));
+        const size_t mask = size_t(m_numBuckets) - 1;
+        TKey* const keys = m_keys;
+        size_t index = hashValue & mask;
+        for (size_t numProbes = 0; numProbes <= mask; numProbes++)
+        {
+            const TKey& currentKey = keys[index];
+            if (EXLBR_LIKELY(TKeyInfo::isEqual(key, currentKey)))
+            {
+                return keys + index;
+            }
+            if (isEmpty(currentKey))
+            {
+                break;
+            }
+            index = (index + 1) & mask;
+        }
+        return keys + m_numBuckets;
+    }
+
+    [[nodiscard]] inline TKey* findImpl(const TKey& key) const noexcept { return findImpl(key, TKeyInfo::hash(key)); }
+
+    // probes for 'key', returns (slot, true) if the key already exists or (slot to insert into, false)
+    [[nodiscard]] inline std::pair<TKey*, bool> findOrInsertSlot(const TKey& key, size_t hashValue) const noexcept
+    {
+        const size_t mask = size_t(m_numBuckets) - 1;
+        TKey* const keys = m_keys;
+        TKey* foundTombstone = nullptr;
+        size_t index = hashValue & mask;
+        while (true)
+        {
+            TKey* currentKey = keys + index;
+            if (TKeyInfo::isEqual(key, *currentKey))
+            {
+                return std::make_pair(currentKey, true);
+            }
+            if (isEmpty(*currentKey))
+            {
+                // prefer the first tombstone to keep probe sequences short
+                return std::make_pair((foundTombstone == nullptr) ? currentKey : foundTombstone, false);
+            }
+            if (foundTombstone == nullptr && isTombstone(*currentKey))
+            {
+                foundTombstone = currentKey;
+            }
+            // the growth threshold guarantees that an empty slot exists
+            index = (index + 1) & mask;
+        }
+    }
+
+    template <typename TK, class... Args> inline TKey* insertAt(TKey* slot, TK&& key, Args&&... args)
+    {
+        EXLBR_ASSERT(!TKeyInfo::isValid(*slot));
+        m_numTombstones -= isTombstone(*slot) ? 1 : 0;
+        // move or copy key
+        *slot = std::forward<TK>(key);
+        construct<TValue>(valueAt(slot), std::forward<Args>(args)...);
+        m_numElements++;
+        return slot;
+    }
+
+    [[nodiscard]] inline TStorage getStorage() const noexcept { return TStorage{m_keys, m_values, m_numBuckets, !isUsingEmptyKey()}; }
+
+    inline void moveItemsAndFree(const TStorage& storage)
+    {
+        if (!storage.hasStorage)
+        {
+            return;
+        }
+
+        for (uint32_t index = 0; index < storage.numBuckets; index++)
+        {
+            TKey* key = storage.keys + index;
+            if (TKeyInfo::isValid(*key))
+            {
+                TValue* value = std::launder(reinterpret_cast<TValue*>(storage.values + index));
+                const std::pair<TKey*, bool> slot = findOrInsertSlot(*key, TKeyInfo::hash(*key));
+                EXLBR_ASSERT(!slot.second);
+                insertAt(slot.first, std::move(*key), std::move(*value));
+                if constexpr (!std::is_trivially_destructible<TValue>::value)
+                {
+                    destruct(value);
+                }
+            }
+            destruct(key);
+        }
+        freeStorage(storage.keys, storage.numBuckets);
+    }
+
+    inline void resize(uint32_t numBucketsNew) { detail::TableRehash::resize(*this, numBucketsNew); }
+
+    template <typename TK, class... Args> inline TKey* emplaceReallocate(TK&& key, Args&&... args)
+    {
+        const uint32_t numBucketsNew = detail::getGrowSize(m_numBuckets, m_numElements, m_numTombstones, !isUsingEmptyKey(), k_MinNumberOfBuckets);
+        return detail::TableRehash::resizeAndInsert(*this, numBucketsNew,
+                                                    [&]()
+                                                    {
+                                                        const std::pair<TKey*, bool> slot = findOrInsertSlot(key, TKeyInfo::hash(key));
+                                                        return insertAt(slot.first, std::forward<TK>(key), std::forward<Args>(args)...);
+                                                    });
+    }
+
+    inline void copyFrom(const SplitHashTable& other)
+    {
+        if (other.isUsingEmptyKey())
+        {
+            initEmpty();
+            return;
+        }
+
+        // same capacity = same slots, no need to rehash anything
+        create(other.m_numBuckets);
+        for (size_t index = 0; index < m_numBuckets; index++)
+        {
+            const TKey& otherKey = other.m_keys[index];
+            m_keys[index] = otherKey;
+            if (TKeyInfo::isValid(otherKey))
+            {
+                construct<TValue>(valueAt(m_keys + index), static_cast<const TValue&>(*other.valueAt(other.m_keys + index)));
+            }
+        }
+        m_numElements = other.m_numElements;
+        m_numTombstones = other.m_numTombstones;
+    }
+
+    inline void moveFrom(SplitHashTable&& other) noexcept
+    {
+        if (other.isUsingEmptyKey())
+        {
+            initEmpty();
+            return;
+        }
+        m_keys = other.m_keys;
+        m_values = other.m_values;
+        m_numBuckets = other.m_numBuckets;
+        m_numElements = other.m_numElements;
+        m_numTombstones = other.m_numTombstones;
+        other.initEmpty();
+    }
+
+  public:
+    using IteratorBase = typename TIterators::IteratorBase;
+    using IteratorK = typename TIterators::IteratorK;
+    template <typename TIteratorValue> using TIteratorV = typename TIterators::template TIteratorV<TIteratorValue>;
+    template <typename TIteratorValue> using TIteratorKV = typename TIterators::template TIteratorKV<TIteratorValue>;
+
+    using IteratorKV = TIteratorKV<TValue>;
+    using ConstIteratorKV = TIteratorKV<const TValue>;
+    using IteratorV = TIteratorV<TValue>;
+    using ConstIteratorV = TIteratorV<const TValue>;
+
+    SplitHashTable() noexcept
+        : m_emptyKey(TKeyInfo::getEmpty())
+    {
+        initEmpty();
+    }
+
+    explicit SplitHashTable(const TAllocator& allocator) noexcept
+        : TAllocatorHolder(allocator)
+        , m_emptyKey(TKeyInfo::getEmpty())
+    {
+        initEmpty();
+    }
+
+    ~SplitHashTable() { destroyAndFreeMemory(); }
+
+    inline void clear()
+    {
+        if (isUsingEmptyKey())
+        {
+            return;
+        }
+
+        TKey* EXLBR_RESTRICT key = m_keys;
+        TKey* const endKey = key + m_numBuckets;
+        for (; key != endKey; key++)
+        {
+            if (TKeyInfo::isValid(*key))
+            {
+                if constexpr (!std::is_trivially_destructible<TValue>::value)
+                {
+                    destruct(valueAt(key));
+                }
+                *key = TKeyInfo::getEmpty();
+            }
+            else if (isTombstone(*key))
+            {
+                *key = TKeyInfo::getEmpty();
+            }
+        }
+        m_numElements = 0;
+        m_numTombstones = 0;
+    }
+
+    template <typename TK, class... Args> inline std::pair<IteratorKV, bool> emplace(TK&& key, Args&&... args)
+    {
+        static_assert(std::is_same<TKey, typename std::remove_const<typename std::remove_reference<TK>::type>::type>::value,
+                      "Expected unversal reference of TKey type. Wrong key type?");
+
+        EXLBR_ASSERT(!isTombstone(key));
+        EXLBR_ASSERT(!isEmpty(key));
+        if (EXLBR_UNLIKELY(m_numElements + m_numTombstones >= detail::getGrowthThreshold(m_numBuckets)))
+        {
+            TKey* existingKey = findImpl(key);
+            if (existingKey != m_keys + m_numBuckets)
+            {
+                return std::make_pair(IteratorKV(this, existingKey), false);
+            }
+            TKey* newKey = emplaceReallocate(std::forward<TK>(key), std::forward<Args>(args)...);
+            return std::make_pair(IteratorKV(this, newKey), true);
+        }
+
+        const std::pair<TKey*, bool> slot = findOrInsertSlot(key, TKeyInfo::hash(key));
+        if (slot.second)
+        {
+            return std::make_pair(IteratorKV(this, slot.first), false);
+        }
+        TKey* newKey = insertAt(slot.first, std::forward<TK>(key), std::forward<Args>(args)...);
+        return std::make_pair(IteratorKV(this, newKey), true);
+    }
+
+    [[nodiscard]] inline ConstIteratorKV find(const TKey& key) const noexcept { return ConstIteratorKV(this, findImpl(key)); }
+    [[nodiscard]] inline IteratorKV find(const TKey& key) noexcept { return IteratorKV(this, findImpl(key)); }
+
+    inline TKey* eraseImpl(const IteratorBase it)
+    {
+        TKey* const endKey = m_keys + m_numBuckets;
+        if (it.m_slot == endKey)
+        {
+            return endKey;
+        }
+
+        TKey* key = it.m_slot;
+        EXLBR_ASSERT(TKeyInfo::isValid(*key));
+        EXLBR_ASSERT(m_numElements != 0);
+        if constexpr (!std::is_trivially_destructible<TValue>::value)
+        {
+            destruct(valueAt(key));
+        }
+        *key = TKeyInfo::getTombstone();
+        m_numElements--;
+        m_numTombstones++;
+
+        return findValidSlot(key + 1);
+    }
+
+    inline IteratorKV erase(const IteratorKV& it) { return IteratorKV(this, eraseImpl(it)); }
+    inline ConstIteratorKV erase(const ConstIteratorKV& it) { return ConstIteratorKV(this, eraseImpl(it)); }
+
+    inline bool erase(const TKey& key)
+    {
+        auto it = find(key);
+        if (it == iend())
+        {
+            return false;
+        }
+        eraseImpl(it);
+        return true;
+    }
+
+    inline void rehash()
+    {
+        if (!isUsingEmptyKey())
+        {
+            resize(m_numBuckets);
+        }
+    }
+
+    inline bool reserve(uint32_t numBucketsNew)
+    {
+        if (numBucketsNew == 0 || numBucketsNew < capacity())
+        {
+            return false;
+        }
+        resize(detail::nextPow2(numBucketsNew));
+        return true;
+    }
+
+    [[nodiscard]] inline const TAllocator& getAllocator() const noexcept { return this->getAllocatorRef(); }
+
+    [[nodiscard]] inline uint32_t getNumTombstones() const noexcept { return m_numTombstones; }
+    [[nodiscard]] inline uint32_t size() const noexcept { return m_numElements; }
+    [[nodiscard]] inline uint32_t capacity() const noexcept { return m_numBuckets; }
+    [[nodiscard]] inline bool empty() const noexcept { return (m_numElements == 0); }
+
+    [[nodiscard]] inline bool has(const TKey& key) const noexcept { return (findImpl(key) != m_keys + m_numBuckets); }
+
+    inline TValue& operator[](const TKey& key)
+    {
+        std::pair<IteratorKV, bool> emplaceIt = emplace(key);
+        return emplaceIt.first.value();
+    }
+
+    [[nodiscard]] inline IteratorK begin() const { return TIterators::template begin<IteratorK>(*this); }
+    [[nodiscard]] inline IteratorK end() const { return TIterators::template end<IteratorK>(*this); }
+
+    [[nodiscard]] inline ConstIteratorV vbegin() const { return TIterators::template begin<ConstIteratorV>(*this); }
+    [[nodiscard]] inline ConstIteratorV vend() const { return TIterators::template end<ConstIteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vbegin() { return TIterators::template begin<IteratorV>(*this); }
+    [[nodiscard]] inline IteratorV vend() { return TIterators::template end<IteratorV>(*this); }
+
+    [[nodiscard]] inline ConstIteratorKV ibegin() const { return TIterators::template begin<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline ConstIteratorKV iend() const { return TIterators::template end<ConstIteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV ibegin() { return TIterators::template begin<IteratorKV>(*this); }
+    [[nodiscard]] inline IteratorKV iend() { return TIterators::template end<IteratorKV>(*this); }
+
+    template <typename TIterator> using TypedIteratorHelper = typename TIterators::template TypedIteratorHelper<TIterator>;
+
+    using Keys = TypedIteratorHelper<IteratorK>;
+    using Values = TypedIteratorHelper<IteratorV>;
+    using Items = TypedIteratorHelper<IteratorKV>;
+    using ConstValues = TypedIteratorHelper<ConstIteratorV>;
+    using ConstItems = TypedIteratorHelper<ConstIteratorKV>;
+
+    [[nodiscard]] inline Keys keys() const { return Keys(this); }
+    [[nodiscard]] inline ConstValues values() const { return ConstValues(this); }
+    [[nodiscard]] inline ConstItems items() const { return ConstItems(this); }
+
+    [[nodiscard]] inline Values values() { return Values(this); }
+    [[nodiscard]] inline Items items() { return Items(this); }
+
+    // copy ctor
+    SplitHashTable(const SplitHashTable& other)
+        : TAllocatorHolder(other.getAllocatorRef())
+        , m_emptyKey(TKeyInfo::getEmpty())
+    {
+        EXLBR_ASSERT(&other != this);
+        copyFrom(other);
+    }
+
+    // copy assignment
+    SplitHashTable& operator=(const SplitHashTable& other)
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        destroyAndFreeMemory();
+        this->getAllocatorRef() = other.getAllocatorRef();
+        copyFrom(other);
+        return *this;
+    }
+
+    // move ctor
+    SplitHashTable(SplitHashTable&& other) noexcept
+        : TAllocatorHolder(other.getAllocatorRef())
+        , m_emptyKey(TKeyInfo::getEmpty())
+    {
+        EXLBR_ASSERT(&other != this);
+        moveFrom(std::move(other));
+    }
+
+    // move assignment
+    SplitHashTable& operator=(SplitHashTable&& other) noexcept
+    {
+        if (&other == this)
+        {
+            return *this;
+        }
+        destroyAndFreeMemory();
+        // note: the storage is moved along with the allocator that owns it
+        this->getAllocatorRef() = other.getAllocatorRef();
+        moveFrom(std::move(other));
+        return *this;
+    }
+
+  private:
+    TKey* m_keys;             // 8
+    TValueStorage* m_values;  // 8
+    uint32_t m_numBuckets;    // 4
+    uint32_t m_numElements;   // 4
+    uint32_t m_numTombstones; // 4
+    TKey m_emptyKey;
+};
+
+// hashmap declaration
+template <typename TKey, typename TValue, typename TKeyInfo = KeyInfo<TKey>, typename TAllocator = DefaultAllocator>
+using SplitHashMap = SplitHashTable<TKey, TValue, TKeyInfo, TAllocator>;
+
+} // namespace Excalibur
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include <array>
+#include <string_view>
+
+namespace Excalibur
+{
+
+// KeyInfo for StaticHashMap: the same contract as KeyInfo (hash/isEqual), but constexpr and without sentinel keys
+template <typename T, typename = void> struct StaticKeyInfo
+{
+    // static constexpr size_t hash(const T& key) noexcept;
+    // static constexpr bool isEqual(const T& lhs, const T& rhs) noexcept;
+};
+
+template <typename T> struct StaticKeyInfo<T, std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+{
+    static constexpr size_t hash(const T& key) noexcept { return size_t(detail::fmix64(uint64_t(key))); }
+    static constexpr bool isEqual(const T& lhs, const T& rhs) noexcept { return lhs == rhs; }
+};
+
+template <> struct StaticKeyInfo<std::string_view>
+{
+    // FNV-1a
+    static constexpr size_t hash(std::string_view key) noexcept
+    {
+        uint64_t hashValue = 0xcbf29ce484222325ull;
+        for (char c : key)
+        {
+            hashValue = (hashValue ^ uint64_t(uint8_t(c))) * 0x100000001b3ull;
+        }
+        return size_t(hashValue);
+    }
+    static constexpr bool isEqual(std::string_view lhs, std::string_view rhs) noexcept { return lhs == rhs; }
+};
+
+namespace detail
+{
+// not constexpr on purpose: reaching it during constant evaluation turns a duplicate key into a compile error
+inline void staticHashMapDuplicateKey() noexcept { EXLBR_ASSERT(false && "StaticHashMap: duplicate key"); }
+} // namespace detail
+
+/*
+
+Immutable hash map built at compile time from a constexpr list of key/value pairs.
+
+  static constexpr auto kMethods = Excalibur::makeStaticHashMap<std::string_view, Method>({{"GET", Method::Get}, {"PUT", Method::Put}});
+  static_assert(kMethods.find("PUT").value() == Method::Put);
+
+Items are stored in declaration order, the bucket array holds item indices (<= 50% load).
+The compiler tries several hash seeds and keeps the one with the shortest maximum probe length, most small key sets end up
+with a perfect (single probe) placement. Since the table is a constant, lookups inline down to the hash, one or two slot loads
+and key compares. Duplicate keys are a compile error.
+
+*/
+template <typename TKey, typename TValue, size_t kNumItems, typename TKeyInfo = StaticKeyInfo<TKey>> class StaticHashMap
+{
+    static_assert(kNumItems > 0, "StaticHashMap can't be empty");
+    static_assert(kNumItems < 0xffff, "StaticHashMap is meant for small literal key sets");
+
+    [[nodiscard]] static constexpr size_t getNumBuckets() noexcept
+    {
+        size_t numBuckets = 1;
+        while (numBuckets < kNumItems * 2)
+        {
+            numBuckets *= 2;
+        }
+        return numBuckets;
+    }
+
+    static inline constexpr size_t k_NumBuckets = getNumBuckets();
+    static inline constexpr uint16_t k_EmptySlot = 0xffff;
+    static inline constexpr uint64_t k_NumSeeds = 64;
+
+  public:
+    using KeyValue = std::pair<TKey, TValue>;
+
+    class ConstIteratorKV
+    {
+        friend class StaticHashMap;
+        constexpr explicit ConstIteratorKV(const KeyValue* item) noexcept
+            : m_item(item)
+        {
+        }
+
+      public:
+        [[nodiscard]] constexpr const TKey& key() const noexcept { return m_item->first; }
+        [[nodiscard]] constexpr const TValue& value() const noexcept { return m_item->second; }
+        [[nodiscard]] constexpr const KeyValue& operator*() const noexcept { return *m_item; }
+        [[nodiscard]] constexpr const KeyValue* operator->() const noexcept { return m_item; }
+
+        constexpr ConstIteratorKV& operator++() noexcept
+        {
+            m_item++;
+            return *this;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const ConstIteratorKV& other) const noexcept { return m_item == other.m_item; }
+        [[nodiscard]] constexpr bool operator!=(const ConstIteratorKV& other) const noexcept { return m_item != other.m_item; }
+
+      private:
+        const KeyValue* m_item;
+    };
+
+    struct Items
+    {
+        const StaticHashMap* map;
+        [[nodiscard]] constexpr ConstIteratorKV begin() const noexcept { return map->ibegin(); }
+        [[nodiscard]] constexpr ConstIteratorKV end() const noexcept { return map->iend(); }
+    };
+
+    constexpr explicit StaticHashMap(const KeyValue (&items)[kNumItems])
+        : StaticHashMap(items, std::make_index_sequence<kNumItems>())
+    {
+    }
+
+    [[nodiscard]] constexpr ConstIteratorKV find(const TKey& key) const noexcept
+    {
+        const uint64_t hashValue = getSlotHash(uint64_t(TKeyInfo::hash(key)), m_seed);
+        size_t bucketIndex = size_t(hashValue) & (k_NumBuckets - 1);
+        for (uint32_t i = 0; i < m_maxProbeLength; i++)
+        {
+            const uint16_t itemIndex = m_slots[bucketIndex];
+            if (itemIndex == k_EmptySlot)
+            {
+                break;
+            }
+            if (TKeyInfo::isEqual(key, m_items[itemIndex].first))
+            {
+                return ConstIteratorKV(&m_items[itemIndex]);
+            }
+            bucketIndex = (bucketIndex + 1) & (k_NumBuckets - 1);
+        }
+        return iend();
+    }
+
+    [[nodiscard]] constexpr bool has(const TKey& key) const noexcept { return find(key) != iend(); }
+
+    [[nodiscard]] constexpr ConstIteratorKV ibegin() const noexcept { return ConstIteratorKV(m_items.data()); }
+    [[nodiscard]] constexpr ConstIteratorKV iend() const noexcept { return ConstIteratorKV(m_items.data() + kNumItems); }
+    [[nodiscard]] constexpr Items items() const noexcept { return Items{this}; }
+
+    [[nodiscard]] constexpr uint32_t size() const noexcept { return uint32_t(kNumItems); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return false; }
+    [[nodiscard]] constexpr uint32_t capacity() const noexcept { return uint32_t(k_NumBuckets); }
+    // 1 = every key is found with a single probe
+    [[nodiscard]] constexpr uint32_t getMaxProbeLength() const noexcept { return m_maxProbeLength; }
+
+  private:
+    template <size_t... I>
+    constexpr StaticHashMap(const KeyValue (&items)[kNumItems], std::index_sequence<I...>)
+        : m_items{{items[I]...}}
+        , m_slots{}
+    {
+        std::array<uint64_t, kNumItems> hashes{};
+        for (size_t i = 0; i < kNumItems; i++)
+        {
+            hashes[i] = uint64_t(TKeyInfo::hash(m_items[i].first));
+        }
+
+        uint64_t bestSeed = 0;
+        uint32_t bestProbeLength = UINT32_MAX;
+        for (uint64_t seed = 0; seed < k_NumSeeds && bestProbeLength > 1; seed++)
+        {
+            const uint32_t maxProbeLength = place(hashes, seed, false);
+            if (maxProbeLength < bestProbeLength)
+            {
+                bestProbeLength = maxProbeLength;
+                bestSeed = seed;
+            }
+        }
+
+        m_seed = bestSeed;
+        m_maxProbeLength = place(hashes, bestSeed, true);
+    }
+
+    [[nodiscard]] static constexpr uint64_t getSlotHash(uint64_t hashValue, uint64_t seed) noexcept
+    {
+        return detail::fmix64(hashValue + seed * 0x9E3779B97F4A7C15ull);
+    }
+
+    // linear probing, returns the maximum probe length
+    constexpr uint32_t place(const std::array<uint64_t, kNumItems>& hashes, uint64_t seed, bool checkDuplicates)
+    {
+        for (size_t i = 0; i < k_NumBuckets; i++)
+        {
+            m_slots[i] = k_EmptySlot;
+        }
+        uint32_t maxProbeLength = 0;
+        for (size_t i = 0; i < kNumItems; i++)
+        {
+            size_t bucketIndex = size_t(getSlotHash(hashes[i], seed)) & (k_NumBuckets - 1);
+            uint32_t probeLength = 1;
+            while (m_slots[bucketIndex] != k_EmptySlot)
+            {
+                const uint16_t otherIndex = m_slots[bucketIndex];
+                if (checkDuplicates && hashes[otherIndex] == hashes[i] && TKeyInfo::isEqual(m_items[otherIndex].first, m_items[i].first))
+                {
+                    detail::staticHashMapDuplicateKey();
+                }
+                bucketIndex = (bucketIndex + 1) & (k_NumBuckets - 1);
+                probeLength++;
+            }
+            m_slots[bucketIndex] = uint16_t(i);
+            maxProbeLength = std::max(maxProbeLength, probeLength);
+        }
+        return maxProbeLength;
+    }
+
+    std::array<KeyValue, kNumItems> m_items;
+    std::array<uint16_t, k_NumBuckets> m_slots;
+    uint64_t m_seed = 0;
+    uint32_t m_maxProbeLength = 0;
+};
+
+// Excalibur::makeStaticHashMap<std::string_view, int>({{"one", 1}, {"two", 2}})
+template <typename TKey, typename TValue, typename TKeyInfo = StaticKeyInfo<TKey>, size_t kNumItems>
+constexpr StaticHashMap<TKey, TValue, kNumItems, TKeyInfo> makeStaticHashMap(const std::pair<TKey, TValue> (&items)[kNumItems])
+{
+    return StaticHashMap<TKey, TValue, kNumItems, TKeyInfo>(items);
+}
+
+} // namespace Excalibur
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+// note: included by ExcaliburHash.h (after the EXLBR_* macros are defined), don't include directly
+
+namespace Excalibur
+{
+
+namespace detail
+{
+
+//
+// Building blocks shared by the hash tables (HashTable, GroupHashTable, SplitHashTable)
+//
+
+// 75% load factor (elements + tombstones), same as HashTable
+[[nodiscard]] inline uint32_t getGrowthThreshold(uint32_t numBuckets) noexcept { return (numBuckets >> 1) + (numBuckets >> 2); }
+
+// if at least half of the occupied slots are tombstones, rehash in place instead of growing
+[[nodiscard]] inline uint32_t getGrowSize(uint32_t numBuckets, uint32_t numElements, uint32_t numTombstones, bool hasStorage,
+                                          uint32_t minNumBuckets) noexcept
+{
+    if (numTombstones >= numElements && hasStorage)
+    {
+        return numBuckets;
+    }
+    return std::max(numBuckets * 2, minNumBuckets);
+}
+
+[[nodiscard]] inline size_t alignSize(size_t cursor, size_t alignment) noexcept { return (cursor + (alignment - 1)) & ~(alignment - 1); }
+
+[[nodiscard]] inline uint32_t nextPow2(uint32_t v) noexcept
+{
+    EXLBR_ASSERT(v != 0);
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    v++;
+    return v;
+}
+
+// Rehash into a new storage of 'numBucketsNew' buckets. TTable provides (TableRehash has to be a friend)
+//   TStorage getStorage() const;                 current storage (pointers + number of buckets)
+//   void create(uint32_t numBuckets);            switches to a new empty storage, the old one is left untouched
+//   void moveItemsAndFree(const TStorage& old);  moves all items out of the old storage and frees it
+struct TableRehash
+{
+    template <typename TTable> static inline void resize(TTable& ht, uint32_t numBucketsNew)
+    {
+        const auto oldStorage = ht.getStorage();
+        ht.create(numBucketsNew);
+        ht.moveItemsAndFree(oldStorage);
+    }
+
+    // 'insertFunc' inserts a new item before the old ones are moved (one of the args might still point to the old storage)
+    template <typename TTable, typename TInsertFunc> static inline auto resizeAndInsert(TTable& ht, uint32_t numBucketsNew, TInsertFunc&& insertFunc)
+    {
+        const auto oldStorage = ht.getStorage();
+        ht.create(numBucketsNew);
+        auto res = insertFunc();
+        ht.moveItemsAndFree(oldStorage);
+        return res;
+    }
+};
+
+// first slot of a cyclic iteration (see TableIterators), takes no space otherwise
+template <typename TSlot, bool kIsCyclic> struct IterationStartHolder
+{
+    explicit IterationStartHolder(TSlot* /*startSlot*/) noexcept {}
+    [[nodiscard]] static inline constexpr TSlot* getStartSlot() noexcept { return nullptr; }
+};
+
+template <typename TSlot> struct IterationStartHolder<TSlot, true>
+{
+    explicit IterationStartHolder(TSlot* startSlot) noexcept
+        : m_startSlot(startSlot)
+    {
+    }
+    [[nodiscard]] inline TSlot* getStartSlot() const noexcept { return m_startSlot; }
+
+  private:
+    TSlot* m_startSlot;
+};
+
+// Iterators over the slots of a table. TTable provides (TableIterators has to be a friend)
+//   TSlot* getFirstSlot() const;                       first slot of the storage
+//   TSlot* getEndSlot() const;                         one past the last slot
+//   TSlot* findValidSlot(TSlot* slot) const;           first valid slot in [slot, end) or end
+//   const TKey* getSlotKey(TSlot* slot) const;
+//   const TValue* getSlotValue(TSlot* slot) const;
+//
+// kIsCyclic = true iterates from a start slot to the end, then from the first slot up to the start slot (see HashTable with
+// RobinHoodProbing). Iterators that don't come from begin() have no start slot and go to the end only. TTable also provides
+//   TSlot* getIterationStart() const;
+//   TSlot* findValidSlot(TSlot* slot, TSlot* endSlot) const;  first valid slot in [slot, endSlot) or endSlot
+template <typename TTable, typename TSlot, typename TKey, typename TValue, bool kIsCyclic = false> struct TableIterators
+{
+    // the slot after 'slot' in iteration order or end
+    [[nodiscard]] static TSlot* getNextSlot(const TTable* ht, TSlot* slot, TSlot* startSlot) noexcept
+    {
+        if constexpr (kIsCyclic)
+        {
+            if (startSlot != nullptr)
+            {
+                TSlot* const endSlot = ht->getEndSlot();
+                TSlot* nextSlot = (slot < startSlot) ? ht->findValidSlot(slot + 1, startSlot) : ht->findValidSlot(slot + 1, endSlot);
+                if (slot >= startSlot && nextSlot == endSlot)
+                {
+                    nextSlot = ht->findValidSlot(ht->getFirstSlot(), startSlot);
+                }
+                return (nextSlot == startSlot) ? endSlot : nextSlot;
+            }
+        }
+        (void)startSlot;
+        return ht->findValidSlot(slot + 1);
+    }
+
+    class IteratorBase : protected IterationStartHolder<TSlot, kIsCyclic>
+    {
+        using TStartHolder = IterationStartHolder<TSlot, kIsCyclic>;
+
+      protected:
+        [[nodiscard]] inline const TKey* getKey() const noexcept { return m_ht->getSlotKey(m_slot); }
+        [[nodiscard]] inline const TValue* getValue() const noexcept { return m_ht->getSlotValue(m_slot); }
+
+        void copyFrom(const IteratorBase& other)
+        {
+            TStartHolder::operator=(other);
+            m_ht = other.m_ht;
+            m_slot = other.m_slot;
+        }
+
+      public:
+        IteratorBase() = delete;
+
+        IteratorBase(const IteratorBase& other) noexcept
+            : TStartHolder(other)
+            , m_ht(other.m_ht)
+            , m_slot(other.m_slot)
+        {
+        }
+
+        IteratorBase(const TTable* ht, TSlot* slot, TSlot* startSlot = nullptr) noexcept
+            : TStartHolder(startSlot)
+            , m_ht(ht)
+            , m_slot(slot)
+        {
+        }
+
+        bool operator==(const IteratorBase& other) const noexcept
+        {
+            // note: m_ht comparison is redundant and hence skipped
+            return m_slot == other.m_slot;
+        }
+        bool operator!=(const IteratorBase& other) const noexcept
+        {
+            // note: m_ht comparison is redundant and hence skipped
+            return m_slot != other.m_slot;
+        }
+
+        IteratorBase& operator++() noexcept
+        {
+            m_slot = getNextSlot(m_ht, m_slot, this->getStartSlot());
+            return *this;
+        }
+
+        IteratorBase operator++(int) noexcept
+        {
+            IteratorBase res = *this;
+            ++*this;
+            return res;
+        }
+
+      protected:
+        const TTable* m_ht;
+        TSlot* m_slot;
+        friend TTable;
+    };
+
+    class IteratorK : public IteratorBase
+    {
+      public:
+        IteratorK() = delete;
+
+        IteratorK(const TTable* ht, TSlot* slot, TSlot* startSlot = nullptr) noexcept
+            : IteratorBase(ht, slot, startSlot)
+        {
+        }
+
+        [[nodiscard]] inline const TKey& operator*() const noexcept { return *IteratorBase::getKey(); }
+        [[nodiscard]] inline const TKey* operator->() const noexcept { return IteratorBase::getKey(); }
+    };
+
+    template <typename TIteratorValue> class TIteratorV : public IteratorBase
+    {
+      public:
+        TIteratorV() = delete;
+
+        TIteratorV(const TTable* ht, TSlot* slot, TSlot* startSlot = nullptr) noexcept
+            : IteratorBase(ht, slot, startSlot)
+        {
+        }
+
+        [[nodiscard]] inline TIteratorValue& operator*() const noexcept { return *const_cast<TIteratorValue*>(IteratorBase::getValue()); }
+        [[nodiscard]] inline TIteratorValue* operator->() const noexcept { return const_cast<TIteratorValue*>(IteratorBase::getValue()); }
+    };
+
+    template <typename TIteratorValue> class TIteratorKV : public IteratorBase
+    {
+      public:
+        // pretty much similar to std::reference_wrapper, but supports late initialization
+        template <typename TYPE> struct reference
+        {
+            TYPE* ptr = nullptr;
+
+            explicit reference(TYPE* _ptr) noexcept
+                : ptr(_ptr)
+            {
+            }
+
+            reference(const reference&) noexcept = default;
+            reference(reference&&) noexcept = default;
+            reference& operator=(const reference&) noexcept = default;
+            reference& operator=(reference&&) noexcept = default;
+            void set(TYPE* _ptr) noexcept { ptr = _ptr; }
+            TYPE& get() const noexcept
+            {
+                EXLBR_ASSERT(ptr);
+                return *ptr;
+            }
+
+            operator TYPE&() const noexcept { return get(); }
+        };
+
+        using KeyValue = std::pair<const reference<const TKey>, const reference<TIteratorValue>>;
+
+      private:
+        void updateTmpKV() const noexcept
+        {
+            const reference<const TKey>& refKey = tmpKv.first;
+            const_cast<reference<const TKey>&>(refKey).set(IteratorBase::getKey());
+            const reference<TIteratorValue>& refVal = tmpKv.second;
+            const_cast<reference<TIteratorValue>&>(refVal).set(const_cast<TIteratorValue*>(IteratorBase::getValue()));
+        }
+
+      public:
+        TIteratorKV() = delete;
+
+        TIteratorKV(const TIteratorKV& other)
+            : IteratorBase(other)
+            , tmpKv(reference<const TKey>(nullptr), reference<TIteratorValue>(nullptr))
+        {
+        }
+
+        TIteratorKV& operator=(const TIteratorKV& other) noexcept
+        {
+            IteratorBase::copyFrom(other);
+            // note: we'll automatically update tmpKv on the next access = no need to copy
+            return *this;
+        }
+
+        TIteratorKV(const TTable* ht, TSlot* slot, TSlot* startSlot = nullptr) noexcept
+            : IteratorBase(ht, slot, startSlot)
+            , tmpKv(reference<const TKey>(nullptr), reference<TIteratorValue>(nullptr))
+        {
+        }
+
+        [[nodiscard]] inline const TKey& key() const noexcept { return *IteratorBase::getKey(); }
+        [[nodiscard]] inline TIteratorValue& value() const noexcept { return *const_cast<TIteratorValue*>(IteratorBase::getValue()); }
+        [[nodiscard]] inline KeyValue& operator*() const noexcept
+        {
+            updateTmpKV();
+            return tmpKv;
+        }
+
+        [[nodiscard]] inline KeyValue* operator->() const noexcept
+        {
+            updateTmpKV();
+            return &tmpKv;
+        }
+
+      private:
+        mutable KeyValue tmpKv;
+    };
+
+    template <typename TIterator> [[nodiscard]] static TIterator begin(const TTable& ht) noexcept
+    {
+        if (ht.empty())
+        {
+            return end<TIterator>(ht);
+        }
+        if constexpr (kIsCyclic)
+        {
+            TSlot* const startSlot = ht.getIterationStart();
+            TSlot* const endSlot = ht.getEndSlot();
+            TSlot* slot = ht.findValidSlot(startSlot, endSlot);
+            if (slot == endSlot)
+            {
+                slot = ht.findValidSlot(ht.getFirstSlot(), startSlot);
+                slot = (slot == startSlot) ? endSlot : slot;
+            }
+            return TIterator(&ht, slot, startSlot);
+        }
+        return TIterator(&ht, ht.findValidSlot(ht.getFirstSlot()));
+    }
+
+    template <typename TIterator> [[nodiscard]] static TIterator end(const TTable& ht) noexcept { return TIterator(&ht, ht.getEndSlot()); }
+
+    template <typename TIterator> struct TypedIteratorHelper
+    {
+        const TTable* ht;
+        TypedIteratorHelper(const TTable* _ht)
+            : ht(_ht)
+        {
+        }
+        TIterator begin() { return TableIterators::begin<TIterator>(*ht); }
+        TIterator end() { return TableIterators::end<TIterator>(*ht); }
+    };
+};
+
+} // namespace detail
+
+} // namespace Excalibur
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #if defined(_MSC_VER)
     #define EXLBR_VISUAL_STUDIO (1)
@@ -107,6 +109,152 @@ inline size_t hash(uint32_t v)
 inline size_t hash(int64_t v) { return hash(uint64_t(v)); }
 inline size_t hash(int32_t v) { return hash(uint32_t(v)); }
 
+//
+// Byte-stream hash: wyhash 'final4' (https://github.com/wangyi-fudan/wyhash), 64-bit output on every platform
+//
+
+// lo/hi halves of the 128-bit product a * b
+inline void _mum(uint64_t* a, uint64_t* b)
+{
+#if EXLBR_64 && defined(EXLBR_VISUAL_STUDIO)
+    *a = _umul128(*a, *b, b);
+#elif EXLBR_64 && (defined(EXLBR_CLANG) || defined(EXLBR_GCC))
+    __uint128_t r = *a;
+    r *= *b;
+    *a = (uint64_t)(r);
+    *b = (uint64_t)(r >> 64U);
+#else
+    const uint64_t ha = *a >> 32U, hb = *b >> 32U, la = (uint32_t)*a, lb = (uint32_t)*b;
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32U);
+    uint64_t c = t < rl;
+    const uint64_t lo = t + (rm1 << 32U);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32U) + (rm1 >> 32U) + c;
+#endif
+}
+
+inline uint64_t _mix(uint64_t a, uint64_t b)
+{
+    _mum(&a, &b);
+    return a ^ b;
+}
+
+// little-endian reads
+inline uint64_t _read8(const uint8_t* p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+inline uint64_t _read4(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+// 1..3 bytes
+inline uint64_t _read3(const uint8_t* p, size_t len) { return (((uint64_t)p[0]) << 16U) | (((uint64_t)p[len >> 1U]) << 8U) | p[len - 1]; }
+
+static constexpr uint64_t k_Secret[4] = {UINT64_C(0x2d358dccaa6c78a5), UINT64_C(0x8bb84b93962eacc9), UINT64_C(0x4b33a62ed433d4a3),
+                                         UINT64_C(0x4d5a2da51de1aa47)};
+
+inline uint64_t hashBytes64(const void* data, size_t len, uint64_t seed = 0)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    seed ^= _mix(seed ^ k_Secret[0], k_Secret[1]);
+    uint64_t a, b;
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // two (possibly overlapping) pairs of 4-byte reads cover 4..16 bytes
+            const size_t offset = (len >> 3U) << 2U;
+            a = (_read4(p) << 32U) | _read4(p + offset);
+            b = (_read4(p + len - 4) << 32U) | _read4(p + len - 4 - offset);
+        }
+        else if (len > 0)
+        {
+            a = _read3(p, len);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+        if (i >= 48)
+        {
+            // three independent lanes
+            uint64_t seed1 = seed, seed2 = seed;
+            do
+            {
+                seed = _mix(_read8(p) ^ k_Secret[1], _read8(p + 8) ^ seed);
+                seed1 = _mix(_read8(p + 16) ^ k_Secret[2], _read8(p + 24) ^ seed1);
+                seed2 = _mix(_read8(p + 32) ^ k_Secret[3], _read8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (i > 16)
+        {
+            seed = _mix(_read8(p) ^ k_Secret[1], _read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        // the last 16 bytes (overlapping the previous block if needed)
+        a = _read8(p + i - 16);
+        b = _read8(p + i - 8);
+    }
+    a ^= k_Secret[1];
+    b ^= seed;
+    _mum(&a, &b);
+    return _mix(a ^ k_Secret[0] ^ len, b ^ k_Secret[1]);
+}
+
+inline size_t hashBytes(const void* data, size_t len, uint64_t seed = 0)
+{
+#if EXLBR_64
+    return size_t(hashBytes64(data, len, seed));
+#elif EXLBR_32
+    const uint64_t h = hashBytes64(data, len, seed);
+    return size_t((uint32_t)(h >> 32U) ^ (uint32_t)(h));
+#else
+    #error Unsupported platform. Only 64/32-bit platforms supported
+#endif
+}
+
+// Seeded integer hash: a full wyhash round (key and seed multiplied, then mixed again), so bucket collisions can't be predicted without the seed
+inline size_t hash(uint64_t v, uint64_t seed)
+{
+    uint64_t a = v ^ k_Secret[1];
+    uint64_t b = seed ^ k_Secret[0];
+    _mum(&a, &b);
+    const uint64_t h = _mix(a ^ k_Secret[0], b ^ k_Secret[1]);
+#if EXLBR_64
+    return size_t(h);
+#elif EXLBR_32
+    return size_t((uint32_t)(h >> 32U) ^ (uint32_t)(h));
+#else
+    #error Unsupported platform. Only 64/32-bit platforms supported
+#endif
+}
+
 } // namespace wyhash
 
-} // namespace Excalibur
\ No newline at end of file
+} // namespace Excalibur
+
+// hashN (bulk hashing with runtime-dispatched SIMD kernels)
+#include "ExcaliburSimd.h"
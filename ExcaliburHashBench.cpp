@@ -0,0 +1,121 @@
+#include "ExcaliburHashBench.h"
+#include <string.h>
+
+namespace
+{
+
+void writeJsonString(FILE* out, const std::string& str)
+{
+    fputc('"', out);
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', out);
+        }
+        fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+void writeResults(FILE* out, const ExcaliburBench::BenchOptions& options, const std::vector<ExcaliburBench::BenchResult>& results)
+{
+    if (options.format == ExcaliburBench::OutputFormat::Csv)
+    {
+        fprintf(out, "bench,variant,param_name,param,value,unit\n");
+        for (const ExcaliburBench::BenchResult& res : results)
+        {
+            fprintf(out, "%s,\"%s\",%s,%llu,%.6f,%s\n", res.bench.c_str(), res.variant.c_str(), res.paramName.c_str(),
+                    (unsigned long long)res.param, res.value, res.unit.c_str());
+        }
+        return;
+    }
+
+    fprintf(out, "{\n  \"quick\": %s,\n  \"results\": [", options.quick ? "true" : "false");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const ExcaliburBench::BenchResult& res = results[i];
+        fprintf(out, "%s\n    {\"bench\": ", (i == 0) ? "" : ",");
+        writeJsonString(out, res.bench);
+        fprintf(out, ", \"variant\": ");
+        writeJsonString(out, res.variant);
+        fprintf(out, ", \"param_name\": ");
+        writeJsonString(out, res.paramName);
+        fprintf(out, ", \"param\": %llu, \"value\": %.6f, \"unit\": ", (unsigned long long)res.param, res.value);
+        writeJsonString(out, res.unit);
+        fprintf(out, "}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ExcaliburBench::BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            options.quick = true;
+        }
+        else if (strncmp(argv[i], "--filter=", 9) == 0)
+        {
+            options.filter = argv[i] + 9;
+        }
+        else if (strcmp(argv[i], "--format=csv") == 0)
+        {
+            options.format = ExcaliburBench::OutputFormat::Csv;
+        }
+        else if (strcmp(argv[i], "--format=json") == 0)
+        {
+            options.format = ExcaliburBench::OutputFormat::Json;
+        }
+        else if (strcmp(argv[i], "--format=text") == 0)
+        {
+            options.format = ExcaliburBench::OutputFormat::Text;
+        }
+        else if (strncmp(argv[i], "--out=", 6) == 0)
+        {
+            options.outputPath = argv[i] + 6;
+        }
+        else if (strncmp(argv[i], "--data=", 7) == 0)
+        {
+            options.dataPath = argv[i] + 7;
+        }
+        else
+        {
+            printf("Usage: %s [--quick] [--filter=<substring>] [--format=text|csv|json] [--out=<file>] [--data=<random.bin>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<ExcaliburBench::BenchResult> results;
+    for (const ExcaliburBench::BenchEntry& entry : ExcaliburBench::getBenchRegistry())
+    {
+        if (!options.filter.empty() && strstr(entry.name, options.filter.c_str()) == nullptr)
+        {
+            continue;
+        }
+        ExcaliburBench::BenchContext ctx(entry.name, options, results);
+        entry.func(ctx);
+    }
+
+    if (options.format == ExcaliburBench::OutputFormat::Text)
+    {
+        return 0;
+    }
+
+    FILE* out = options.outputPath.empty() ? stdout : fopen(options.outputPath.c_str(), "w");
+    if (out == nullptr)
+    {
+        fprintf(stderr, "Can't open '%s' for writing\n", options.outputPath.c_str());
+        return 1;
+    }
+    writeResults(out, options, results);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(EXLBR_BENCH_DATA_DIR)
+    #define EXLBR_BENCH_DATA_DIR "data"
+#endif
+
+namespace ExcaliburBench
+{
+
+enum class OutputFormat
+{
+    Text,
+    Csv,
+    Json
+};
+
+struct BenchOptions
+{
+    // substring filter for benchmark names (empty = run everything)
+    std::string filter;
+    // smaller data sets and shorter runs (smoke test)
+    bool quick = false;
+    // machine-readable results are written once all the benchmarks are done
+    OutputFormat format = OutputFormat::Text;
+    // output file for csv/json results (empty = stdout)
+    std::string outputPath;
+    // 1,000,000 unique uint32_t keys used by the README charts
+    std::string dataPath = EXLBR_BENCH_DATA_DIR "/random.bin";
+};
+
+struct BenchResult
+{
+    std::string bench;
+    std::string variant;
+    std::string paramName;
+    uint64_t param;
+    double value;
+    std::string unit;
+};
+
+class BenchContext
+{
+  public:
+    BenchContext(const char* benchName, const BenchOptions& options, std::vector<BenchResult>& results)
+        : m_benchName(benchName)
+        , m_options(options)
+        , m_results(results)
+    {
+    }
+
+    [[nodiscard]] const BenchOptions& getOptions() const { return m_options; }
+    [[nodiscard]] bool isQuick() const { return m_options.quick; }
+
+    void report(const char* variant, const char* paramName, uint64_t param, double value, const char* unit)
+    {
+        // progress goes to stderr if stdout is reserved for machine-readable results
+        FILE* out = (m_options.format != OutputFormat::Text && m_options.outputPath.empty()) ? stderr : stdout;
+        fprintf(out, "%-30s %-32s %s=%-10llu %12.3f %s\n", m_benchName, variant, paramName, (unsigned long long)param, value, unit);
+        fflush(out);
+        m_results.push_back(BenchResult{m_benchName, variant, paramName, param, value, unit});
+    }
+
+  private:
+    const char* m_benchName;
+    const BenchOptions& m_options;
+    std::vector<BenchResult>& m_results;
+};
+
+using BenchFunc = void (*)(BenchContext& ctx);
+
+struct BenchEntry
+{
+    const char* name;
+    BenchFunc func;
+};
+
+inline std::vector<BenchEntry>& getBenchRegistry()
+{
+    static std::vector<BenchEntry> registry;
+    return registry;
+}
+
+struct BenchRegistrar
+{
+    BenchRegistrar(const char* name, BenchFunc func) { getBenchRegistry().push_back(BenchEntry{name, func}); }
+};
+
+class Timer
+{
+  public:
+    Timer()
+        : m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    [[nodiscard]] double getElapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// prevents the compiler from optimizing away the computation of 'value'
+template <typename T> inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+// xorshift64*, fast and deterministic
+inline uint64_t nextRandom(uint64_t& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ull;
+}
+
+// Unique keys from data/random.bin (little-endian uint32_t, sorted) in a deterministic shuffled order.
+// Falls back to generated unique keys if the file is missing, so results are still reproducible but not comparable to the charts.
+inline const std::vector<uint32_t>& loadRandomKeys(const std::string& path)
+{
+    static std::vector<uint32_t> keys;
+    if (!keys.empty())
+    {
+        return keys;
+    }
+
+    if (FILE* file = fopen(path.c_str(), "rb"))
+    {
+        unsigned char bytes[4];
+        while (fread(bytes, 1, 4, file) == 4)
+        {
+            keys.push_back(uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24));
+        }
+        fclose(file);
+    }
+
+    if (keys.empty())
+    {
+        fprintf(stderr, "Warning: can't read '%s' (use --data=<path>), using generated keys instead\n", path.c_str());
+        keys.resize(1000000);
+        for (uint32_t i = 0; i < uint32_t(keys.size()); i++)
+        {
+            // unique (odd multiplier is a bijection), below 2^31 like the keys in random.bin
+            keys[i] = (i * 2654435761u) & 0x7fffffffu;
+        }
+    }
+
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (size_t i = keys.size() - 1; i > 0; i--)
+    {
+        std::swap(keys[i], keys[nextRandom(rnd) % (i + 1)]);
+    }
+    return keys;
+}
+
+} // namespace ExcaliburBench
+
+#define EXLBR_BENCHMARK(name)                                                                                                                        \
+    static void name(ExcaliburBench::BenchContext& ctx);                                                                                             \
+    static ExcaliburBench::BenchRegistrar name##Registrar(#name, name);                                                                              \
+    static void name(ExcaliburBench::BenchContext& ctx)
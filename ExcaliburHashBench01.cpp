@@ -0,0 +1,131 @@
+#include "ExcaliburConcurrentHash.h"
+#include "ExcaliburHashBench.h"
+#include <algorithm>
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct SharedMutexMap
+{
+    Excalibur::HashMap<uint64_t, uint64_t> map;
+    mutable std::shared_mutex lock;
+
+    void emplace(uint64_t key, uint64_t value)
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        map.emplace(key, value);
+    }
+
+    bool find(uint64_t key, uint64_t& value) const
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        auto it = map.find(key);
+        if (it == map.iend())
+        {
+            return false;
+        }
+        value = it.value();
+        return true;
+    }
+};
+
+// runs 'numThreads' readers for 'duration' seconds, returns the total number of lookups per second
+template <typename TMap> double measureReaders(const TMap& map, uint64_t numKeys, uint32_t numThreads, double duration)
+{
+    std::atomic<uint32_t> numReady{0};
+    std::atomic<bool> isRunning{false};
+    std::atomic<bool> isStopped{false};
+    std::atomic<uint64_t> numLookups{0};
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                uint64_t rnd = 0x9E3779B97F4A7C15ull * (t + 1);
+                uint64_t localLookups = 0;
+                uint64_t sum = 0;
+                numReady.fetch_add(1);
+                while (!isRunning.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                while (!isStopped.load(std::memory_order_relaxed))
+                {
+                    for (int i = 0; i < 256; i++)
+                    {
+                        uint64_t value = 0;
+                        const uint64_t key = ExcaliburBench::nextRandom(rnd) % numKeys;
+                        sum += map.find(key, value) ? value : 0;
+                    }
+                    localLookups += 256;
+                }
+                ExcaliburBench::doNotOptimize(sum);
+                numLookups.fetch_add(localLookups);
+            });
+    }
+
+    while (numReady.load() != numThreads)
+    {
+        std::this_thread::yield();
+    }
+    ExcaliburBench::Timer timer;
+    isRunning.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+    isStopped.store(true);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return double(numLookups.load()) / timer.getElapsedSeconds();
+}
+
+std::vector<uint32_t> getThreadCounts()
+{
+    const uint32_t numCores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> res;
+    for (uint32_t n = 1; n < numCores; n *= 2)
+    {
+        res.push_back(n);
+    }
+    res.push_back(numCores);
+    return res;
+}
+
+} // namespace
+
+// Read-only lookup throughput as a function of the number of reader threads.
+// Lock-free readers should scale (close to) linearly, the shared_mutex baseline is limited by the reader-lock cache line.
+EXLBR_BENCHMARK(ConcurrentReaderScaling)
+{
+    const uint64_t numKeys = ctx.isQuick() ? (1ull << 14) : (1ull << 20);
+    const double duration = ctx.isQuick() ? 0.05 : 0.5;
+
+    Excalibur::ConcurrentHashMap<uint64_t, uint64_t> concurrentMap;
+    SharedMutexMap sharedMutexMap;
+    for (uint64_t key = 0; key < numKeys; key++)
+    {
+        concurrentMap.emplace(key, key * 3);
+        sharedMutexMap.emplace(key, key * 3);
+    }
+
+    double baseConcurrent = 0.0;
+    double baseSharedMutex = 0.0;
+    for (uint32_t numThreads : getThreadCounts())
+    {
+        const double concurrent = measureReaders(concurrentMap, numKeys, numThreads, duration);
+        const double sharedMutex = measureReaders(sharedMutexMap, numKeys, numThreads, duration);
+        baseConcurrent = (numThreads == 1) ? concurrent : baseConcurrent;
+        baseSharedMutex = (numThreads == 1) ? sharedMutex : baseSharedMutex;
+
+        ctx.report("ConcurrentHashMap", "threads", numThreads, concurrent / 1e6, "Mops/s");
+        ctx.report("ConcurrentHashMap.speedup", "threads", numThreads, concurrent / baseConcurrent, "x");
+        ctx.report("HashMap+shared_mutex", "threads", numThreads, sharedMutex / 1e6, "Mops/s");
+        ctx.report("HashMap+shared_mutex.speedup", "threads", numThreads, sharedMutex / baseSharedMutex, "x");
+    }
+}
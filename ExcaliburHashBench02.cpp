@@ -0,0 +1,85 @@
+#include "ExcaliburConcurrentHash.h"
+#include "ExcaliburHashBench.h"
+#include "ExcaliburShardedHash.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct MutexMap
+{
+    Excalibur::HashMap<uint64_t, uint64_t> map;
+    std::mutex lock;
+
+    bool emplace(uint64_t key, uint64_t value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return map.emplace(key, value).second;
+    }
+};
+
+// every thread inserts 'numKeysPerThread' unique keys into an empty map (growth included), returns inserts per second
+template <typename TMap> double measureWriters(uint64_t numKeysPerThread, uint32_t numThreads)
+{
+    TMap map;
+    std::atomic<uint32_t> numReady{0};
+    std::atomic<bool> isRunning{false};
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                numReady.fetch_add(1);
+                while (!isRunning.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                uint64_t rnd = 0x9E3779B97F4A7C15ull * (t + 1);
+                for (uint64_t i = 0; i < numKeysPerThread; i++)
+                {
+                    // unique per thread: low bits = thread index
+                    const uint64_t key = ((ExcaliburBench::nextRandom(rnd) >> 16) << 8) | t;
+                    map.emplace(key, i);
+                }
+            });
+    }
+
+    while (numReady.load() != numThreads)
+    {
+        std::this_thread::yield();
+    }
+    ExcaliburBench::Timer timer;
+    isRunning.store(true, std::memory_order_release);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return double(numKeysPerThread * numThreads) / timer.getElapsedSeconds();
+}
+
+} // namespace
+
+// Insert throughput as a function of the number of writer threads.
+EXLBR_BENCHMARK(ConcurrentWriterScaling)
+{
+    const uint64_t numKeysPerThread = ctx.isQuick() ? (1ull << 14) : (1ull << 19);
+    const uint32_t numCores = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t numThreads = 1;; numThreads = std::min(numThreads * 2, numCores))
+    {
+        ctx.report("ShardedHashMap<64>", "threads", numThreads,
+                   measureWriters<Excalibur::ShardedHashMap<uint64_t, uint64_t, 64>>(numKeysPerThread, numThreads) / 1e6, "Mops/s");
+        ctx.report("ConcurrentHashMap", "threads", numThreads,
+                   measureWriters<Excalibur::ConcurrentHashMap<uint64_t, uint64_t>>(numKeysPerThread, numThreads) / 1e6, "Mops/s");
+        ctx.report("HashMap+mutex", "threads", numThreads, measureWriters<MutexMap>(numKeysPerThread, numThreads) / 1e6, "Mops/s");
+        if (numThreads == numCores)
+        {
+            break;
+        }
+    }
+}
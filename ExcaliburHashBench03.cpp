@@ -0,0 +1,62 @@
+#include "ExcaliburAllocators.h"
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+
+namespace
+{
+
+template <typename TAllocator>
+using BenchHashMap = Excalibur::HashMap<uint64_t, uint64_t, 1, Excalibur::KeyInfo<uint64_t>, Excalibur::LinearProbing, TAllocator>;
+
+// build a table from scratch (all intermediate growth steps included) and throw it away, 'numRounds' times
+template <typename TAllocator, typename TMakeAllocator, typename TEndOfRound>
+double measureClearAndInsert(uint64_t numKeys, uint32_t numRounds, TMakeAllocator&& makeAllocator, TEndOfRound&& endOfRound)
+{
+    uint64_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (uint32_t round = 0; round < numRounds; round++)
+    {
+        {
+            BenchHashMap<TAllocator> ht(makeAllocator());
+            uint64_t rnd = 0x9E3779B97F4A7C15ull + round;
+            for (uint64_t i = 0; i < numKeys; i++)
+            {
+                ht.emplace(ExcaliburBench::nextRandom(rnd) >> 2, i);
+            }
+            sum += ht.size();
+        }
+        endOfRound();
+    }
+    ExcaliburBench::doNotOptimize(sum);
+    return timer.getElapsedSeconds() * 1e9 / (double(numKeys) * numRounds);
+}
+
+} // namespace
+
+// ClearAndInsert-style workload (a fresh table every round) with different allocation policies
+EXLBR_BENCHMARK(ClearAndInsertAllocators)
+{
+    const uint64_t numOpsPerSize = ctx.isQuick() ? (1ull << 16) : (1ull << 22);
+    for (uint64_t numKeys : {64ull, 1024ull, 16384ull, 262144ull})
+    {
+        const uint32_t numRounds = uint32_t(std::max(uint64_t(1), numOpsPerSize / numKeys));
+
+        const double nsDefault = measureClearAndInsert<Excalibur::DefaultAllocator>(
+            numKeys, numRounds, []() { return Excalibur::DefaultAllocator(); }, []() {});
+        ctx.report("DefaultAllocator", "keys", numKeys, nsDefault, "ns/insert");
+
+        Excalibur::Arena arena;
+        const double nsArena = measureClearAndInsert<Excalibur::ArenaAllocator>(
+            numKeys, numRounds, [&arena]() { return Excalibur::ArenaAllocator(arena); }, [&arena]() { arena.reset(); });
+        ctx.report("ArenaAllocator", "keys", numKeys, nsArena, "ns/insert");
+
+        Excalibur::Pool pool;
+        const double nsPool = measureClearAndInsert<Excalibur::PoolAllocator>(
+            numKeys, numRounds, [&pool]() { return Excalibur::PoolAllocator(pool); }, []() {});
+        ctx.report("PoolAllocator", "keys", numKeys, nsPool, "ns/insert");
+
+        const double nsHugePages = measureClearAndInsert<Excalibur::HugePageAllocator>(
+            numKeys, numRounds, []() { return Excalibur::HugePageAllocator(); }, []() {});
+        ctx.report("HugePageAllocator", "keys", numKeys, nsHugePages, "ns/insert");
+    }
+}
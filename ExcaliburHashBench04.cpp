@@ -0,0 +1,84 @@
+#include "ExcaliburAllocators.h"
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+template <typename TAllocator>
+using BenchHashMap = Excalibur::HashMap<uint64_t, uint64_t, 1, Excalibur::KeyInfo<uint64_t>, Excalibur::LinearProbing, TAllocator>;
+
+uint64_t getNumaNodeMask()
+{
+    uint64_t mask = 0;
+    for (int node = 0; node < 64; node++)
+    {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        mask |= file.good() ? (uint64_t(1) << node) : 0;
+    }
+    return mask;
+}
+
+// random lookups of existing keys, returns nanoseconds per lookup
+template <typename TAllocator> double measureRandomLookups(uint64_t numKeys, uint64_t numLookups, const TAllocator& allocator)
+{
+    BenchHashMap<TAllocator> ht(allocator);
+    ht.reserve(uint32_t(numKeys * 2));
+    for (uint64_t key = 0; key < numKeys; key++)
+    {
+        ht.emplace(key, key);
+    }
+
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    uint64_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (uint64_t i = 0; i < numLookups; i++)
+    {
+        const uint64_t key = ExcaliburBench::nextRandom(rnd) % numKeys;
+        auto it = ht.find(key);
+        sum += (it != ht.iend()) ? it.value() : 0;
+    }
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(sum);
+    return elapsed * 1e9 / double(numLookups);
+}
+
+} // namespace
+
+// Random lookups on tables from LLC-sized to much larger than the LLC with regular pages vs huge pages (and NUMA interleaving).
+EXLBR_BENCHMARK(RandomLookupHugePages)
+{
+    const uint64_t numLookups = ctx.isQuick() ? (1ull << 18) : (1ull << 24);
+    const uint64_t numaNodeMask = getNumaNodeMask();
+
+    for (uint64_t numKeys : {1ull << 16, 1ull << 20, 1ull << 22, 1ull << 24})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 20))
+        {
+            break;
+        }
+
+        ctx.report("DefaultAllocator", "keys", numKeys, measureRandomLookups(numKeys, numLookups, Excalibur::DefaultAllocator()), "ns/lookup");
+
+        Excalibur::HugePageOptions options;
+        options.mode = Excalibur::HugePageMode::Transparent;
+        ctx.report("HugePages(transparent)", "keys", numKeys,
+                   measureRandomLookups(numKeys, numLookups, Excalibur::HugePageAllocator(options)), "ns/lookup");
+
+        options.mode = Excalibur::HugePageMode::Explicit;
+        ctx.report("HugePages(explicit)", "keys", numKeys, measureRandomLookups(numKeys, numLookups, Excalibur::HugePageAllocator(options)),
+                   "ns/lookup");
+
+        // only meaningful on multi-socket machines
+        if (numaNodeMask & (numaNodeMask - 1))
+        {
+            options.mode = Excalibur::HugePageMode::Transparent;
+            options.numaPolicy = Excalibur::NumaPolicy::Interleave;
+            options.numaNodeMask = numaNodeMask;
+            ctx.report("HugePages(interleave)", "keys", numKeys,
+                       measureRandomLookups(numKeys, numLookups, Excalibur::HugePageAllocator(options)), "ns/lookup");
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using BenchHashMap = Excalibur::HashMap<uint64_t, uint64_t>;
+
+constexpr size_t kBatchSize = 256;
+
+std::vector<uint64_t> makeLookupKeys(uint64_t numKeys, uint64_t numLookups, bool isExisting)
+{
+    std::vector<uint64_t> keys(numLookups);
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    for (uint64_t& key : keys)
+    {
+        // existing keys are [0, numKeys), non existing keys are [numKeys, 2 * numKeys)
+        key = ExcaliburBench::nextRandom(rnd) % numKeys + (isExisting ? 0 : numKeys);
+    }
+    return keys;
+}
+
+double measureFind(const BenchHashMap& ht, const std::vector<uint64_t>& keys)
+{
+    uint64_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (uint64_t key : keys)
+    {
+        auto it = ht.find(key);
+        sum += (it != ht.iend()) ? it.value() : 1;
+    }
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(sum);
+    return elapsed * 1e9 / double(keys.size());
+}
+
+double measureFindBatch(const BenchHashMap& ht, const std::vector<uint64_t>& keys)
+{
+    std::vector<BenchHashMap::ConstIteratorKV> out(kBatchSize, ht.iend());
+    uint64_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (size_t base = 0; base < keys.size(); base += kBatchSize)
+    {
+        const size_t count = std::min(kBatchSize, keys.size() - base);
+        ht.findBatch(keys.data() + base, count, out.data());
+        for (size_t i = 0; i < count; i++)
+        {
+            sum += (out[i] != ht.iend()) ? out[i].value() : 1;
+        }
+    }
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(sum);
+    return elapsed * 1e9 / double(keys.size());
+}
+
+double measureHasBatch(const BenchHashMap& ht, const std::vector<uint64_t>& keys)
+{
+    std::unique_ptr<bool[]> out(new bool[kBatchSize]);
+    size_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (size_t base = 0; base < keys.size(); base += kBatchSize)
+    {
+        sum += ht.hasBatch(keys.data() + base, std::min(kBatchSize, keys.size() - base), out.get());
+    }
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(sum);
+    return elapsed * 1e9 / double(keys.size());
+}
+
+void runSearch(ExcaliburBench::BenchContext& ctx, bool isExisting)
+{
+    const uint64_t numLookups = ctx.isQuick() ? (1ull << 18) : (1ull << 23);
+    for (uint64_t numKeys : {1ull << 12, 1ull << 16, 1ull << 20, 1ull << 23})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 20))
+        {
+            break;
+        }
+
+        BenchHashMap ht;
+        for (uint64_t key = 0; key < numKeys; key++)
+        {
+            ht.emplace(key, key);
+        }
+        const std::vector<uint64_t> keys = makeLookupKeys(numKeys, numLookups, isExisting);
+
+        ctx.report("find", "keys", numKeys, measureFind(ht, keys), "ns/lookup");
+        ctx.report("findBatch", "keys", numKeys, measureFindBatch(ht, keys), "ns/lookup");
+        ctx.report("hasBatch", "keys", numKeys, measureHasBatch(ht, keys), "ns/lookup");
+    }
+}
+
+} // namespace
+
+EXLBR_BENCHMARK(SearchExistingBatched) { runSearch(ctx, true); }
+
+EXLBR_BENCHMARK(SearchNonExistingBatched) { runSearch(ctx, false); }
@@ -0,0 +1,70 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <vector>
+
+namespace
+{
+
+using BenchHashMap = Excalibur::HashMap<uint64_t, uint64_t>;
+
+std::vector<std::pair<uint64_t, uint64_t>> makeItems(uint64_t numItems)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> items(numItems);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (uint64_t i = 0; i < numItems; i++)
+    {
+        items[i] = std::make_pair(ExcaliburBench::nextRandom(rnd) >> 2, i);
+    }
+    return items;
+}
+
+template <typename TFunc> double measureLoad(const std::vector<std::pair<uint64_t, uint64_t>>& items, TFunc&& load)
+{
+    ExcaliburBench::Timer timer;
+    BenchHashMap ht;
+    load(ht);
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(ht.size());
+    return elapsed * 1e9 / double(items.size());
+}
+
+} // namespace
+
+// Cold start bulk load into an empty table
+EXLBR_BENCHMARK(BulkLoad)
+{
+    for (uint64_t numItems : {1ull << 16, 1ull << 20, 1ull << 23})
+    {
+        if (ctx.isQuick() && numItems > (1ull << 16))
+        {
+            break;
+        }
+        const std::vector<std::pair<uint64_t, uint64_t>> items = makeItems(numItems);
+
+        ctx.report("emplace", "items", numItems,
+                   measureLoad(items,
+                               [&items](BenchHashMap& ht)
+                               {
+                                   for (const auto& item : items)
+                                   {
+                                       ht.emplace(item.first, item.second);
+                                   }
+                               }),
+                   "ns/item");
+
+        ctx.report("reserve+emplace", "items", numItems,
+                   measureLoad(items,
+                               [&items](BenchHashMap& ht)
+                               {
+                                   ht.reserve(uint32_t(items.size() * 4 / 3 + 1));
+                                   for (const auto& item : items)
+                                   {
+                                       ht.emplace(item.first, item.second);
+                                   }
+                               }),
+                   "ns/item");
+
+        ctx.report("insertBatch", "items", numItems,
+                   measureLoad(items, [&items](BenchHashMap& ht) { ht.insertBatch(items.begin(), items.end()); }), "ns/item");
+    }
+}
@@ -0,0 +1,62 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include "ExcaliburSplitHash.h"
+#include <array>
+#include <vector>
+
+namespace
+{
+
+template <size_t kValueSize> using BenchValue = std::array<uint64_t, kValueSize / sizeof(uint64_t)>;
+
+// random lookups, half of the keys exist; returns nanoseconds per lookup
+template <typename THashMap> double measureLookups(uint64_t numKeys, const std::vector<uint64_t>& lookupKeys)
+{
+    THashMap ht;
+    for (uint64_t key = 0; key < numKeys; key++)
+    {
+        ht[key][0] = key;
+    }
+
+    uint64_t sum = 0;
+    ExcaliburBench::Timer timer;
+    for (uint64_t key : lookupKeys)
+    {
+        auto it = ht.find(key);
+        sum += (it != ht.iend()) ? it.value()[0] : 1;
+    }
+    const double elapsed = timer.getElapsedSeconds();
+    ExcaliburBench::doNotOptimize(sum);
+    return elapsed * 1e9 / double(lookupKeys.size());
+}
+
+template <size_t kValueSize> void runValueSize(ExcaliburBench::BenchContext& ctx, uint64_t numKeys, const std::vector<uint64_t>& lookupKeys)
+{
+    using Value = BenchValue<kValueSize>;
+    ctx.report("HashMap", "valueBytes", kValueSize, measureLookups<Excalibur::HashMap<uint64_t, Value>>(numKeys, lookupKeys), "ns/lookup");
+    ctx.report("SplitHashMap", "valueBytes", kValueSize, measureLookups<Excalibur::SplitHashMap<uint64_t, Value>>(numKeys, lookupKeys),
+               "ns/lookup");
+}
+
+} // namespace
+
+// Interleaved (HashMap) vs split keys/values (SplitHashMap) layout for different value sizes
+EXLBR_BENCHMARK(LookupValueSize)
+{
+    const uint64_t numKeys = ctx.isQuick() ? (1ull << 14) : (1ull << 20);
+    const uint64_t numLookups = ctx.isQuick() ? (1ull << 18) : (1ull << 23);
+
+    std::vector<uint64_t> lookupKeys(numLookups);
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    for (uint64_t& key : lookupKeys)
+    {
+        key = ExcaliburBench::nextRandom(rnd) % (numKeys * 2);
+    }
+
+    runValueSize<8>(ctx, numKeys, lookupKeys);
+    runValueSize<16>(ctx, numKeys, lookupKeys);
+    runValueSize<32>(ctx, numKeys, lookupKeys);
+    runValueSize<64>(ctx, numKeys, lookupKeys);
+    runValueSize<128>(ctx, numKeys, lookupKeys);
+    runValueSize<256>(ctx, numKeys, lookupKeys);
+}
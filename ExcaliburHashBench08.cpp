@@ -0,0 +1,77 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// KeyInfo<std::string> without the isEmpty/isTombstone predicates (every probe step compares against freshly built sentinels)
+struct SentinelStringKeyInfo
+{
+    using Base = Excalibur::KeyInfo<std::string>;
+    static inline bool isValid(const std::string& key) noexcept { return Base::isValid(key); }
+    static inline std::string getTombstone() noexcept { return Base::getTombstone(); }
+    static inline std::string getEmpty() noexcept { return Base::getEmpty(); }
+    static inline size_t hash(const std::string& key) noexcept { return Base::hash(key); }
+    static inline bool isEqual(const std::string& lhs, const std::string& rhs) noexcept { return lhs == rhs; }
+};
+
+std::vector<std::string> makeKeys(uint64_t numKeys, uint64_t seed)
+{
+    std::vector<std::string> keys(numKeys);
+    uint64_t rnd = seed;
+    for (std::string& key : keys)
+    {
+        key = "key_" + std::to_string(ExcaliburBench::nextRandom(rnd));
+    }
+    return keys;
+}
+
+// reports nanoseconds per operation for insert, lookup existing and lookup non existing
+template <typename TKeyInfo> void runStringKeys(ExcaliburBench::BenchContext& ctx, const char* variant, uint64_t numKeys)
+{
+    const std::vector<std::string> keys = makeKeys(numKeys, 0x9E3779B97F4A7C15ull);
+    const std::vector<std::string> missingKeys = makeKeys(numKeys, 0x2545F4914F6CDD1Dull);
+
+    Excalibur::HashMap<std::string, uint64_t, 1, TKeyInfo> ht;
+    ExcaliburBench::Timer insertTimer;
+    for (uint64_t i = 0; i < numKeys; i++)
+    {
+        ht.emplace(keys[i], i);
+    }
+    ctx.report(variant, "insert/keys", numKeys, insertTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+
+    for (const auto* lookupKeys : {&keys, &missingKeys})
+    {
+        uint64_t sum = 0;
+        ExcaliburBench::Timer timer;
+        for (int round = 0; round < 4; round++)
+        {
+            for (const std::string& key : *lookupKeys)
+            {
+                auto it = ht.find(key);
+                sum += (it != ht.iend()) ? it.value() : 1;
+            }
+        }
+        ExcaliburBench::doNotOptimize(sum);
+        ctx.report(variant, (lookupKeys == &keys) ? "hit/keys" : "miss/keys", numKeys, timer.getElapsedSeconds() * 1e9 / double(numKeys * 4),
+                   "ns/op");
+    }
+}
+
+} // namespace
+
+// std::string keys: KeyInfo isEmpty/isTombstone predicates vs comparing against sentinel strings
+EXLBR_BENCHMARK(StringKeySentinels)
+{
+    for (uint64_t numKeys : {1ull << 10, 1ull << 16, 1ull << 20})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 16))
+        {
+            break;
+        }
+        runStringKeys<SentinelStringKeyInfo>(ctx, "sentinel compare", numKeys);
+        runStringKeys<Excalibur::KeyInfo<std::string>>(ctx, "predicates", numKeys);
+    }
+}
@@ -0,0 +1,63 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// URL-like keys: a long shared prefix makes both hashing and comparing expensive
+std::vector<std::string> makeUrlKeys(uint64_t numKeys, uint64_t seed)
+{
+    std::vector<std::string> keys(numKeys);
+    uint64_t rnd = seed;
+    for (std::string& key : keys)
+    {
+        key = "https://example.com/static/assets/images/thumbnails/" + std::to_string(ExcaliburBench::nextRandom(rnd)) + ".png";
+    }
+    return keys;
+}
+
+template <typename TKeyInfo> void runUrlKeys(ExcaliburBench::BenchContext& ctx, const char* variant, uint64_t numKeys)
+{
+    const std::vector<std::string> keys = makeUrlKeys(numKeys, 0x9E3779B97F4A7C15ull);
+    const std::vector<std::string> missingKeys = makeUrlKeys(numKeys, 0x2545F4914F6CDD1Dull);
+
+    // insert from scratch (all the intermediate growth steps included)
+    Excalibur::HashMap<std::string, uint64_t, 1, TKeyInfo> ht;
+    ExcaliburBench::Timer insertTimer;
+    for (uint64_t i = 0; i < numKeys; i++)
+    {
+        ht.emplace(keys[i], i);
+    }
+    ctx.report(variant, "insert/keys", numKeys, insertTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+
+    ExcaliburBench::Timer rehashTimer;
+    ht.rehash();
+    ctx.report(variant, "rehash/keys", numKeys, rehashTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/item");
+
+    uint64_t sum = 0;
+    ExcaliburBench::Timer missTimer;
+    for (const std::string& key : missingKeys)
+    {
+        sum += ht.has(key) ? 1 : 0;
+    }
+    ExcaliburBench::doNotOptimize(sum);
+    ctx.report(variant, "miss/keys", numKeys, missTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+}
+
+} // namespace
+
+// Expensive to hash keys with and without a cached hash per item
+EXLBR_BENCHMARK(CachedHashUrlKeys)
+{
+    for (uint64_t numKeys : {1ull << 12, 1ull << 16, 1ull << 20})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 16))
+        {
+            break;
+        }
+        runUrlKeys<Excalibur::KeyInfo<std::string>>(ctx, "KeyInfo", numKeys);
+        runUrlKeys<Excalibur::CachedHashKeyInfo<Excalibur::KeyInfo<std::string>>>(ctx, "CachedHashKeyInfo", numKeys);
+    }
+}
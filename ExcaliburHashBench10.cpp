@@ -0,0 +1,364 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <unordered_map>
+#include <vector>
+
+// The scenarios charted in the README (see the "Benchmark" section for the description of every test).
+// Keys come from data/random.bin, every scenario reports the total time in milliseconds.
+
+namespace
+{
+
+// 'heavyweight' value with a non-trivial constructor
+struct HeavyValue
+{
+    HeavyValue()
+    {
+        for (uint32_t& v : data)
+        {
+            v = 0;
+        }
+    }
+    uint32_t data[16];
+};
+
+inline void bump(uint32_t& value) { value++; }
+inline void bump(uint64_t& value) { value++; }
+inline void bump(HeavyValue& value) { value.data[0]++; }
+
+inline uint64_t getSum(const uint32_t& value) { return value; }
+inline uint64_t getSum(const uint64_t& value) { return value; }
+inline uint64_t getSum(const HeavyValue& value) { return value.data[0]; }
+
+template <typename TMap, typename TKey, typename TValue> struct MapTag
+{
+    using Map = TMap;
+    using Key = TKey;
+    using Value = TValue;
+};
+
+template <typename TKey, typename TValue, unsigned kNumInlineItems, typename TKeyInfo, typename TProbing, typename TAllocator,
+          typename TShrinkPolicy>
+inline const TValue* findValue(const Excalibur::HashTable<TKey, TValue, kNumInlineItems, TKeyInfo, TProbing, TAllocator, TShrinkPolicy>& ht,
+                               const TKey& key)
+{
+    auto it = ht.find(key);
+    return (it != ht.iend()) ? &it.value() : nullptr;
+}
+
+template <typename TKey, typename TValue> inline const TValue* findValue(const std::unordered_map<TKey, TValue>& ht, const TKey& key)
+{
+    auto it = ht.find(key);
+    return (it != ht.end()) ? &it->second : nullptr;
+}
+
+// key/value size sweep, every configuration is compared against std::unordered_map
+template <typename TFunc> void forEachMap(TFunc&& func)
+{
+    func(MapTag<Excalibur::HashMap<uint32_t, uint32_t>, uint32_t, uint32_t>(), "Excalibur::HashMap<u32,u32>");
+    func(MapTag<std::unordered_map<uint32_t, uint32_t>, uint32_t, uint32_t>(), "std::unordered_map<u32,u32>");
+    func(MapTag<Excalibur::HashMap<uint64_t, uint64_t>, uint64_t, uint64_t>(), "Excalibur::HashMap<u64,u64>");
+    func(MapTag<std::unordered_map<uint64_t, uint64_t>, uint64_t, uint64_t>(), "std::unordered_map<u64,u64>");
+    func(MapTag<Excalibur::HashMap<uint32_t, HeavyValue>, uint32_t, HeavyValue>(), "Excalibur::HashMap<u32,64b>");
+    func(MapTag<std::unordered_map<uint32_t, HeavyValue>, uint32_t, HeavyValue>(), "std::unordered_map<u32,64b>");
+}
+
+// inline storage sweep (only matters for tiny and short-lived tables)
+template <typename TFunc> void forEachInlineConfig(TFunc&& func)
+{
+    func(MapTag<Excalibur::HashMap<uint32_t, HeavyValue, 1>, uint32_t, HeavyValue>(), "Excalibur::HashMap<u32,64b,1>");
+    func(MapTag<Excalibur::HashMap<uint32_t, HeavyValue, 8>, uint32_t, HeavyValue>(), "Excalibur::HashMap<u32,64b,8>");
+    func(MapTag<Excalibur::HashMap<uint32_t, HeavyValue, 64>, uint32_t, HeavyValue>(), "Excalibur::HashMap<u32,64b,64>");
+    func(MapTag<std::unordered_map<uint32_t, HeavyValue>, uint32_t, HeavyValue>(), "std::unordered_map<u32,64b>");
+}
+
+struct Sizes
+{
+    uint32_t numKeys;
+    uint32_t numRounds;
+};
+
+// README sizes, quick mode runs ~1/32 of the work
+inline Sizes getSizes(const ExcaliburBench::BenchContext& ctx, uint32_t numKeys, uint32_t numRounds)
+{
+    if (!ctx.isQuick())
+    {
+        return Sizes{numKeys, numRounds};
+    }
+    return Sizes{std::max(numKeys / 32, 1u), std::max(numRounds / 4, 1u)};
+}
+
+inline double toMs(const ExcaliburBench::Timer& timer) { return timer.getElapsedSeconds() * 1000.0; }
+
+} // namespace
+
+EXLBR_BENCHMARK(CtorDtor)
+{
+    const Sizes sizes = getSizes(ctx, 1, 300000);
+    forEachInlineConfig(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            ExcaliburBench::Timer timer;
+            for (uint32_t i = 0; i < sizes.numRounds; i++)
+            {
+                TMap ht;
+                ExcaliburBench::doNotOptimize(ht);
+            }
+            ctx.report(variant, "tables", sizes.numRounds, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(ClearAndInsertSeq)
+{
+    const Sizes sizes = getSizes(ctx, 599999, 25);
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            {
+                TMap ht;
+                for (uint32_t round = 0; round < sizes.numRounds; round++)
+                {
+                    ht.clear();
+                    for (uint32_t i = 0; i < sizes.numKeys; i++)
+                    {
+                        ht.emplace(TKey(i), TValue());
+                    }
+                    ExcaliburBench::doNotOptimize(ht.size());
+                }
+            }
+            ctx.report(variant, "keys", sizes.numKeys, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(InsertRndClearAndReInsert)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 1000000, 10);
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            for (uint32_t round = 0; round < sizes.numRounds; round++)
+            {
+                TMap ht;
+                for (uint32_t i = 0; i < sizes.numKeys; i++)
+                {
+                    ht.emplace(TKey(keys[i]), TValue());
+                }
+                ht.clear();
+                for (uint32_t i = 0; i < sizes.numKeys; i++)
+                {
+                    ht.emplace(TKey(keys[i]), TValue());
+                }
+                ExcaliburBench::doNotOptimize(ht.size());
+            }
+            ctx.report(variant, "keys", sizes.numKeys, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(InsertRndAndRemove)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 1000000, 10);
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            for (uint32_t round = 0; round < sizes.numRounds; round++)
+            {
+                TMap ht;
+                for (uint32_t i = 0; i < sizes.numKeys; i++)
+                {
+                    ht.emplace(TKey(keys[i]), TValue());
+                }
+                for (uint32_t i = 0; i < sizes.numKeys; i++)
+                {
+                    ht.erase(TKey(keys[i]));
+                }
+                ExcaliburBench::doNotOptimize(ht.size());
+            }
+            ctx.report(variant, "keys", sizes.numKeys, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(CtorSingleEmplaceDtor)
+{
+    const Sizes sizes = getSizes(ctx, 1, 300000);
+    forEachInlineConfig(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            for (uint32_t i = 0; i < sizes.numRounds; i++)
+            {
+                TMap ht;
+                ht.emplace(TKey(i), TValue());
+                ExcaliburBench::doNotOptimize(ht);
+            }
+            ctx.report(variant, "tables", sizes.numRounds, toMs(timer), "ms");
+        });
+}
+
+// 'insert or increment' where 'duplicatePercent' of the operations hit an already inserted key
+static void runInsertAccessWithProbability(ExcaliburBench::BenchContext& ctx, uint32_t duplicatePercent)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 1000000, 8);
+
+    std::vector<uint32_t> ops(sizes.numKeys);
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    uint32_t numInserted = 0;
+    for (uint32_t& op : ops)
+    {
+        const bool isDuplicate = numInserted > 0 && (ExcaliburBench::nextRandom(rnd) % 100) < duplicatePercent;
+        op = isDuplicate ? keys[ExcaliburBench::nextRandom(rnd) % numInserted] : keys[numInserted++];
+    }
+
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            ExcaliburBench::Timer timer;
+            for (uint32_t round = 0; round < sizes.numRounds; round++)
+            {
+                TMap ht;
+                for (uint32_t key : ops)
+                {
+                    bump(ht[TKey(key)]);
+                }
+                ExcaliburBench::doNotOptimize(ht.size());
+            }
+            ctx.report(variant, "ops", sizes.numKeys, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(InsertAccessWithProbability10) { runInsertAccessWithProbability(ctx, 10); }
+
+EXLBR_BENCHMARK(InsertAccessWithProbability50) { runInsertAccessWithProbability(ctx, 50); }
+
+// table sizes from L1-resident to DRAM-resident
+static void runSearch(ExcaliburBench::BenchContext& ctx, bool isExisting)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 1000000, 10000000);
+    for (uint32_t numKeys : {1000u, 16000u, 250000u, 1000000u})
+    {
+        numKeys = std::min(numKeys, uint32_t(keys.size()));
+        if (ctx.isQuick() && numKeys > 250000u)
+        {
+            break;
+        }
+
+        std::vector<uint32_t> searchKeys(sizes.numRounds);
+        uint64_t rnd = 0x9E3779B97F4A7C15ull;
+        for (uint32_t& key : searchKeys)
+        {
+            // keys in random.bin are below 2^31, so setting the top bit gives a key that doesn't exist
+            key = keys[ExcaliburBench::nextRandom(rnd) % numKeys] | (isExisting ? 0u : 0x80000000u);
+        }
+
+        forEachMap(
+            [&](auto tag, const char* variant)
+            {
+                using TMap = typename decltype(tag)::Map;
+                using TKey = typename decltype(tag)::Key;
+                using TValue = typename decltype(tag)::Value;
+                TMap ht;
+                for (uint32_t i = 0; i < numKeys; i++)
+                {
+                    ht.emplace(TKey(keys[i]), TValue());
+                }
+
+                uint64_t sum = 0;
+                ExcaliburBench::Timer timer;
+                for (uint32_t key : searchKeys)
+                {
+                    const TValue* value = findValue(ht, TKey(key));
+                    sum += value ? getSum(*value) + 1 : 0;
+                }
+                const double ms = toMs(timer);
+                ExcaliburBench::doNotOptimize(sum);
+                ctx.report(variant, "keys", numKeys, ms, "ms");
+            });
+    }
+}
+
+EXLBR_BENCHMARK(SearchNonExisting) { runSearch(ctx, false); }
+
+EXLBR_BENCHMARK(SearchExisting) { runSearch(ctx, true); }
+
+EXLBR_BENCHMARK(ClearAndInsertRnd)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 1000000, 25);
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            for (uint32_t round = 0; round < sizes.numRounds; round++)
+            {
+                TMap ht;
+                for (uint32_t i = 0; i < sizes.numKeys; i++)
+                {
+                    ht.emplace(TKey(keys[i]), TValue());
+                }
+                ExcaliburBench::doNotOptimize(ht.size());
+            }
+            ctx.report(variant, "keys", sizes.numKeys, toMs(timer), "ms");
+        });
+}
+
+EXLBR_BENCHMARK(ClearAndInsertPrime)
+{
+    const std::vector<uint32_t>& keys = ExcaliburBench::loadRandomKeys(ctx.getOptions().dataPath);
+    const Sizes sizes = getSizes(ctx, 32767, 10);
+
+    // 100 unique keys, each one inserted 'numKeys' times in a shuffled order
+    std::vector<uint32_t> ops;
+    ops.reserve(size_t(sizes.numKeys) * 100);
+    for (uint32_t i = 0; i < sizes.numKeys; i++)
+    {
+        ops.insert(ops.end(), keys.begin(), keys.begin() + 100);
+    }
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    for (size_t i = ops.size() - 1; i > 0; i--)
+    {
+        std::swap(ops[i], ops[ExcaliburBench::nextRandom(rnd) % (i + 1)]);
+    }
+
+    forEachMap(
+        [&](auto tag, const char* variant)
+        {
+            using TMap = typename decltype(tag)::Map;
+            using TKey = typename decltype(tag)::Key;
+            using TValue = typename decltype(tag)::Value;
+            ExcaliburBench::Timer timer;
+            for (uint32_t round = 0; round < sizes.numRounds; round++)
+            {
+                TMap ht;
+                for (uint32_t key : ops)
+                {
+                    ht.emplace(TKey(key), TValue());
+                }
+                ExcaliburBench::doNotOptimize(ht.size());
+            }
+            ctx.report(variant, "inserts", ops.size(), toMs(timer), "ms");
+        });
+}
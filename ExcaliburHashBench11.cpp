@@ -0,0 +1,83 @@
+#include "ExcaliburHashBench.h"
+#include "ExcaliburSnapshot.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Record
+{
+    uint64_t offset;
+    uint32_t size;
+    uint32_t flags;
+};
+
+using RecordMap = Excalibur::HashMap<uint64_t, Record>;
+
+} // namespace
+
+// Service startup: rebuild an index with emplace vs map a snapshot of it
+EXLBR_BENCHMARK(SnapshotStartup)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "exlbr_bench_snapshot.bin").string();
+    for (uint64_t numKeys : {1ull << 16, 1ull << 20, 1ull << 23})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 16))
+        {
+            break;
+        }
+
+        std::vector<uint64_t> keys(numKeys);
+        uint64_t rnd = 0x9E3779B97F4A7C15ull;
+        for (uint64_t& key : keys)
+        {
+            // keep clear of the sentinel keys
+            key = ExcaliburBench::nextRandom(rnd) >> 2;
+        }
+
+        ExcaliburBench::Timer rebuildTimer;
+        RecordMap ht;
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            ht.emplace(keys[i], Record{i * 64, uint32_t(i), 0});
+        }
+        ctx.report("emplace", "keys", numKeys, rebuildTimer.getElapsedSeconds() * 1e3, "ms");
+
+        ExcaliburBench::Timer saveTimer;
+        if (Excalibur::saveSnapshot(ht, path.c_str()) != Excalibur::SnapshotStatus::Ok)
+        {
+            fprintf(stderr, "Can't write '%s'\n", path.c_str());
+            return;
+        }
+        ctx.report("saveSnapshot", "keys", numKeys, saveTimer.getElapsedSeconds() * 1e3, "ms");
+
+        ExcaliburBench::Timer openTimer;
+        Excalibur::HashTableView<RecordMap> view;
+        if (view.open(path.c_str()) != Excalibur::SnapshotStatus::Ok)
+        {
+            fprintf(stderr, "Can't map '%s'\n", path.c_str());
+            return;
+        }
+        ctx.report("HashTableView::open", "keys", numKeys, openTimer.getElapsedSeconds() * 1e3, "ms");
+
+        // first lookups through the view also pay for the page faults
+        uint64_t sum = 0;
+        ExcaliburBench::Timer viewTimer;
+        for (uint64_t key : keys)
+        {
+            sum += view.find(key)->offset;
+        }
+        ctx.report("HashTableView::find", "keys", numKeys, viewTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+
+        ExcaliburBench::Timer findTimer;
+        for (uint64_t key : keys)
+        {
+            sum += ht.find(key).value().offset;
+        }
+        ctx.report("HashMap::find", "keys", numKeys, findTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+        ExcaliburBench::doNotOptimize(sum);
+    }
+    std::filesystem::remove(path);
+}
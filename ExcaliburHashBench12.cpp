@@ -0,0 +1,83 @@
+#include "ExcaliburFrozenHash.h"
+#include "ExcaliburHashBench.h"
+#include <vector>
+
+// Build-once/query-many tables: HashMap vs FrozenHashMap built from it
+EXLBR_BENCHMARK(FrozenLookup)
+{
+    for (uint64_t numKeys : {1ull << 10, 1ull << 16, 1ull << 20, 1ull << 23})
+    {
+        if (ctx.isQuick() && numKeys > (1ull << 16))
+        {
+            break;
+        }
+
+        std::vector<uint64_t> keys(numKeys);
+        std::vector<uint64_t> missingKeys(numKeys);
+        uint64_t rnd = 0x9E3779B97F4A7C15ull;
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            // even keys are inserted, odd keys are missing (and both stay clear of the sentinel keys)
+            const uint64_t key = (ExcaliburBench::nextRandom(rnd) >> 2) & ~uint64_t(1);
+            keys[i] = key;
+            missingKeys[i] = key | 1;
+        }
+
+        Excalibur::HashMap<uint64_t, uint64_t> ht;
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            ht.emplace(keys[i], i);
+        }
+
+        ExcaliburBench::Timer buildTimer;
+        Excalibur::FrozenHashMap<uint64_t, uint64_t> frozen(ht);
+        ctx.report("FrozenHashMap", "build/keys", numKeys, buildTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/item");
+
+        ctx.report("HashMap", "memory/keys", numKeys, double(size_t(ht.capacity()) * sizeof(uint64_t) * 2) / double(numKeys), "bytes/item");
+        ctx.report("FrozenHashMap", "memory/keys", numKeys, double(frozen.getMemoryUsage()) / double(numKeys), "bytes/item");
+
+        const size_t numRounds = std::max(size_t(1), size_t((1ull << 22) / numKeys));
+        uint64_t sum = 0;
+        ExcaliburBench::Timer htHitTimer;
+        for (size_t round = 0; round < numRounds; round++)
+        {
+            for (uint64_t key : keys)
+            {
+                sum += ht.find(key).value();
+            }
+        }
+        const double numOps = double(numRounds * numKeys);
+        ctx.report("HashMap", "hit/keys", numKeys, htHitTimer.getElapsedSeconds() * 1e9 / numOps, "ns/op");
+
+        ExcaliburBench::Timer frozenHitTimer;
+        for (size_t round = 0; round < numRounds; round++)
+        {
+            for (uint64_t key : keys)
+            {
+                sum += *frozen.find(key);
+            }
+        }
+        ctx.report("FrozenHashMap", "hit/keys", numKeys, frozenHitTimer.getElapsedSeconds() * 1e9 / numOps, "ns/op");
+
+        ExcaliburBench::Timer htMissTimer;
+        for (size_t round = 0; round < numRounds; round++)
+        {
+            for (uint64_t key : missingKeys)
+            {
+                sum += ht.has(key) ? 1 : 0;
+            }
+        }
+        ctx.report("HashMap", "miss/keys", numKeys, htMissTimer.getElapsedSeconds() * 1e9 / numOps, "ns/op");
+
+        ExcaliburBench::Timer frozenMissTimer;
+        for (size_t round = 0; round < numRounds; round++)
+        {
+            for (uint64_t key : missingKeys)
+            {
+                sum += frozen.has(key) ? 1 : 0;
+            }
+        }
+        ctx.report("FrozenHashMap", "miss/keys", numKeys, frozenMissTimer.getElapsedSeconds() * 1e9 / numOps, "ns/op");
+        ExcaliburBench::doNotOptimize(sum);
+    }
+}
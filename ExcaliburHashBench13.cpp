@@ -0,0 +1,61 @@
+#include "ExcaliburHashBench.h"
+#include "ExcaliburStaticHash.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr std::pair<std::string_view, int> kHeaderItems[] = {
+    {"accept", 0},         {"accept-encoding", 1}, {"accept-language", 2}, {"authorization", 3}, {"cache-control", 4},
+    {"connection", 5},     {"content-length", 6},  {"content-type", 7},    {"cookie", 8},        {"date", 9},
+    {"etag", 10},          {"host", 11},           {"if-none-match", 12},  {"location", 13},     {"origin", 14},
+    {"referer", 15},       {"server", 16},         {"set-cookie", 17},     {"user-agent", 18},   {"vary", 19}};
+
+constexpr auto kHeaders = Excalibur::makeStaticHashMap(kHeaderItems);
+} // namespace
+
+// Known literal key sets: HashMap<std::string> filled at startup vs StaticHashMap built by the compiler
+EXLBR_BENCHMARK(StaticLookup)
+{
+    const size_t numQueries = ctx.isQuick() ? (1u << 16) : (1u << 22);
+
+    Excalibur::HashMap<std::string, int> ht;
+    for (const auto& kv : kHeaderItems)
+    {
+        ht.emplace(std::string(kv.first), kv.second);
+    }
+
+    // 3 out of 4 queries hit
+    std::vector<std::string> queries(numQueries);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < numQueries; i++)
+    {
+        const uint64_t r = ExcaliburBench::nextRandom(rnd);
+        queries[i] = std::string(kHeaderItems[r % std::size(kHeaderItems)].first);
+        if ((r >> 32) % 4 == 0)
+        {
+            queries[i] += "-x";
+        }
+    }
+
+    int sum = 0;
+    ExcaliburBench::Timer htTimer;
+    for (const std::string& query : queries)
+    {
+        auto it = ht.find(query);
+        sum += (it != ht.iend()) ? it.value() : -1;
+    }
+    ctx.report("HashMap<std::string>", "lookup/keys", std::size(kHeaderItems), htTimer.getElapsedSeconds() * 1e9 / double(numQueries),
+               "ns/op");
+
+    ExcaliburBench::Timer staticTimer;
+    for (const std::string& query : queries)
+    {
+        auto it = kHeaders.find(query);
+        sum += (it != kHeaders.iend()) ? it.value() : -1;
+    }
+    ctx.report("StaticHashMap", "lookup/keys", std::size(kHeaderItems), staticTimer.getElapsedSeconds() * 1e9 / double(numQueries),
+               "ns/op");
+    ExcaliburBench::doNotOptimize(sum);
+}
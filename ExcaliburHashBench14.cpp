@@ -0,0 +1,67 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <vector>
+
+// Bulk paths (clear, iteration over a sparse table) with every supported instruction set
+EXLBR_BENCHMARK(SimdDispatch)
+{
+    const uint64_t numKeys = ctx.isQuick() ? (1ull << 16) : (1ull << 21);
+    std::vector<uint64_t> keys(numKeys);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (uint64_t& key : keys)
+    {
+        key = ExcaliburBench::nextRandom(rnd) >> 2;
+    }
+
+    for (Excalibur::SimdLevel level : {Excalibur::SimdLevel::Scalar, Excalibur::SimdLevel::SSE2, Excalibur::SimdLevel::AVX2,
+                                       Excalibur::SimdLevel::AVX512, Excalibur::SimdLevel::NEON})
+    {
+        if (!Excalibur::setSimdLevel(level))
+        {
+            continue;
+        }
+        const char* variant = Excalibur::getSimdLevelName(level);
+
+        Excalibur::HashMap<uint64_t, uint64_t> ht;
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            ht.emplace(keys[i], i);
+        }
+
+        const int kNumRounds = 8;
+        uint64_t sum = 0;
+        ExcaliburBench::Timer clearTimer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            ht.clear();
+            sum += ht.capacity();
+        }
+        ctx.report(variant, "clear/buckets", ht.capacity(), clearTimer.getElapsedSeconds() * 1e9 / double(kNumRounds * ht.capacity()),
+                   "ns/bucket");
+
+        // 1 out of 128 items left (less than 1% of the buckets are occupied)
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            ht.emplace(keys[i], i);
+        }
+        for (uint64_t i = 0; i < numKeys; i++)
+        {
+            if ((i % 128) != 0)
+            {
+                ht.erase(keys[i]);
+            }
+        }
+        ExcaliburBench::Timer iterateTimer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (auto it = ht.ibegin(); it != ht.iend(); ++it)
+            {
+                sum += it.value();
+            }
+        }
+        ctx.report(variant, "iterate_sparse/buckets", ht.capacity(),
+                   iterateTimer.getElapsedSeconds() * 1e9 / double(kNumRounds * ht.capacity()), "ns/bucket");
+        ExcaliburBench::doNotOptimize(sum);
+    }
+    Excalibur::setSimdLevel(Excalibur::getBestSimdLevel());
+}
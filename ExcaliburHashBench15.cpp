@@ -0,0 +1,66 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <vector>
+
+// wyhash::hashN (bulk hashing) vs a scalar wyhash::hash loop, and rehash which uses it
+EXLBR_BENCHMARK(WyHashN)
+{
+    const size_t numKeys = ctx.isQuick() ? (size_t(1) << 16) : (size_t(1) << 21);
+    std::vector<uint64_t> keys(numKeys);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (uint64_t& key : keys)
+    {
+        key = ExcaliburBench::nextRandom(rnd) >> 2;
+    }
+    std::vector<size_t> hashes(numKeys);
+
+    // in-cache block of keys, the hashing throughput itself
+    const size_t kBlockSize = 4096;
+    const int kNumRounds = ctx.isQuick() ? 64 : 1024;
+    {
+        ExcaliburBench::Timer timer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (size_t i = 0; i < kBlockSize; i++)
+            {
+                hashes[i] = Excalibur::wyhash::hash(keys[i]);
+            }
+            ExcaliburBench::doNotOptimize(hashes[size_t(round) % kBlockSize]);
+        }
+        ctx.report("hash", "hash/keys", kBlockSize, timer.getElapsedSeconds() * 1e9 / double(kNumRounds * kBlockSize), "ns/key");
+    }
+
+    for (Excalibur::SimdLevel level : {Excalibur::SimdLevel::Scalar, Excalibur::SimdLevel::SSE2, Excalibur::SimdLevel::AVX2,
+                                       Excalibur::SimdLevel::AVX512, Excalibur::SimdLevel::NEON})
+    {
+        if (!Excalibur::setSimdLevel(level))
+        {
+            continue;
+        }
+        const char* variant = Excalibur::getSimdLevelName(level);
+
+        ExcaliburBench::Timer hashTimer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            Excalibur::wyhash::hashN(keys.data(), hashes.data(), kBlockSize);
+            ExcaliburBench::doNotOptimize(hashes[size_t(round) % kBlockSize]);
+        }
+        ctx.report(variant, "hashN/keys", kBlockSize, hashTimer.getElapsedSeconds() * 1e9 / double(kNumRounds * kBlockSize), "ns/key");
+
+        Excalibur::HashMap<uint64_t, uint64_t> ht;
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            ht.emplace(keys[i], uint64_t(i));
+        }
+
+        const int kNumRehashes = 4;
+        ExcaliburBench::Timer rehashTimer;
+        for (int round = 0; round < kNumRehashes; round++)
+        {
+            ht.rehash();
+        }
+        ctx.report(variant, "rehash/keys", numKeys, rehashTimer.getElapsedSeconds() * 1e9 / double(kNumRehashes * numKeys), "ns/key");
+        ExcaliburBench::doNotOptimize(ht.size());
+    }
+    Excalibur::setSimdLevel(Excalibur::getBestSimdLevel());
+}
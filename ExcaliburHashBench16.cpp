@@ -0,0 +1,110 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// KeyInfo<std::string> as it was before wyhash::hashBytes
+struct StdHashStringKeyInfo : public Excalibur::KeyInfo<std::string>
+{
+    static inline size_t hash(const std::string& key) noexcept { return std::hash<std::string>{}(key); }
+};
+
+std::string makeRandomString(uint64_t& rnd, size_t length)
+{
+    std::string str(length, ' ');
+    for (char& c : str)
+    {
+        c = char('a' + ExcaliburBench::nextRandom(rnd) % 26);
+    }
+    return str;
+}
+
+template <typename TTable> void benchUrlLookup(ExcaliburBench::BenchContext& ctx, const char* variant, const std::vector<std::string>& keys,
+                                               const std::vector<std::string>& queries)
+{
+    TTable ht;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        ht.emplace(keys[i], int(i));
+    }
+
+    int sum = 0;
+    ExcaliburBench::Timer timer;
+    for (const std::string& query : queries)
+    {
+        auto it = ht.find(query);
+        sum += (it != ht.iend()) ? it.value() : -1;
+    }
+    ctx.report(variant, "url_lookup/keys", keys.size(), timer.getElapsedSeconds() * 1e9 / double(queries.size()), "ns/op");
+    ExcaliburBench::doNotOptimize(sum);
+}
+} // namespace
+
+// String hashing throughput (wyhash::hashBytes vs std::hash) for key lengths 4..1024 and URL-like (40..200 bytes) lookups
+EXLBR_BENCHMARK(StringHash)
+{
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    const size_t numKeys = 256;
+    const int kNumRounds = ctx.isQuick() ? 64 : 4096;
+    for (size_t length : {4, 8, 16, 32, 64, 128, 256, 512, 1024})
+    {
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            keys.push_back(makeRandomString(rnd, length));
+        }
+
+        size_t sum = 0;
+        ExcaliburBench::Timer wyTimer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (const std::string& key : keys)
+            {
+                sum += Excalibur::wyhash::hashBytes(key.data(), key.size());
+            }
+        }
+        ctx.report("wyhash", "hash/bytes", length, wyTimer.getElapsedSeconds() * 1e9 / double(kNumRounds * numKeys), "ns/op");
+
+        ExcaliburBench::Timer stdTimer;
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (const std::string& key : keys)
+            {
+                sum += std::hash<std::string_view>{}(key);
+            }
+        }
+        ctx.report("std::hash", "hash/bytes", length, stdTimer.getElapsedSeconds() * 1e9 / double(kNumRounds * numKeys), "ns/op");
+        ExcaliburBench::doNotOptimize(sum);
+    }
+
+    // "https://host/segment/segment/..." 40..200 bytes, half of the queries miss (same length, last byte changed)
+    const size_t numUrls = ctx.isQuick() ? (1u << 12) : (1u << 18);
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < numUrls; i++)
+    {
+        std::string url = "https://" + makeRandomString(rnd, 8) + ".com";
+        const size_t length = 40 + ExcaliburBench::nextRandom(rnd) % 161;
+        while (url.size() < length)
+        {
+            url += "/" + makeRandomString(rnd, 1 + ExcaliburBench::nextRandom(rnd) % 12);
+        }
+        url.resize(length);
+        urls.push_back(url);
+    }
+    std::vector<std::string> queries(urls.size() * 2);
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        queries[i] = urls[ExcaliburBench::nextRandom(rnd) % urls.size()];
+        if ((i % 2) != 0)
+        {
+            queries[i].back() = '#';
+        }
+    }
+
+    benchUrlLookup<Excalibur::HashMap<std::string, int>>(ctx, "wyhash", urls, queries);
+    benchUrlLookup<Excalibur::HashMap<std::string, int, 1, StdHashStringKeyInfo>>(ctx, "std::hash", urls, queries);
+}
@@ -0,0 +1,110 @@
+#include "ExcaliburHashBench.h"
+#include "ExcaliburHashPolicies.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+enum class KeyPattern
+{
+    Sequential, // 0, 1, 2, ...
+    Strided,    // multiples of 4096 (i.e. page-aligned addresses)
+    HighBits,   // only the upper 32 bits change
+    Random
+};
+
+const char* getPatternName(KeyPattern pattern)
+{
+    switch (pattern)
+    {
+    case KeyPattern::Sequential:
+        return "sequential";
+    case KeyPattern::Strided:
+        return "strided";
+    case KeyPattern::HighBits:
+        return "high_bits";
+    default:
+        return "random";
+    }
+}
+
+std::vector<uint64_t> makeKeys(KeyPattern pattern, size_t numKeys)
+{
+    std::vector<uint64_t> keys(numKeys);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < numKeys; i++)
+    {
+        switch (pattern)
+        {
+        case KeyPattern::Sequential:
+            keys[i] = uint64_t(i);
+            break;
+        case KeyPattern::Strided:
+            keys[i] = uint64_t(i) << 12;
+            break;
+        case KeyPattern::HighBits:
+            keys[i] = uint64_t(i) << 32;
+            break;
+        default:
+            // below the empty/tombstone sentinels
+            keys[i] = ExcaliburBench::nextRandom(rnd) >> 1;
+            break;
+        }
+    }
+    return keys;
+}
+
+template <typename THashPolicy>
+void benchHashPolicy(ExcaliburBench::BenchContext& ctx, const char* policyName, KeyPattern pattern, const std::vector<uint64_t>& keys)
+{
+    using TMap = Excalibur::HashMap<uint64_t, uint64_t, 1, Excalibur::HashPolicyKeyInfo<Excalibur::KeyInfo<uint64_t>, THashPolicy>>;
+    const std::string variant = std::string(policyName) + "/" + getPatternName(pattern);
+    const size_t numKeys = keys.size();
+
+    TMap ht;
+    ExcaliburBench::Timer insertTimer;
+    for (uint64_t key : keys)
+    {
+        ht.emplace(key, key);
+    }
+    ctx.report(variant.c_str(), "insert/keys", numKeys, insertTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+
+    uint64_t sum = 0;
+    ExcaliburBench::Timer findTimer;
+    for (uint64_t key : keys)
+    {
+        sum += ht.find(key).value();
+    }
+    ctx.report(variant.c_str(), "find/keys", numKeys, findTimer.getElapsedSeconds() * 1e9 / double(numKeys), "ns/op");
+    ExcaliburBench::doNotOptimize(sum);
+
+    // collisions = items that are not in their home bucket, probe length = buckets inspected by a successful find
+    const Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+    uint64_t totalDisplacement = 0;
+    for (size_t d = 0; d < histogram.displacement.size(); d++)
+    {
+        totalDisplacement += uint64_t(d) * histogram.displacement[d];
+    }
+    const uint32_t numAtHome = histogram.displacement.empty() ? 0 : histogram.displacement[0];
+    ctx.report(variant.c_str(), "collisions/keys", numKeys, 100.0 * double(histogram.numElements - numAtHome) / double(numKeys), "%");
+    ctx.report(variant.c_str(), "avg_probe/keys", numKeys, 1.0 + double(totalDisplacement) / double(numKeys), "buckets");
+    ctx.report(variant.c_str(), "max_probe/keys", numKeys, 1.0 + double(histogram.maxDisplacement), "buckets");
+    ctx.report(variant.c_str(), "max_cluster/keys", numKeys, double(histogram.maxClusterLength), "buckets");
+}
+} // namespace
+
+// Integer hash policies (HashPolicyKeyInfo): speed vs collisions and probe lengths on typical key patterns
+EXLBR_BENCHMARK(HashPolicies)
+{
+    const size_t numKeys = ctx.isQuick() ? (size_t(1) << 14) : (size_t(1) << 20);
+    for (KeyPattern pattern : {KeyPattern::Sequential, KeyPattern::Strided, KeyPattern::HighBits, KeyPattern::Random})
+    {
+        const std::vector<uint64_t> keys = makeKeys(pattern, numKeys);
+        benchHashPolicy<Excalibur::WyHash>(ctx, "wyhash", pattern, keys);
+        benchHashPolicy<Excalibur::Crc32cHash>(ctx, Excalibur::crc32c::isHardwareAccelerated() ? "crc32c" : "crc32c(sw)", pattern, keys);
+        benchHashPolicy<Excalibur::Fmix64Hash>(ctx, "fmix64", pattern, keys);
+        // a degenerate cluster for strided / high-bit keys, capped to keep the benchmark short
+        const std::vector<uint64_t> identityKeys(keys.begin(), keys.begin() + ptrdiff_t(std::min(numKeys, size_t(1) << 14)));
+        benchHashPolicy<Excalibur::IdentityHash>(ctx, "identity", pattern, (pattern == KeyPattern::Sequential) ? keys : identityKeys);
+    }
+}
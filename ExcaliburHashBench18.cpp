@@ -0,0 +1,79 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashBench.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+using SeededKeyInfo64 = Excalibur::SeededKeyInfo<Excalibur::KeyInfo<uint64_t>>;
+
+// keys whose hashes share the low 'numBits' bits, found by brute force against a known hash function
+template <typename THashFunc> std::vector<uint64_t> makeFloodingKeys(size_t numKeys, uint32_t numBits, THashFunc&& hashFunc)
+{
+    const size_t mask = (size_t(1) << numBits) - 1;
+    std::vector<uint64_t> keys;
+    for (uint64_t key = 0; keys.size() < numKeys; key++)
+    {
+        if ((hashFunc(key) & mask) == 0)
+        {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+template <typename TMap, bool kSeeded = false>
+void benchFlooding(ExcaliburBench::BenchContext& ctx, const char* variant, const std::vector<uint64_t>& keys)
+{
+    TMap ht;
+    if constexpr (kSeeded)
+    {
+        // worst case, the attacker knows the seed the keys were chosen against
+        ht.reseed(0);
+    }
+    double maxInsertSeconds = 0.0;
+    ExcaliburBench::Timer totalTimer;
+    for (uint64_t key : keys)
+    {
+        ExcaliburBench::Timer insertTimer;
+        ht.emplace(key, key);
+        maxInsertSeconds = std::max(maxInsertSeconds, insertTimer.getElapsedSeconds());
+    }
+    ctx.report(variant, "insert/keys", keys.size(), totalTimer.getElapsedSeconds() * 1e9 / double(keys.size()), "ns/op");
+    ctx.report(variant, "max_insert/keys", keys.size(), maxInsertSeconds * 1e9, "ns");
+
+    uint64_t sum = 0;
+    ExcaliburBench::Timer findTimer;
+    for (uint64_t key : keys)
+    {
+        sum += ht.find(key).value();
+    }
+    ctx.report(variant, "find/keys", keys.size(), findTimer.getElapsedSeconds() * 1e9 / double(keys.size()), "ns/op");
+    ExcaliburBench::doNotOptimize(sum);
+}
+} // namespace
+
+// Hash flooding: attacker-chosen keys that all land in the same bucket. The unseeded table degrades to O(n) per operation,
+// the seeded one (keys chosen against a leaked seed) reseeds once and stays fast.
+EXLBR_BENCHMARK(HashFlooding)
+{
+    const size_t numKeys = ctx.isQuick() ? 2048 : 8192;
+    const uint32_t numBits = ctx.isQuick() ? 12 : 16;
+
+    const std::vector<uint64_t> unseededKeys =
+        makeFloodingKeys(numKeys, numBits, [](uint64_t key) { return Excalibur::KeyInfo<uint64_t>::hash(key); });
+    benchFlooding<Excalibur::HashMap<uint64_t, uint64_t>>(ctx, "unseeded/flooding", unseededKeys);
+
+    const std::vector<uint64_t> seededKeys = makeFloodingKeys(numKeys, numBits, [](uint64_t key) { return SeededKeyInfo64::hash(key, 0); });
+    benchFlooding<Excalibur::HashMap<uint64_t, uint64_t, 1, SeededKeyInfo64>, true>(ctx, "seeded/flooding", seededKeys);
+
+    // the cost of seeding on ordinary keys
+    std::vector<uint64_t> randomKeys(numKeys);
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    for (uint64_t& key : randomKeys)
+    {
+        key = ExcaliburBench::nextRandom(rnd) >> 1;
+    }
+    benchFlooding<Excalibur::HashMap<uint64_t, uint64_t>>(ctx, "unseeded/random", randomKeys);
+    benchFlooding<Excalibur::HashMap<uint64_t, uint64_t, 1, SeededKeyInfo64>, true>(ctx, "seeded/random", randomKeys);
+}
@@ -118,16 +118,16 @@ TEST(SmFlatHashMap, CopyableIterators)
 
     // iterate and remove
     {
-        for (Excalibur::HashTable<std::string, std::string>::IteratorKV it3 = ht.ibegin(); it3 != ht.iend(); ++it3)
+        for (Excalibur::HashTable<std::string, std::string>::IteratorKV it3 = ht.ibegin(); it3 != ht.iend();)
         {
-            if (std::strcmp(it3->first.get().c_str(), "5") == 0)
+            // erase() returns the next item (or iend() if the erased item was the last one)
+            if (std::strcmp(it3->first.get().c_str(), "5") == 0 || std::strcmp(it3->first.get().c_str(), "9") == 0)
             {
                 it3 = ht.erase(it3);
             }
-
-            if (std::strcmp(it3->first.get().c_str(), "9") == 0)
+            else
             {
-                it3 = ht.erase(it3);
+                ++it3;
             }
         }
     }
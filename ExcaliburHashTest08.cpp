@@ -0,0 +1,341 @@
+#include "ExcaliburGroupHash.h"
+#include "ExcaliburHashTestUtils.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <memory>
+#include <string>
+
+using ExcaliburTest::AllocStats;
+using ExcaliburTest::CountingAllocator;
+
+// key type without reserved empty/tombstone values
+struct GroupKey
+{
+    int v = 0;
+};
+
+// all keys share the same hash (and the same 7-bit fingerprint)
+struct GroupKeyInfoBadHash
+{
+    static inline size_t hash(const GroupKey& /*key*/) noexcept { return 3; }
+    static inline bool isEqual(const GroupKey& lhs, const GroupKey& rhs) noexcept { return lhs.v == rhs.v; }
+};
+
+struct GroupKeyInfo
+{
+    static inline size_t hash(const GroupKey& key) noexcept { return Excalibur::wyhash::hash(uint32_t(key.v)); }
+    static inline bool isEqual(const GroupKey& lhs, const GroupKey& rhs) noexcept { return lhs.v == rhs.v; }
+};
+
+TEST(GroupHashMap, BasicTest)
+{
+    Excalibur::GroupHashMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.size(), 0u);
+    EXPECT_EQ(ht.find(13), ht.iend());
+    EXPECT_FALSE(ht.has(13));
+    EXPECT_FALSE(ht.erase(13));
+
+    const int kNumElements = 10000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, -i);
+        EXPECT_TRUE(it.second);
+        EXPECT_EQ(it.first.key(), i);
+        EXPECT_EQ(it.first.value(), -i);
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, 1);
+        EXPECT_FALSE(it.second);
+        EXPECT_EQ(it.first.value(), -i);
+    }
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), -i);
+        EXPECT_FALSE(ht.has(kNumElements + i));
+    }
+
+    ht[kNumElements] = 5;
+    EXPECT_EQ(ht[kNumElements], 5);
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements + 1));
+
+    ht.clear();
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.find(1), ht.iend());
+    EXPECT_EQ(ht.ibegin(), ht.iend());
+}
+
+TEST(GroupHashMap, KeyWithoutSentinels)
+{
+    Excalibur::GroupHashMap<GroupKey, int, GroupKeyInfo> ht;
+
+    // every int value is a valid key, including the ones HashTable reserves
+    const std::array<int, 6> keys = {0, -1, -2, 0x7ffffffe, 0x7fffffff, int(0x80000000)};
+    for (int key : keys)
+    {
+        EXPECT_TRUE(ht.emplace(GroupKey{key}, key / 2).second);
+    }
+    EXPECT_EQ(ht.size(), uint32_t(keys.size()));
+
+    for (int key : keys)
+    {
+        auto it = ht.find(GroupKey{key});
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), key / 2);
+    }
+}
+
+TEST(GroupHashMap, BadHashFunction)
+{
+    Excalibur::GroupHashMap<GroupKey, int, GroupKeyInfoBadHash> ht;
+
+    const int kNumElements = 500;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_TRUE(ht.emplace(GroupKey{i}, i + 3).second);
+    }
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.find(GroupKey{i});
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i + 3);
+    }
+    EXPECT_EQ(ht.find(GroupKey{-3}), ht.iend());
+
+    // erase every other element, then search again
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(GroupKey{i}));
+    }
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_EQ(ht.has(GroupKey{i}), (i & 1) != 0);
+    }
+}
+
+TEST(GroupHashMap, EraseReinsertChurn)
+{
+    Excalibur::GroupHashMap<uint32_t, uint32_t> ht;
+
+    const uint32_t kWindow = 1000;
+    for (uint32_t i = 0; i < kWindow; i++)
+    {
+        ht.emplace(i, i);
+    }
+    const uint32_t capacity = ht.capacity();
+
+    // sliding window of live keys, the table must not keep growing
+    for (uint32_t i = kWindow; i < kWindow * 100; i++)
+    {
+        EXPECT_TRUE(ht.erase(i - kWindow));
+        EXPECT_TRUE(ht.emplace(i, i).second);
+    }
+    EXPECT_EQ(ht.size(), kWindow);
+    EXPECT_LE(ht.capacity(), capacity * 2);
+
+    for (uint32_t i = kWindow * 99; i < kWindow * 100; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i);
+    }
+
+    ht.rehash();
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_EQ(ht.size(), kWindow);
+}
+
+TEST(GroupHashMap, Iterators)
+{
+    Excalibur::GroupHashMap<int, int> ht;
+    const int kNumElements = 333;
+    int64_t keysSum = 0;
+    int64_t valuesSum = 0;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ht.emplace(i, i * 3);
+        keysSum += i;
+        valuesSum += i * 3;
+    }
+
+    int64_t keysSumTest = 0;
+    for (const int& key : ht.keys())
+    {
+        keysSumTest += key;
+    }
+    EXPECT_EQ(keysSum, keysSumTest);
+
+    int64_t valuesSumTest = 0;
+    for (const int& value : ht.values())
+    {
+        valuesSumTest += value;
+    }
+    EXPECT_EQ(valuesSum, valuesSumTest);
+
+    int64_t keysSumTest2 = 0;
+    int64_t valuesSumTest2 = 0;
+    for (const auto& [key, value] : ht.items())
+    {
+        keysSumTest2 += key;
+        valuesSumTest2 += value;
+    }
+    EXPECT_EQ(keysSum, keysSumTest2);
+    EXPECT_EQ(valuesSum, valuesSumTest2);
+
+    // erase odd keys while iterating
+    for (auto it = ht.ibegin(); it != ht.iend();)
+    {
+        if (it.key() & 1)
+        {
+            it = ht.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(ht.size(), uint32_t((kNumElements + 1) / 2));
+    for (int key : ht)
+    {
+        EXPECT_EQ(key & 1, 0);
+    }
+}
+
+TEST(GroupHashMap, StringKeys)
+{
+    Excalibur::GroupHashMap<std::string, std::unique_ptr<int>> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(std::to_string(i), std::make_unique<int>(i));
+    }
+
+    // empty string is a valid key here
+    EXPECT_TRUE(ht.emplace(std::string(), std::make_unique<int>(-1)).second);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        auto it = ht.find(std::to_string(i));
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(*it.value(), i);
+    }
+    EXPECT_EQ(*ht.find(std::string()).value(), -1);
+
+    Excalibur::GroupHashMap<std::string, std::unique_ptr<int>> moved(std::move(ht));
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(moved.size(), 1001u);
+    EXPECT_TRUE(moved.has("500"));
+    EXPECT_FALSE(ht.has("500"));
+}
+
+TEST(GroupHashMap, CopyTest)
+{
+    Excalibur::GroupHashMap<int, std::string> ht;
+    for (int i = 0; i < 100; i++)
+    {
+        ht.emplace(i, std::to_string(i));
+    }
+    ht.erase(50);
+
+    Excalibur::GroupHashMap<int, std::string> copy(ht);
+    EXPECT_EQ(copy.size(), ht.size());
+    for (int i = 0; i < 100; i++)
+    {
+        auto it = copy.find(i);
+        if (i == 50)
+        {
+            EXPECT_EQ(it, copy.iend());
+            continue;
+        }
+        ASSERT_NE(it, copy.iend());
+        EXPECT_EQ(it.value(), std::to_string(i));
+    }
+
+    Excalibur::GroupHashMap<int, std::string> empty;
+    copy = empty;
+    EXPECT_TRUE(copy.empty());
+    copy.emplace(1, "1");
+    EXPECT_TRUE(copy.has(1));
+}
+
+TEST(GroupHashMap, InsertFromItselfWhileGrow)
+{
+    Excalibur::GroupHashMap<int, std::string> ht;
+    ht.emplace(0, std::string(64, 'a'));
+    for (int i = 1; i < 1000; i++)
+    {
+        auto it = ht.find(i - 1);
+        ASSERT_NE(it, ht.iend());
+        ht.emplace(i, it.value());
+    }
+    EXPECT_EQ(ht.find(999).value(), std::string(64, 'a'));
+}
+
+TEST(GroupHashMap, StatefulAllocator)
+{
+    using TMap = Excalibur::GroupHashMap<int, std::string, Excalibur::KeyInfo<int>, CountingAllocator>;
+    AllocStats stats;
+    {
+        TMap ht{CountingAllocator(stats)};
+        EXPECT_EQ(stats.numAllocs, 0);
+        for (int i = 0; i < 1000; i++)
+        {
+            ht.emplace(i, std::to_string(i));
+        }
+        EXPECT_GT(stats.numAllocs, 1);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        ht.rehash();
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        // copies and moves take the allocator with them
+        TMap copy(ht);
+        EXPECT_EQ(copy.getAllocator().stats, &stats);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+
+        TMap moved(std::move(copy));
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+        EXPECT_EQ(moved.find(999).value(), "999");
+
+        AllocStats otherStats;
+        TMap other{CountingAllocator(otherStats)};
+        other.emplace(1, "1");
+        other = moved;
+        EXPECT_EQ(otherStats.numAllocs, otherStats.numFrees);
+        EXPECT_EQ(otherStats.numBytesAlive, 0u);
+        EXPECT_EQ(other.getAllocator().stats, &stats);
+        EXPECT_EQ(other.size(), 1000u);
+    }
+    EXPECT_EQ(stats.numAllocs, stats.numFrees);
+    EXPECT_EQ(stats.numBytesAlive, 0u);
+}
+
+TEST(GroupHashSet, BasicTest)
+{
+    Excalibur::GroupHashSet<int> hs;
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(hs.emplace(i).second);
+        EXPECT_FALSE(hs.emplace(i).second);
+    }
+    EXPECT_EQ(hs.size(), 100u);
+
+    int numKeys = 0;
+    for (int key : hs)
+    {
+        EXPECT_TRUE(key >= 0 && key < 100);
+        numKeys++;
+    }
+    EXPECT_EQ(numKeys, 100);
+
+    EXPECT_TRUE(hs.reserve(4096));
+    EXPECT_EQ(hs.capacity(), 4096u);
+    EXPECT_EQ(hs.size(), 100u);
+    EXPECT_TRUE(hs.has(42));
+}
@@ -0,0 +1,361 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+template <typename TKey, typename TValue, unsigned kNumInlineItems = 1>
+using RobinHoodMap = Excalibur::HashMap<TKey, TValue, kNumInlineItems, Excalibur::KeyInfo<TKey>, Excalibur::RobinHoodProbing>;
+
+struct RobinHoodBadKey
+{
+    int v = 0;
+};
+
+namespace Excalibur
+{
+template <> struct KeyInfo<RobinHoodBadKey>
+{
+    static inline bool isValid(const RobinHoodBadKey& key) noexcept { return key.v < 0x7ffffffe; }
+    static inline RobinHoodBadKey getTombstone() noexcept { return RobinHoodBadKey{0x7fffffff}; }
+    static inline RobinHoodBadKey getEmpty() noexcept { return RobinHoodBadKey{0x7ffffffe}; }
+    // only 4 different home buckets, lots of displacement
+    static inline size_t hash(const RobinHoodBadKey& key) noexcept { return size_t(key.v & 3); }
+    static inline bool isEqual(const RobinHoodBadKey& lhs, const RobinHoodBadKey& rhs) noexcept { return lhs.v == rhs.v; }
+};
+} // namespace Excalibur
+
+static int rhLiveValues = 0;
+
+struct RobinHoodValue
+{
+    RobinHoodValue() = delete;
+    RobinHoodValue(const RobinHoodValue& other) = delete;
+    RobinHoodValue& operator=(const RobinHoodValue& other) = delete;
+    RobinHoodValue& operator=(RobinHoodValue&& other) = delete;
+
+    explicit RobinHoodValue(int _v) noexcept
+        : v(_v)
+    {
+        rhLiveValues++;
+    }
+
+    RobinHoodValue(RobinHoodValue&& other) noexcept
+        : v(other.v)
+    {
+        rhLiveValues++;
+    }
+
+    ~RobinHoodValue() noexcept { rhLiveValues--; }
+
+    int v;
+};
+
+TEST(RobinHoodHashMap, BasicTest)
+{
+    RobinHoodMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.find(1), ht.iend());
+
+    const int kNumElements = 10000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, -i);
+        EXPECT_TRUE(it.second);
+        EXPECT_EQ(it.first.key(), i);
+        EXPECT_EQ(it.first.value(), -i);
+    }
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_FALSE(ht.emplace(i, 0).second);
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), -i);
+        EXPECT_FALSE(ht.has(-i - 1));
+    }
+
+    for (int i = 0; i < kNumElements; i += 3)
+    {
+        EXPECT_TRUE(ht.erase(i));
+    }
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_EQ(ht.has(i), (i % 3) != 0);
+    }
+}
+
+TEST(RobinHoodHashMap, BadHashFunction)
+{
+    RobinHoodMap<RobinHoodBadKey, int> ht;
+    const int kNumElements = 500;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_TRUE(ht.emplace(RobinHoodBadKey{i}, i).second);
+    }
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(RobinHoodBadKey{i}));
+    }
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.find(RobinHoodBadKey{i});
+        if (i & 1)
+        {
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value(), i);
+        }
+        else
+        {
+            EXPECT_EQ(it, ht.iend());
+        }
+    }
+    EXPECT_EQ(ht.find(RobinHoodBadKey{-5}), ht.iend());
+}
+
+TEST(RobinHoodHashMap, NoTombstonesUnderChurn)
+{
+    RobinHoodMap<uint32_t, uint32_t> ht;
+    const uint32_t kWindow = 1000;
+    for (uint32_t i = 0; i < kWindow; i++)
+    {
+        ht.emplace(i, i);
+    }
+    const uint32_t capacity = ht.capacity();
+
+    for (uint32_t i = kWindow; i < kWindow * 200; i++)
+    {
+        EXPECT_TRUE(ht.erase(i - kWindow));
+        EXPECT_TRUE(ht.emplace(i, i).second);
+    }
+
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_EQ(ht.capacity(), capacity);
+    EXPECT_EQ(ht.size(), kWindow);
+    for (uint32_t i = kWindow * 199; i < kWindow * 200; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i);
+    }
+}
+
+TEST(RobinHoodHashMap, RandomOpsAgainstStd)
+{
+    RobinHoodMap<int, int> ht;
+    std::unordered_map<int, int> ref;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> keyDist(0, 2000);
+
+    for (int i = 0; i < 200000; i++)
+    {
+        const int key = keyDist(rng);
+        if (rng() & 1)
+        {
+            const bool inserted = ht.emplace(key, i).second;
+            EXPECT_EQ(inserted, ref.emplace(key, i).second);
+        }
+        else
+        {
+            const bool erased = ht.erase(key);
+            EXPECT_EQ(erased, ref.erase(key) != 0);
+        }
+    }
+
+    EXPECT_EQ(ht.size(), uint32_t(ref.size()));
+    for (const auto& [key, value] : ref)
+    {
+        auto it = ht.find(key);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), value);
+    }
+    for (auto it = ht.ibegin(); it != ht.iend(); ++it)
+    {
+        EXPECT_EQ(ref.count(it.key()), 1u);
+    }
+}
+
+TEST(RobinHoodHashMap, EraseWhileIterating)
+{
+    RobinHoodMap<RobinHoodBadKey, int> ht;
+    for (int i = 0; i < 300; i++)
+    {
+        ht.emplace(RobinHoodBadKey{i}, i);
+    }
+
+    // backward shift moves not yet visited items into the erased slot, none of them can be skipped
+    int numVisited = 0;
+    for (auto it = ht.ibegin(); it != ht.iend();)
+    {
+        numVisited++;
+        if (it.value() % 3 == 0)
+        {
+            it = ht.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(numVisited, 300);
+    EXPECT_EQ(ht.size(), 200u);
+    for (int i = 0; i < 300; i++)
+    {
+        EXPECT_EQ(ht.has(RobinHoodBadKey{i}), (i % 3) != 0);
+    }
+
+    for (auto it = ht.ibegin(); it != ht.iend();)
+    {
+        it = ht.erase(it);
+    }
+    EXPECT_TRUE(ht.empty());
+}
+
+TEST(RobinHoodHashMap, EraseWhileIteratingVisitsEachItemOnce)
+{
+    // clusters that wrap around the end of the storage are shifted from the first bucket into the last one
+    std::mt19937 rnd(7);
+    for (int table = 0; table < 3000; table++)
+    {
+        RobinHoodMap<uint32_t, uint32_t> ht;
+        const uint32_t numItems = 8 + rnd() % 200;
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            const uint32_t key = rnd() % 1000000;
+            ht.emplace(key, key);
+        }
+
+        std::unordered_map<uint32_t, int> numVisits;
+        const uint32_t numItemsBefore = ht.size();
+        for (auto it = ht.ibegin(); it != ht.iend();)
+        {
+            const uint32_t value = it.value();
+            numVisits[value]++;
+            if ((value & 1) != 0)
+            {
+                it = ht.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        ASSERT_EQ(numVisits.size(), size_t(numItemsBefore));
+        for (const auto& kv : numVisits)
+        {
+            ASSERT_EQ(kv.second, 1) << "table " << table << " key " << kv.first;
+            EXPECT_EQ(ht.has(kv.first), (kv.first & 1) == 0);
+        }
+    }
+}
+
+TEST(RobinHoodHashMap, IteratorSize)
+{
+    // only Robin Hood iterators carry the start of the cyclic iteration
+    static_assert(sizeof(Excalibur::HashMap<uint32_t, uint32_t>::IteratorBase) == 2 * sizeof(void*), "Unexpected iterator size");
+    static_assert(sizeof(RobinHoodMap<uint32_t, uint32_t>::IteratorBase) == 3 * sizeof(void*), "Unexpected iterator size");
+
+    RobinHoodMap<uint32_t, uint32_t> ht;
+    ht.emplace(1u, 2u);
+    auto it = ht.ibegin();
+    auto copy = it;
+    copy = it;
+    EXPECT_EQ(copy.value(), 2u);
+    EXPECT_EQ(++copy, ht.iend());
+}
+
+TEST(RobinHoodHashMap, CtorDtorCallCount)
+{
+    rhLiveValues = 0;
+    {
+        RobinHoodMap<RobinHoodBadKey, RobinHoodValue> ht;
+        for (int i = 0; i < 1000; i++)
+        {
+            ht.emplace(RobinHoodBadKey{i}, i);
+        }
+        EXPECT_EQ(rhLiveValues, 1000);
+
+        for (int i = 0; i < 1000; i += 2)
+        {
+            ht.erase(RobinHoodBadKey{i});
+        }
+        EXPECT_EQ(rhLiveValues, 500);
+
+        for (int i = 1; i < 1000; i += 2)
+        {
+            auto it = ht.find(RobinHoodBadKey{i});
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value().v, i);
+        }
+
+        ht.rehash();
+        EXPECT_EQ(rhLiveValues, 500);
+    }
+    EXPECT_EQ(rhLiveValues, 0);
+}
+
+TEST(RobinHoodHashMap, InsertFromItself)
+{
+    RobinHoodMap<RobinHoodBadKey, std::string> ht;
+    ht.emplace(RobinHoodBadKey{0}, std::string(64, 'x'));
+    for (int i = 1; i < 1000; i++)
+    {
+        // the source item might be displaced by the new one
+        auto it = ht.find(RobinHoodBadKey{i - 1});
+        ASSERT_NE(it, ht.iend());
+        ht.emplace(RobinHoodBadKey{i}, it.value());
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        auto it = ht.find(RobinHoodBadKey{i});
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), std::string(64, 'x'));
+    }
+}
+
+TEST(RobinHoodHashMap, InlineStorageAndSet)
+{
+    RobinHoodMap<std::string, int, 8> ht;
+    for (int i = 0; i < 100; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    RobinHoodMap<std::string, int, 8> moved(std::move(ht));
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(moved.has(std::to_string(i)));
+    }
+
+    Excalibur::HashSet<int, 1, Excalibur::KeyInfo<int>, Excalibur::RobinHoodProbing> hs;
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(hs.emplace(i).second);
+    }
+    for (int i = 0; i < 100; i += 2)
+    {
+        EXPECT_TRUE(hs.erase(i));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(hs.has(i), (i & 1) != 0);
+    }
+}
+
+TEST(RobinHoodHashMap, LvalueKeyIsCopied)
+{
+    RobinHoodMap<std::string, int> rh;
+    Excalibur::HashMap<std::string, int> linear;
+    for (int i = 0; i < 100; i++)
+    {
+        const std::string constKey = std::to_string(i);
+        std::string key = std::to_string(i + 1000);
+        rh.emplace(constKey, i);
+        rh.emplace(key, i);
+        EXPECT_EQ(key, std::to_string(i + 1000));
+        linear.emplace(key, i);
+        EXPECT_EQ(key, std::to_string(i + 1000));
+    }
+    EXPECT_EQ(rh.size(), 200u);
+    EXPECT_EQ(linear.size(), 100u);
+}
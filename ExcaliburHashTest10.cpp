@@ -0,0 +1,281 @@
+#include "ExcaliburHashTestUtils.h"
+#include "ExcaliburIncrementalHash.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using ExcaliburTest::AllocStats;
+using ExcaliburTest::CountingAllocator;
+
+TEST(IncrementalHashMap, BasicTest)
+{
+    Excalibur::IncrementalHashMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.find(1), ht.iend());
+
+    const int kNumElements = 100000;
+    bool wasMigrating = false;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, -i);
+        EXPECT_TRUE(it.second);
+        EXPECT_EQ(it.first.key(), i);
+        EXPECT_EQ(it.first.value(), -i);
+        wasMigrating |= ht.isMigrating();
+    }
+    EXPECT_TRUE(wasMigrating);
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, 0);
+        EXPECT_FALSE(it.second);
+        EXPECT_EQ(it.first.value(), -i);
+    }
+
+    const auto& cht = ht;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = cht.find(i);
+        ASSERT_NE(it, cht.iend());
+        EXPECT_EQ(it.value(), -i);
+    }
+
+    ht.finishMigration();
+    EXPECT_FALSE(ht.isMigrating());
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+}
+
+TEST(IncrementalHashMap, OperationsDuringMigration)
+{
+    Excalibur::IncrementalHashMap<uint32_t, std::string> ht;
+    std::unordered_map<uint32_t, std::string> ref;
+    std::mt19937 rng(7);
+
+    uint32_t numMigratingOps = 0;
+    for (uint32_t i = 0; i < 200000; i++)
+    {
+        const uint32_t key = rng() % 50000;
+        switch (rng() % 3)
+        {
+        case 0:
+        {
+            const bool inserted = ht.emplace(key, std::to_string(key)).second;
+            EXPECT_EQ(inserted, ref.emplace(key, std::to_string(key)).second);
+            break;
+        }
+        case 1:
+        {
+            const bool erased = ht.erase(key);
+            EXPECT_EQ(erased, ref.erase(key) != 0);
+            break;
+        }
+        default:
+        {
+            auto it = ht.find(key);
+            auto refIt = ref.find(key);
+            ASSERT_EQ(it != ht.iend(), refIt != ref.end());
+            if (refIt != ref.end())
+            {
+                EXPECT_EQ(it.value(), refIt->second);
+            }
+            break;
+        }
+        }
+        numMigratingOps += ht.isMigrating() ? 1 : 0;
+    }
+    EXPECT_GT(numMigratingOps, 0u);
+    EXPECT_EQ(ht.size(), uint32_t(ref.size()));
+
+    // iteration covers both arrays
+    size_t numItems = 0;
+    for (const auto& [key, value] : ht.items())
+    {
+        auto refIt = ref.find(key);
+        ASSERT_NE(refIt, ref.end());
+        EXPECT_EQ(refIt->second, value.get());
+        numItems++;
+    }
+    EXPECT_EQ(numItems, ref.size());
+}
+
+TEST(IncrementalHashMap, IterationWhileMigrating)
+{
+    Excalibur::IncrementalHashMap<int, int> ht;
+    int i = 0;
+    while (!ht.isMigrating())
+    {
+        ht.emplace(i, i);
+        i++;
+    }
+    ht.emplace(i, i);
+    ASSERT_TRUE(ht.isMigrating());
+    const int numElements = i + 1;
+
+    int64_t keysSum = 0;
+    int numKeys = 0;
+    for (int key : ht)
+    {
+        keysSum += key;
+        numKeys++;
+    }
+    EXPECT_EQ(numKeys, numElements);
+    EXPECT_EQ(keysSum, int64_t(numElements) * (numElements - 1) / 2);
+
+    int64_t valuesSum = 0;
+    for (int& value : ht.values())
+    {
+        valuesSum += value;
+    }
+    EXPECT_EQ(valuesSum, keysSum);
+
+    // copy and move keep all items reachable
+    Excalibur::IncrementalHashMap<int, int> copy(ht);
+    Excalibur::IncrementalHashMap<int, int> moved(std::move(ht));
+    EXPECT_TRUE(ht.empty());
+    for (int k = 0; k < numElements; k++)
+    {
+        EXPECT_TRUE(copy.has(k));
+        EXPECT_TRUE(moved.has(k));
+        EXPECT_TRUE(copy.erase(k));
+    }
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.isMigrating());
+}
+
+TEST(IncrementalHashMap, InsertFromItself)
+{
+    Excalibur::IncrementalHashMap<int, std::string> ht;
+    ht.emplace(0, std::string(64, 'a'));
+    for (int i = 1; i < 20000; i++)
+    {
+        auto it = ht.find(i / 2);
+        ASSERT_NE(it, ht.iend());
+        ht.emplace(i, it.value());
+    }
+    for (int i = 0; i < 20000; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), std::string(64, 'a'));
+    }
+}
+
+TEST(IncrementalHashSet, ClearAndReserve)
+{
+    Excalibur::IncrementalHashSet<int> hs;
+    for (int i = 0; i < 10000; i++)
+    {
+        hs.emplace(i);
+    }
+    hs.clear();
+    EXPECT_TRUE(hs.empty());
+    EXPECT_FALSE(hs.isMigrating());
+    EXPECT_FALSE(hs.has(1));
+
+    for (int i = 0; i < 10000; i++)
+    {
+        hs.emplace(i);
+    }
+    EXPECT_TRUE(hs.reserve(1 << 16));
+    EXPECT_FALSE(hs.isMigrating());
+    EXPECT_EQ(hs.capacity(), uint32_t(1 << 16));
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_TRUE(hs.has(i));
+    }
+}
+
+TEST(IncrementalHashMap, GrowthInSteps)
+{
+    // the next bucket array is allocated at half load and initialized by the following operations
+    Excalibur::IncrementalHashMap<int, std::string> ht;
+    int numElements = 0;
+    uint32_t numGrowths = 0;
+    while (numGrowths < 3)
+    {
+        const uint32_t capacity = ht.capacity();
+        ht.emplace(numElements, std::to_string(numElements));
+        numElements++;
+        if (ht.capacity() != capacity)
+        {
+            numGrowths += (capacity >= 4096) ? 1 : 0;
+        }
+
+        if ((numElements % 1500) == 0)
+        {
+            // copies and moves in the middle of the preparation/migration
+            Excalibur::IncrementalHashMap<int, std::string> copy(ht);
+            Excalibur::IncrementalHashMap<int, std::string> moved(std::move(copy));
+            copy = moved;
+            moved = std::move(copy);
+            ASSERT_EQ(moved.size(), uint32_t(numElements));
+            for (int k = 0; k < numElements; k += 7)
+            {
+                auto it = moved.find(k);
+                ASSERT_NE(it, moved.iend());
+                EXPECT_EQ(it.value(), std::to_string(k));
+            }
+        }
+    }
+
+    // migration moves a bounded number of buckets per step
+    ASSERT_TRUE(ht.isMigrating());
+    const uint32_t numPreviousBuckets = ht.capacity() / 2;
+    uint32_t numSteps = 1;
+    while (!ht.migrate(16))
+    {
+        numSteps++;
+    }
+    EXPECT_LE(numSteps, numPreviousBuckets / 16);
+    EXPECT_EQ(ht.size(), uint32_t(numElements));
+    for (int k = 0; k < numElements; k++)
+    {
+        ASSERT_TRUE(ht.has(k));
+    }
+
+    ht.clear();
+    EXPECT_TRUE(ht.empty());
+    for (int k = 0; k < 5000; k++)
+    {
+        ht.emplace(k, std::to_string(k));
+    }
+    EXPECT_EQ(ht.size(), 5000u);
+}
+
+TEST(IncrementalHashMap, StatefulAllocatorAndShrink)
+{
+    using TMap = Excalibur::IncrementalHashMap<int, int, 1, Excalibur::KeyInfo<int>, CountingAllocator, Excalibur::ShrinkIfSparse<>>;
+    AllocStats stats;
+    {
+        TMap ht{CountingAllocator(stats)};
+        EXPECT_EQ(ht.getAllocator().stats, &stats);
+        // the next array is allocated through the same allocator while the previous one is migrated
+        bool wasMigrating = false;
+        for (int i = 0; i < 20000; i++)
+        {
+            ht.emplace(i, i * 2);
+            wasMigrating |= ht.isMigrating();
+        }
+        EXPECT_TRUE(wasMigrating);
+        EXPECT_GT(stats.numAllocs, 2);
+
+        TMap moved(std::move(ht));
+        EXPECT_EQ(moved.getAllocator().stats, &stats);
+        EXPECT_EQ(ht.getAllocator().stats, &stats);
+        moved.finishMigration();
+        const uint32_t capacity = moved.capacity();
+        for (int i = 0; i < 19900; i++)
+        {
+            EXPECT_TRUE(moved.erase(i));
+        }
+        EXPECT_LT(moved.capacity(), capacity);
+        for (int i = 19900; i < 20000; i++)
+        {
+            EXPECT_EQ(moved.find(i).value(), i * 2);
+        }
+    }
+    EXPECT_EQ(stats.numAllocs, stats.numFrees);
+    EXPECT_EQ(stats.numBytesAlive, 0u);
+}
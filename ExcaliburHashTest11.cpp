@@ -0,0 +1,242 @@
+#include "ExcaliburConcurrentHash.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentHashMap, BasicTest)
+{
+    Excalibur::ConcurrentHashMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    int value = 0;
+    EXPECT_FALSE(ht.find(1, value));
+
+    const int kNumElements = 100000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_TRUE(ht.emplace(i, -i));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_FALSE(ht.emplace(i, 0));
+        ASSERT_TRUE(ht.find(i, value));
+        EXPECT_EQ(value, -i);
+        EXPECT_FALSE(ht.has(-i - 1));
+    }
+
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(i));
+        EXPECT_FALSE(ht.erase(i));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements / 2));
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_EQ(ht.has(i), (i & 1) != 0);
+    }
+
+    EXPECT_FALSE(ht.insertOrAssign(1, 100));
+    EXPECT_TRUE(ht.insertOrAssign(0, 200));
+    ASSERT_TRUE(ht.find(1, value));
+    EXPECT_EQ(value, 100);
+    ASSERT_TRUE(ht.find(0, value));
+    EXPECT_EQ(value, 200);
+
+    int64_t sum = 0;
+    uint32_t numItems = 0;
+    ht.forEach(
+        [&](int key, int v)
+        {
+            EXPECT_EQ(ht.has(key), true);
+            sum += v;
+            numItems++;
+        });
+    EXPECT_EQ(numItems, ht.size());
+}
+
+TEST(ConcurrentHashMap, TombstoneChurn)
+{
+    Excalibur::ConcurrentHashMap<uint32_t, uint32_t> ht;
+    const uint32_t kWindow = 1000;
+    for (uint32_t i = 0; i < kWindow * 100; i++)
+    {
+        EXPECT_TRUE(ht.emplace(i, i));
+        if (i >= kWindow)
+        {
+            EXPECT_TRUE(ht.erase(i - kWindow));
+        }
+    }
+    EXPECT_EQ(ht.size(), kWindow);
+    // tombstones are purged by rehashing in place
+    EXPECT_LE(ht.capacity(), 4096u);
+    for (uint32_t i = kWindow * 99; i < kWindow * 100; i++)
+    {
+        uint32_t value = 0;
+        ASSERT_TRUE(ht.find(i, value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(ConcurrentHashMap, ReadersDuringGrowth)
+{
+    Excalibur::ConcurrentHashMap<uint64_t, uint64_t> ht;
+    const uint64_t kNumElements = 200000;
+    std::atomic<uint64_t> numPublished{0};
+    std::atomic<bool> isDone{false};
+    std::atomic<uint32_t> numErrors{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!isDone.load())
+                {
+                    // everything published before must be visible with the right value
+                    const uint64_t numKeys = numPublished.load();
+                    for (uint64_t key = (numKeys > 64) ? numKeys - 64 : 0; key < numKeys; key++)
+                    {
+                        uint64_t value = 0;
+                        if (!ht.find(key, value) || value != key * 7)
+                        {
+                            numErrors++;
+                        }
+                    }
+                    uint64_t value = 0;
+                    if (ht.find(kNumElements + 1, value))
+                    {
+                        numErrors++;
+                    }
+                }
+            });
+    }
+
+    for (uint64_t key = 0; key < kNumElements; key++)
+    {
+        ht.emplace(key, key * 7);
+        numPublished.store(key + 1);
+    }
+    isDone.store(true);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(numErrors.load(), 0u);
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+}
+
+TEST(ConcurrentHashMap, ConcurrentWriters)
+{
+    Excalibur::ConcurrentHashMap<uint32_t, uint32_t> ht;
+    const uint32_t kNumThreads = 4;
+    const uint32_t kNumKeys = 50000;
+
+    // every thread inserts the same keys, exactly one insert per key has to win
+    std::atomic<uint32_t> numInserted{0};
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < kNumThreads; t++)
+    {
+        writers.emplace_back(
+            [&, t]()
+            {
+                for (uint32_t i = 0; i < kNumKeys; i++)
+                {
+                    const uint32_t key = (i * 7919u + t * 13u) % kNumKeys;
+                    if (ht.emplace(key, key + 1))
+                    {
+                        numInserted++;
+                    }
+                }
+            });
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    EXPECT_EQ(numInserted.load(), kNumKeys);
+    EXPECT_EQ(ht.size(), kNumKeys);
+
+    uint32_t numItems = 0;
+    ht.forEach(
+        [&](uint32_t key, uint32_t value)
+        {
+            EXPECT_EQ(value, key + 1);
+            numItems++;
+        });
+    EXPECT_EQ(numItems, kNumKeys);
+
+    // concurrent erase + insert on disjoint key ranges
+    writers.clear();
+    for (uint32_t t = 0; t < kNumThreads; t++)
+    {
+        writers.emplace_back(
+            [&, t]()
+            {
+                for (uint32_t key = t; key < kNumKeys; key += kNumThreads)
+                {
+                    EXPECT_TRUE(ht.erase(key));
+                    EXPECT_TRUE(ht.emplace(key + kNumKeys, key));
+                }
+            });
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    EXPECT_EQ(ht.size(), kNumKeys);
+    for (uint32_t key = 0; key < kNumKeys; key++)
+    {
+        uint32_t value = 0;
+        EXPECT_FALSE(ht.has(key));
+        ASSERT_TRUE(ht.find(key + kNumKeys, value));
+        EXPECT_EQ(value, key);
+    }
+}
+
+TEST(ConcurrentHashMap, ManyReaderThreads)
+{
+    // more threads alive at the same time than a single block of epoch slots
+    Excalibur::ConcurrentHashMap<int, int> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(i, i * 2);
+    }
+
+    const int kNumThreads = int(Excalibur::detail::EpochDomain::kSlotsPerBlock) * 10 + 3;
+    std::atomic<int> numStarted{0};
+    std::atomic<int> numFound{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; t++)
+    {
+        threads.emplace_back(
+            [&ht, &numStarted, &numFound, t, kNumThreads]()
+            {
+                int value = 0;
+                numFound += (ht.find(t % 1000, value) && value == (t % 1000) * 2) ? 1 : 0;
+                numStarted++;
+                // keep the thread (and its slot) alive until every thread has one
+                while (numStarted.load() < kNumThreads)
+                {
+                    std::this_thread::yield();
+                }
+                numFound += ht.has(t % 1000) ? 1 : 0;
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(numFound.load(), kNumThreads * 2);
+
+    // slots are reused, growth still reclaims the old arrays
+    for (int i = 1000; i < 100000; i++)
+    {
+        ht.emplace(i, i * 2);
+    }
+    int value = 0;
+    ASSERT_TRUE(ht.find(99999, value));
+    EXPECT_EQ(value, 99999 * 2);
+}
@@ -0,0 +1,187 @@
+#include "ExcaliburHashTestUtils.h"
+#include "ExcaliburShardedHash.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ExcaliburTest::AllocStats;
+using ExcaliburTest::CountingAllocator;
+
+TEST(ShardedHashMap, BasicTest)
+{
+    Excalibur::ShardedHashMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.begin(), ht.end());
+    int value = 0;
+    EXPECT_FALSE(ht.find(1, value));
+
+    const int kNumElements = 10000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_TRUE(ht.emplace(i, -i));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    // top bits of the hash spread keys over all the shards
+    for (uint32_t i = 0; i < ht.getNumShards(); i++)
+    {
+        EXPECT_GT(ht.getShardSize(i), uint32_t(kNumElements / ht.getNumShards() / 2));
+    }
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_FALSE(ht.emplace(i, 0));
+        ASSERT_TRUE(ht.find(i, value));
+        EXPECT_EQ(value, -i);
+        EXPECT_FALSE(ht.has(-i - 1));
+    }
+
+    EXPECT_TRUE(ht.visit(5, [](int& v) { v = 500; }));
+    EXPECT_FALSE(ht.visit(-5, [](int& v) { v = 500; }));
+    ASSERT_TRUE(ht.find(5, value));
+    EXPECT_EQ(value, 500);
+
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(i));
+        EXPECT_FALSE(ht.erase(i));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements / 2));
+
+    int numItems = 0;
+    for (const auto& [key, v] : ht.items())
+    {
+        EXPECT_EQ(key & 1, 1);
+        EXPECT_EQ(v.get(), (key == 5) ? 500 : -key);
+        numItems++;
+    }
+    EXPECT_EQ(numItems, kNumElements / 2);
+
+    ht.clear();
+    EXPECT_TRUE(ht.empty());
+}
+
+TEST(ShardedHashMap, IterationSkipsEmptyShards)
+{
+    Excalibur::ShardedHashMap<std::string, std::string, 64> ht;
+    EXPECT_EQ(ht.items().begin(), ht.items().end());
+
+    ht.emplace(std::string("a"), std::string("1"));
+    ht.emplace(std::string("b"), std::string("2"));
+    ht.emplace(std::string("c"), std::string("3"));
+
+    std::string keys;
+    for (const std::string& key : ht)
+    {
+        keys += key;
+    }
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, "abc");
+
+    for (std::string& value : ht.values())
+    {
+        value += "!";
+    }
+    std::string value;
+    ASSERT_TRUE(ht.find(std::string("b"), value));
+    EXPECT_EQ(value, "2!");
+
+    Excalibur::ShardedHashSet<int, 1> hs;
+    EXPECT_TRUE(hs.emplace(1));
+    EXPECT_FALSE(hs.emplace(1));
+    EXPECT_TRUE(hs.has(1));
+    EXPECT_EQ(hs.getShardIndex(1), 0u);
+}
+
+TEST(ShardedHashMap, PerShardReserve)
+{
+    Excalibur::ShardedHashMap<uint32_t, uint32_t, 8> ht;
+    EXPECT_TRUE(ht.reserve(3, 1024));
+    EXPECT_EQ(ht.getShardCapacity(3), 1024u);
+    EXPECT_LT(ht.getShardCapacity(2), 1024u);
+
+    EXPECT_TRUE(ht.reserve(256));
+    for (uint32_t i = 0; i < ht.getNumShards(); i++)
+    {
+        EXPECT_GE(ht.getShardCapacity(i), 256u);
+    }
+}
+
+TEST(ShardedHashMap, ShardPolicies)
+{
+    using TMap = Excalibur::ShardedHashMap<int, int, 4, 1, Excalibur::KeyInfo<int>, Excalibur::RobinHoodProbing, CountingAllocator,
+                                           Excalibur::ShrinkIfSparse<>>;
+    AllocStats stats;
+    {
+        TMap ht{CountingAllocator(stats)};
+        for (uint32_t i = 0; i < ht.getNumShards(); i++)
+        {
+            EXPECT_EQ(ht.getAllocator(i).stats, &stats);
+        }
+        for (int i = 0; i < 10000; i++)
+        {
+            EXPECT_TRUE(ht.emplace(i, i * 2));
+        }
+        EXPECT_GE(stats.numAllocs, int(ht.getNumShards()));
+        const uint32_t capacity = ht.getShardCapacity(0);
+        for (int i = 0; i < 9900; i++)
+        {
+            EXPECT_TRUE(ht.erase(i));
+        }
+        EXPECT_LT(ht.getShardCapacity(0), capacity);
+        EXPECT_EQ(ht.size(), 100u);
+        int value = 0;
+        EXPECT_TRUE(ht.find(9999, value));
+        EXPECT_EQ(value, 9999 * 2);
+    }
+    EXPECT_EQ(stats.numAllocs, stats.numFrees);
+    EXPECT_EQ(stats.numBytesAlive, 0u);
+}
+
+TEST(ShardedHashMap, ConcurrentWriters)
+{
+    Excalibur::ShardedHashMap<uint32_t, uint32_t> ht;
+    const uint32_t kNumThreads = 4;
+    const uint32_t kNumKeys = 50000;
+
+    std::atomic<uint32_t> numInserted{0};
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < kNumThreads; t++)
+    {
+        writers.emplace_back(
+            [&, t]()
+            {
+                for (uint32_t i = 0; i < kNumKeys; i++)
+                {
+                    const uint32_t key = (i * 7919u + t * 13u) % kNumKeys;
+                    if (ht.emplace(key, key + 1))
+                    {
+                        numInserted++;
+                    }
+                    if ((key % 3) == 0)
+                    {
+                        ht.erase(key);
+                    }
+                }
+            });
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    EXPECT_GE(numInserted.load(), kNumKeys);
+
+    uint32_t numItems = 0;
+    ht.forEach(
+        [&](uint32_t key, uint32_t value)
+        {
+            EXPECT_NE(key % 3, 0u);
+            EXPECT_EQ(value, key + 1);
+            numItems++;
+        });
+    EXPECT_EQ(numItems, ht.size());
+    EXPECT_EQ(numItems, kNumKeys - (kNumKeys + 2) / 3);
+}
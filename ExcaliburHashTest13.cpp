@@ -0,0 +1,198 @@
+#include "ExcaliburAllocators.h"
+#include "ExcaliburHash.h"
+#include "ExcaliburHashTestUtils.h"
+#include "gtest/gtest.h"
+#include <string>
+
+namespace
+{
+
+using ExcaliburTest::AllocStats;
+using ExcaliburTest::CountingAllocator;
+
+struct StatelessAllocator
+{
+    static void* allocate(size_t numBytes, size_t alignment) { return EXLBR_ALLOC(numBytes, alignment); }
+    static void deallocate(void* ptr, size_t /*numBytes*/, size_t /*alignment*/) { EXLBR_FREE(ptr); }
+};
+
+template <typename TAllocator>
+using AllocHashMap = Excalibur::HashMap<int, std::string, 1, Excalibur::KeyInfo<int>, Excalibur::LinearProbing, TAllocator>;
+
+} // namespace
+
+TEST(Allocators, DefaultAllocatorTakesNoSpace)
+{
+    static_assert(sizeof(Excalibur::HashMap<int, int>) ==
+                      sizeof(Excalibur::HashMap<int, int, 1, Excalibur::KeyInfo<int>, Excalibur::LinearProbing, StatelessAllocator>),
+                  "Stateless allocators should not increase the hash table size");
+    static_assert(sizeof(AllocHashMap<CountingAllocator>) > sizeof(AllocHashMap<Excalibur::DefaultAllocator>), "Stateful allocator is stored");
+}
+
+TEST(Allocators, StatefulAllocatorRouting)
+{
+    AllocStats stats;
+    {
+        AllocHashMap<CountingAllocator> ht{CountingAllocator(stats)};
+        for (int i = 0; i < 1000; i++)
+        {
+            ht.emplace(i, std::to_string(i));
+        }
+        EXPECT_GT(stats.numAllocs, 1);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        ht.rehash();
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        // copies and moves take the allocator with them
+        AllocHashMap<CountingAllocator> copy(ht);
+        EXPECT_EQ(copy.getAllocator().stats, &stats);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+
+        AllocHashMap<CountingAllocator> moved(std::move(copy));
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+
+        AllocStats otherStats;
+        AllocHashMap<CountingAllocator> other{CountingAllocator(otherStats)};
+        other.emplace(1, "1");
+        other = std::move(moved);
+        EXPECT_EQ(other.getAllocator().stats, &stats);
+        EXPECT_EQ(otherStats.numBytesAlive, 0u);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            auto it = other.find(i);
+            ASSERT_NE(it, other.iend());
+            EXPECT_EQ(it.value(), std::to_string(i));
+        }
+    }
+    EXPECT_EQ(stats.numAllocs, stats.numFrees);
+    EXPECT_EQ(stats.numBytesAlive, 0u);
+}
+
+TEST(Allocators, Arena)
+{
+    Excalibur::Arena arena(4096);
+    for (int frame = 0; frame < 3; frame++)
+    {
+        {
+            AllocHashMap<Excalibur::ArenaAllocator> ht{Excalibur::ArenaAllocator(arena)};
+            for (int i = 0; i < 5000; i++)
+            {
+                ht.emplace(i, std::to_string(i));
+            }
+            for (int i = 0; i < 5000; i++)
+            {
+                EXPECT_TRUE(ht.has(i));
+            }
+            EXPECT_GT(arena.getNumBytesUsed(), 0u);
+        }
+        arena.reset();
+        EXPECT_EQ(arena.getNumBytesUsed(), 0u);
+    }
+
+    // the most recent allocation can be rolled back
+    void* a = arena.allocate(128, 64);
+    void* b = arena.allocate(64, 64);
+    arena.deallocate(b, 64);
+    EXPECT_EQ(arena.allocate(64, 64), b);
+    arena.deallocate(a, 128);
+    EXPECT_EQ(arena.getNumBytesUsed(), 192u);
+}
+
+TEST(Allocators, Pool)
+{
+    Excalibur::Pool pool;
+    {
+        AllocHashMap<Excalibur::PoolAllocator> ht{Excalibur::PoolAllocator(pool)};
+        for (int i = 0; i < 5000; i++)
+        {
+            ht.emplace(i, std::to_string(i));
+        }
+        // every intermediate array is cached
+        EXPECT_GT(pool.getNumBytesCached(), 0u);
+    }
+    const size_t numBytesCached = pool.getNumBytesCached();
+    {
+        // second round is served from the pool
+        AllocHashMap<Excalibur::PoolAllocator> ht{Excalibur::PoolAllocator(pool)};
+        for (int i = 0; i < 5000; i++)
+        {
+            ht.emplace(i, std::to_string(i));
+        }
+        EXPECT_LT(pool.getNumBytesCached(), numBytesCached);
+        for (int i = 0; i < 5000; i++)
+        {
+            EXPECT_TRUE(ht.has(i));
+        }
+    }
+    EXPECT_EQ(pool.getNumBytesCached(), numBytesCached);
+    pool.trim();
+    EXPECT_EQ(pool.getNumBytesCached(), 0u);
+}
+
+TEST(Allocators, HugePages)
+{
+    Excalibur::HashMap<uint64_t, uint64_t, 1, Excalibur::KeyInfo<uint64_t>, Excalibur::LinearProbing, Excalibur::HugePageAllocator> ht;
+    const uint64_t kNumElements = 300000;
+    for (uint64_t i = 0; i < kNumElements; i++)
+    {
+        ht.emplace(i, i * 2);
+    }
+    for (uint64_t i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i * 2);
+    }
+
+    const size_t numBytes = Excalibur::HugePageAllocator::k_HugePageSize * 3;
+    Excalibur::HugePageAllocator allocator;
+    void* ptr = allocator.allocate(numBytes, 64);
+    ASSERT_NE(ptr, nullptr);
+    memset(ptr, 0xcc, numBytes);
+    allocator.deallocate(ptr, numBytes, 64);
+}
+
+TEST(Allocators, HugePageOptions)
+{
+    // small threshold: even small tables are mapped (and aligned to the huge page boundary)
+    Excalibur::HugePageOptions options;
+    options.threshold = 4096;
+    options.mode = Excalibur::HugePageMode::Explicit;
+    options.numaPolicy = Excalibur::NumaPolicy::Interleave;
+    options.numaNodeMask = 1;
+
+    using HugePageMap = Excalibur::HashMap<uint64_t, uint64_t, 1, Excalibur::KeyInfo<uint64_t>, Excalibur::LinearProbing, Excalibur::HugePageAllocator>;
+    HugePageMap ht{Excalibur::HugePageAllocator(options)};
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        ht.emplace(i, i + 1);
+    }
+#if defined(__linux__)
+    void* mapped = ht.getAllocator().allocate(8192, 64);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped) % Excalibur::HugePageAllocator::k_HugePageSize, 0u);
+    ht.getAllocator().deallocate(mapped, 8192, 64);
+#endif
+
+    // options travel with the table
+    HugePageMap copy(ht);
+    EXPECT_EQ(copy.getAllocator().getOptions().threshold, 4096u);
+    HugePageMap other;
+    other = std::move(copy);
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        auto it = other.find(i);
+        ASSERT_NE(it, other.iend());
+        EXPECT_EQ(it.value(), i + 1);
+    }
+
+    options.numaPolicy = Excalibur::NumaPolicy::Bind;
+    options.mode = Excalibur::HugePageMode::Transparent;
+    Excalibur::HugePageAllocator bindAllocator(options);
+    void* ptr = bindAllocator.allocate(1 << 20, 64);
+    ASSERT_NE(ptr, nullptr);
+    memset(ptr, 0x11, 1 << 20);
+    bindAllocator.deallocate(ptr, 1 << 20, 64);
+}
@@ -0,0 +1,105 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(FindBatch, MatchesFind)
+{
+    Excalibur::HashMap<int, int> ht;
+
+    std::vector<int> keys;
+    for (int i = -1000; i < 1000; i++)
+    {
+        keys.push_back(i);
+    }
+
+    // empty table (inline storage)
+    {
+        std::vector<Excalibur::HashMap<int, int>::IteratorKV> out(keys.size(), ht.iend());
+        ht.findBatch(keys.data(), keys.size(), out.data());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            EXPECT_EQ(out[i], ht.iend());
+        }
+    }
+
+    for (int i = 0; i < 700; i++)
+    {
+        ht.emplace(i, i * 2);
+    }
+    for (int i = 0; i < 700; i += 7)
+    {
+        ht.erase(i);
+    }
+
+    // odd sizes (not a multiple of the internal group size)
+    for (size_t numKeys : {size_t(0), size_t(1), size_t(15), size_t(17), keys.size()})
+    {
+        std::vector<Excalibur::HashMap<int, int>::IteratorKV> out(numKeys, ht.iend());
+        ht.findBatch(keys.data(), numKeys, out.data());
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            EXPECT_EQ(out[i], ht.find(keys[i]));
+        }
+    }
+
+    // values are writable through batch iterators
+    std::vector<Excalibur::HashMap<int, int>::IteratorKV> out(keys.size(), ht.iend());
+    ht.findBatch(keys.data(), keys.size(), out.data());
+    for (auto& it : out)
+    {
+        if (it != ht.iend())
+        {
+            it.value() = -it.key();
+        }
+    }
+    for (int i = 1; i < 700; i++)
+    {
+        EXPECT_EQ(ht[i], (i % 7) ? -i : 0);
+    }
+
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    const auto& cht = ht;
+    const size_t numFound = cht.hasBatch(keys.data(), keys.size(), found.get());
+    EXPECT_EQ(numFound, ht.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        EXPECT_EQ(found[i], ht.has(keys[i]));
+    }
+
+    std::vector<Excalibur::HashMap<int, int>::ConstIteratorKV> constOut(keys.size(), cht.iend());
+    cht.findBatch(keys.data(), keys.size(), constOut.data());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        EXPECT_EQ(constOut[i], cht.find(keys[i]));
+    }
+}
+
+TEST(FindBatch, RobinHoodAndStrings)
+{
+    Excalibur::HashMap<std::string, int, 1, Excalibur::KeyInfo<std::string>, Excalibur::RobinHoodProbing> ht;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3000; i++)
+    {
+        keys.push_back(std::to_string(i));
+        if (i & 1)
+        {
+            ht.emplace(keys.back(), i);
+        }
+    }
+
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    EXPECT_EQ(ht.hasBatch(keys.data(), keys.size(), found.get()), size_t(1500));
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        EXPECT_EQ(found[i], (i & 1) != 0);
+    }
+
+    Excalibur::HashSet<int> hs;
+    hs.emplace(3);
+    const int setKeys[] = {1, 2, 3, 4};
+    bool setFound[4] = {};
+    EXPECT_EQ(hs.hasBatch(setKeys, 4, setFound), size_t(1));
+    EXPECT_TRUE(setFound[2]);
+}
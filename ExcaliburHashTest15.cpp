@@ -0,0 +1,88 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST(InsertBatch, BasicTest)
+{
+    Excalibur::HashMap<int, int> ht;
+    std::vector<std::pair<int, int>> items;
+    for (int i = 0; i < 10000; i++)
+    {
+        items.emplace_back(i, -i);
+    }
+
+    EXPECT_EQ(ht.insertBatch(items.begin(), items.end()), 10000u);
+    EXPECT_EQ(ht.size(), 10000u);
+    // single allocation: the smallest capacity that fits all the items
+    EXPECT_EQ(ht.capacity(), 16384u);
+    for (int i = 0; i < 10000; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), -i);
+    }
+
+    // existing keys are left untouched, duplicates inside the batch are inserted once
+    std::vector<std::pair<int, int>> more = {{5, 0}, {20000, 1}, {20000, 2}, {20001, 3}};
+    EXPECT_EQ(ht.insertBatch(more.begin(), more.end()), 2u);
+    EXPECT_EQ(ht[5], -5);
+    EXPECT_EQ(ht[20000], 1);
+    EXPECT_EQ(ht[20001], 3);
+
+    // empty batch
+    EXPECT_EQ(ht.insertBatch(more.end(), more.end()), 0u);
+
+    // any std::pair-like container works
+    std::unordered_map<int, int> src = {{-1, 1}, {-2, 2}};
+    Excalibur::HashMap<int, int> fromMap;
+    EXPECT_EQ(fromMap.insertBatch(src.begin(), src.end()), 2u);
+    EXPECT_EQ(fromMap[-2], 2);
+}
+
+TEST(InsertBatch, TombstonesAndRobinHood)
+{
+    Excalibur::HashMap<std::string, std::string> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(std::to_string(i), std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        ht.erase(std::to_string(i));
+    }
+    EXPECT_GT(ht.getNumTombstones(), 0u);
+
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (int i = 0; i < 3000; i++)
+    {
+        keys.push_back(std::to_string(i));
+        values.push_back("v" + std::to_string(i));
+    }
+    EXPECT_EQ(ht.emplaceBatch(keys.data(), values.data(), keys.size()), 2500u);
+    EXPECT_EQ(ht.size(), 3000u);
+    for (int i = 0; i < 3000; i++)
+    {
+        auto it = ht.find(std::to_string(i));
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), ((i < 1000) && (i & 1)) ? std::to_string(i) : "v" + std::to_string(i));
+        // source arrays are copied, not moved from
+        EXPECT_EQ(keys[i], std::to_string(i));
+    }
+
+    Excalibur::HashSet<int, 1, Excalibur::KeyInfo<int>, Excalibur::RobinHoodProbing> hs;
+    std::vector<int> setKeys;
+    for (int i = 0; i < 5000; i++)
+    {
+        setKeys.push_back(i % 4000);
+    }
+    EXPECT_EQ(hs.insertBatch(setKeys.begin(), setKeys.end()), 4000u);
+    EXPECT_EQ(hs.emplaceBatch(setKeys.data(), setKeys.size()), 0u);
+    for (int i = 0; i < 4000; i++)
+    {
+        EXPECT_TRUE(hs.has(i));
+    }
+    EXPECT_FALSE(hs.has(4000));
+}
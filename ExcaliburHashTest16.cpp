@@ -0,0 +1,176 @@
+#include "ExcaliburHashTestUtils.h"
+#include "ExcaliburSplitHash.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <memory>
+#include <string>
+
+using ExcaliburTest::AllocStats;
+using ExcaliburTest::CountingAllocator;
+
+TEST(SplitHashMap, BasicTest)
+{
+    Excalibur::SplitHashMap<int, int> ht;
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.size(), 0u);
+    EXPECT_EQ(ht.find(13), ht.iend());
+    EXPECT_EQ(ht.ibegin(), ht.iend());
+    EXPECT_FALSE(ht.has(13));
+    EXPECT_FALSE(ht.erase(13));
+
+    const int kNumElements = 10000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, -i);
+        EXPECT_TRUE(it.second);
+        EXPECT_EQ(it.first.key(), i);
+        EXPECT_EQ(it.first.value(), -i);
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.emplace(i, 1);
+        EXPECT_FALSE(it.second);
+        EXPECT_EQ(it.first.value(), -i);
+        EXPECT_FALSE(ht.has(kNumElements + i));
+    }
+
+    int64_t sum = 0;
+    for (auto it = ht.ibegin(); it != ht.iend(); ++it)
+    {
+        EXPECT_EQ(it->first, -it->second);
+        sum += it.key();
+    }
+    EXPECT_EQ(sum, int64_t(kNumElements) * (kNumElements - 1) / 2);
+
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(i));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements / 2));
+    EXPECT_GT(ht.getNumTombstones(), 0u);
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_EQ(ht.has(i), (i & 1) != 0);
+    }
+
+    // tombstones are reused
+    for (int i = 0; i < kNumElements; i += 2)
+    {
+        ht[i] = i;
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+
+    ht.rehash();
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_EQ(ht[10], 10);
+    EXPECT_EQ(ht[11], -11);
+
+    ht.clear();
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(ht.ibegin(), ht.iend());
+    EXPECT_FALSE(ht.has(11));
+}
+
+TEST(SplitHashMap, LargeValuesAndCopyMove)
+{
+    using Value = std::array<uint64_t, 16>;
+    Excalibur::SplitHashMap<std::string, Value> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        Value value;
+        value.fill(uint64_t(i));
+        ht.emplace(std::to_string(i), value);
+    }
+
+    // erase while iterating
+    for (auto it = ht.ibegin(); it != ht.iend();)
+    {
+        if (std::stoi(it.key()) % 3 == 0)
+        {
+            it = ht.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(ht.size(), 666u);
+
+    Excalibur::SplitHashMap<std::string, Value> copy(ht);
+    EXPECT_EQ(copy.size(), 666u);
+    for (int i = 0; i < 1000; i++)
+    {
+        auto it = copy.find(std::to_string(i));
+        ASSERT_EQ(it != copy.iend(), (i % 3) != 0);
+        if (it != copy.iend())
+        {
+            EXPECT_EQ(it.value()[15], uint64_t(i));
+        }
+    }
+
+    Excalibur::SplitHashMap<std::string, Value> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 666u);
+    EXPECT_TRUE(moved.has("1"));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.has("1"));
+
+    copy = moved;
+    EXPECT_EQ(copy.size(), 666u);
+    moved = Excalibur::SplitHashMap<std::string, Value>();
+    EXPECT_TRUE(moved.empty());
+    moved[std::string("a")][0] = 7;
+    EXPECT_EQ(moved[std::string("a")][0], 7u);
+
+    // values with non trivial destructors
+    Excalibur::SplitHashMap<int, std::unique_ptr<int>> owners;
+    for (int i = 0; i < 100; i++)
+    {
+        owners.emplace(i, std::make_unique<int>(i));
+    }
+    owners.erase(5);
+    owners.reserve(1024);
+    EXPECT_EQ(owners.capacity(), 1024u);
+    EXPECT_EQ(*owners.find(99).value(), 99);
+    EXPECT_FALSE(owners.has(5));
+}
+
+TEST(SplitHashMap, StatefulAllocator)
+{
+    using TMap = Excalibur::SplitHashMap<int, std::string, Excalibur::KeyInfo<int>, CountingAllocator>;
+    AllocStats stats;
+    {
+        TMap ht{CountingAllocator(stats)};
+        EXPECT_EQ(stats.numAllocs, 0);
+        for (int i = 0; i < 1000; i++)
+        {
+            ht.emplace(i, std::to_string(i));
+        }
+        EXPECT_GT(stats.numAllocs, 1);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        ht.rehash();
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 1);
+
+        // copies and moves take the allocator with them
+        TMap copy(ht);
+        EXPECT_EQ(copy.getAllocator().stats, &stats);
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+
+        TMap moved(std::move(copy));
+        EXPECT_EQ(stats.numAllocs, stats.numFrees + 2);
+        EXPECT_EQ(moved.find(999).value(), "999");
+
+        AllocStats otherStats;
+        TMap other{CountingAllocator(otherStats)};
+        other.emplace(1, "1");
+        other = moved;
+        EXPECT_EQ(otherStats.numAllocs, otherStats.numFrees);
+        EXPECT_EQ(otherStats.numBytesAlive, 0u);
+        EXPECT_EQ(other.getAllocator().stats, &stats);
+        EXPECT_EQ(other.size(), 1000u);
+    }
+    EXPECT_EQ(stats.numAllocs, stats.numFrees);
+    EXPECT_EQ(stats.numBytesAlive, 0u);
+}
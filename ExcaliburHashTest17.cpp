@@ -0,0 +1,106 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <string_view>
+
+// key type that counts conversions from std::string_view
+struct NameKey
+{
+    static inline int numConversions = 0;
+
+    NameKey() = default;
+    explicit NameKey(std::string_view name)
+        : str(name)
+    {
+        numConversions++;
+    }
+
+    std::string str;
+};
+
+struct NameKeyInfo
+{
+    using is_transparent = void;
+
+    static inline bool isValid(const NameKey& key) noexcept { return !key.str.empty() && key.str[0] != char(1); }
+    static inline NameKey getTombstone() noexcept
+    {
+        NameKey key;
+        key.str = std::string(1, char(1));
+        return key;
+    }
+    static inline NameKey getEmpty() noexcept { return NameKey(); }
+    static inline size_t hash(const NameKey& key) noexcept { return std::hash<std::string_view>{}(key.str); }
+    static inline size_t hash(std::string_view key) noexcept { return std::hash<std::string_view>{}(key); }
+    static inline bool isEqual(const NameKey& lhs, const NameKey& rhs) noexcept { return lhs.str == rhs.str; }
+    static inline bool isEqual(std::string_view lhs, const NameKey& rhs) noexcept { return lhs == rhs.str; }
+};
+
+TEST(TransparentLookup, StringKeys)
+{
+    Excalibur::HashMap<std::string, int> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+
+    const std::string buffer = "key=123;";
+    const std::string_view view = std::string_view(buffer).substr(4, 3);
+    auto it = ht.find(view);
+    ASSERT_NE(it, ht.iend());
+    EXPECT_EQ(it.value(), 123);
+    EXPECT_TRUE(ht.has(view));
+    EXPECT_TRUE(ht.has("999"));
+    EXPECT_FALSE(ht.has("1000"));
+    EXPECT_FALSE(ht.has(std::string_view("1000")));
+
+    const auto& cht = ht;
+    EXPECT_EQ(cht.find("5").value(), 5);
+
+    // insert by std::string_view / const char*
+    ht[std::string_view("new")] = 7;
+    EXPECT_EQ(ht[std::string("new")], 7);
+    auto emplaceIt = ht.emplace("other", 8);
+    EXPECT_TRUE(emplaceIt.second);
+    EXPECT_EQ(emplaceIt.first.key(), "other");
+    EXPECT_FALSE(ht.emplace(std::string_view("other"), 9).second);
+    EXPECT_EQ(ht["other"], 8);
+
+    EXPECT_TRUE(ht.erase(view));
+    EXPECT_FALSE(ht.erase("123"));
+    EXPECT_FALSE(ht.has(std::string("123")));
+    EXPECT_EQ(ht.size(), 1001u);
+
+    Excalibur::HashSet<std::string, 1, Excalibur::KeyInfo<std::string>, Excalibur::RobinHoodProbing> hs;
+    for (int i = 0; i < 100; i++)
+    {
+        hs.emplace(std::string_view(std::to_string(i)));
+    }
+    EXPECT_TRUE(hs.has("42"));
+    EXPECT_TRUE(hs.erase(std::string_view("42")));
+    EXPECT_FALSE(hs.has("42"));
+    EXPECT_TRUE(hs.has("43"));
+}
+
+TEST(TransparentLookup, KeyIsConstructedOnlyOnInsert)
+{
+    Excalibur::HashMap<NameKey, int, 1, NameKeyInfo> ht;
+    NameKey::numConversions = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        ht.emplace(std::string_view(std::to_string(i)), i);
+    }
+    EXPECT_EQ(NameKey::numConversions, 100);
+
+    NameKey::numConversions = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        const std::string name = std::to_string(i);
+        EXPECT_EQ(ht.has(std::string_view(name)), i < 100);
+        ht.emplace(std::string_view(name), -1);
+    }
+    // only the 100 new keys were converted
+    EXPECT_EQ(NameKey::numConversions, 100);
+    EXPECT_EQ(ht.find(std::string_view("5")).value(), 5);
+    EXPECT_EQ(ht.find(std::string_view("150")).value(), -1);
+}
@@ -0,0 +1,97 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <string>
+
+struct SentinelKey
+{
+    int v = 0;
+};
+
+// counts sentinel constructions
+struct SentinelKeyInfo
+{
+    static inline int numSentinels = 0;
+
+    static inline bool isValid(const SentinelKey& key) noexcept { return key.v >= 0; }
+    static inline SentinelKey getTombstone() noexcept
+    {
+        numSentinels++;
+        return SentinelKey{-2};
+    }
+    static inline SentinelKey getEmpty() noexcept
+    {
+        numSentinels++;
+        return SentinelKey{-1};
+    }
+    static inline bool isTombstone(const SentinelKey& key) noexcept { return key.v == -2; }
+    static inline bool isEmpty(const SentinelKey& key) noexcept { return key.v == -1; }
+    static inline size_t hash(const SentinelKey& key) noexcept { return Excalibur::wyhash::hash(uint32_t(key.v)); }
+    static inline bool isEqual(const SentinelKey& lhs, const SentinelKey& rhs) noexcept { return lhs.v == rhs.v; }
+};
+
+static_assert(Excalibur::detail::has_is_empty<Excalibur::KeyInfo<std::string>, std::string>::value);
+static_assert(Excalibur::detail::has_is_tombstone<Excalibur::KeyInfo<uint64_t>, uint64_t>::value);
+
+TEST(KeyInfoPredicates, ProbingDoesNotConstructSentinels)
+{
+    Excalibur::HashMap<SentinelKey, int, 1, SentinelKeyInfo> ht;
+    ht.reserve(4096);
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(SentinelKey{i}, i);
+    }
+    for (int i = 0; i < 1000; i += 3)
+    {
+        ht.erase(SentinelKey{i});
+    }
+
+    SentinelKeyInfo::numSentinels = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        auto it = ht.find(SentinelKey{i});
+        ASSERT_EQ(it != ht.iend(), i < 1000 && (i % 3) != 0);
+        if (it != ht.iend())
+        {
+            EXPECT_EQ(it.value(), i);
+        }
+    }
+    for (int i = 1000; i < 1500; i++)
+    {
+        ht.emplace(SentinelKey{i}, i);
+    }
+#if defined(NDEBUG)
+    // asserts compare keys against sentinels in debug builds
+    EXPECT_EQ(SentinelKeyInfo::numSentinels, 0);
+#endif
+    EXPECT_EQ(ht.size(), 1166u);
+}
+
+TEST(KeyInfoPredicates, BuiltinKeyInfos)
+{
+    using StringKeyInfo = Excalibur::KeyInfo<std::string>;
+    EXPECT_TRUE(StringKeyInfo::isEmpty(StringKeyInfo::getEmpty()));
+    EXPECT_TRUE(StringKeyInfo::isTombstone(StringKeyInfo::getTombstone()));
+    EXPECT_FALSE(StringKeyInfo::isEmpty(StringKeyInfo::getTombstone()));
+    EXPECT_FALSE(StringKeyInfo::isTombstone(std::string("\1a")));
+    EXPECT_FALSE(StringKeyInfo::isTombstone(std::string("a")));
+
+    using IntKeyInfo = Excalibur::KeyInfo<int32_t>;
+    EXPECT_TRUE(IntKeyInfo::isEmpty(IntKeyInfo::getEmpty()));
+    EXPECT_TRUE(IntKeyInfo::isTombstone(IntKeyInfo::getTombstone()));
+    EXPECT_FALSE(IntKeyInfo::isEmpty(0));
+    EXPECT_FALSE(IntKeyInfo::isTombstone(IntKeyInfo::getEmpty()));
+
+    Excalibur::HashMap<std::string, int> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        ht.erase(std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(ht.has(std::to_string(i)), (i & 1) != 0);
+    }
+}
@@ -0,0 +1,92 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <string>
+
+// std::string KeyInfo that counts hash() and isEqual() calls
+struct CountingStringKeyInfo : public Excalibur::KeyInfo<std::string>
+{
+    static inline int numHashes = 0;
+    static inline int numCompares = 0;
+
+    static inline size_t hash(const std::string& key) noexcept
+    {
+        numHashes++;
+        return Excalibur::KeyInfo<std::string>::hash(key);
+    }
+    static inline bool isEqual(const std::string& lhs, const std::string& rhs) noexcept
+    {
+        numCompares++;
+        return lhs == rhs;
+    }
+};
+
+using CachedStringKeyInfo = Excalibur::CachedHashKeyInfo<CountingStringKeyInfo>;
+
+template <typename TProbing> void testCachedHash()
+{
+    Excalibur::HashMap<std::string, int, 1, CachedStringKeyInfo, TProbing> ht;
+    CountingStringKeyInfo::numHashes = 0;
+    const int kNumElements = 10000;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    // one hash per insert, growth doesn't rehash anything
+    EXPECT_EQ(CountingStringKeyInfo::numHashes, kNumElements);
+    ht.rehash();
+    ht.reserve(ht.capacity() * 2);
+    EXPECT_EQ(CountingStringKeyInfo::numHashes, kNumElements);
+
+    for (int i = 0; i < kNumElements; i += 3)
+    {
+        EXPECT_TRUE(ht.erase(std::to_string(i)));
+    }
+    for (int i = 0; i < kNumElements * 2; i++)
+    {
+        auto it = ht.find(std::to_string(i));
+        ASSERT_EQ(it != ht.iend(), i < kNumElements && (i % 3) != 0);
+        if (it != ht.iend())
+        {
+            EXPECT_EQ(it.value(), i);
+        }
+    }
+
+    // moved inline storage keeps the hashes
+    Excalibur::HashMap<std::string, int, 4, CachedStringKeyInfo, TProbing> small;
+    small.emplace(std::string("a"), 1);
+    small.emplace(std::string("b"), 2);
+    Excalibur::HashMap<std::string, int, 4, CachedStringKeyInfo, TProbing> moved(std::move(small));
+    EXPECT_EQ(moved[std::string("a")], 1);
+    for (int i = 0; i < 100; i++)
+    {
+        moved.emplace(std::to_string(i), i);
+    }
+    EXPECT_EQ(moved[std::string("b")], 2);
+    EXPECT_EQ(moved[std::string("99")], 99);
+    EXPECT_EQ(moved.size(), 102u);
+}
+
+TEST(CachedHash, LinearProbing) { testCachedHash<Excalibur::LinearProbing>(); }
+
+TEST(CachedHash, RobinHoodProbing) { testCachedHash<Excalibur::RobinHoodProbing>(); }
+
+TEST(CachedHash, MismatchesDontCallIsEqual)
+{
+    Excalibur::HashSet<std::string, 1, CachedStringKeyInfo> hs;
+    for (int i = 0; i < 1000; i++)
+    {
+        hs.emplace(std::to_string(i));
+    }
+
+    CountingStringKeyInfo::numCompares = 0;
+    int numFound = 0;
+    for (int i = 1000; i < 2000; i++)
+    {
+        numFound += hs.has(std::to_string(i)) ? 1 : 0;
+    }
+    EXPECT_EQ(numFound, 0);
+#if defined(NDEBUG)
+    // only (rare) 32-bit hash collisions reach isEqual(), asserts compare keys in debug builds
+    EXPECT_LT(CountingStringKeyInfo::numCompares, 10);
+#endif
+}
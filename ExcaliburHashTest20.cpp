@@ -0,0 +1,122 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <numeric>
+
+// degraded hash: every key lands in the last bucket of a 256 buckets table
+struct ConstantHashKeyInfo : public Excalibur::KeyInfo<int>
+{
+    static inline size_t hash(const int& /*key*/) noexcept { return 255; }
+};
+
+TEST(ProbeHistogram, DegradedHash)
+{
+    Excalibur::HashMap<int, int, 1, ConstantHashKeyInfo> ht;
+    ht.reserve(256);
+    for (int i = 0; i < 100; i++)
+    {
+        ht.emplace(i, i);
+    }
+
+    Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numBuckets, 256u);
+    EXPECT_EQ(histogram.numElements, 100u);
+    EXPECT_EQ(histogram.numTombstones, 0u);
+    EXPECT_EQ(histogram.maxDisplacement, 99u);
+    ASSERT_EQ(histogram.displacement.size(), 100u);
+    for (uint32_t count : histogram.displacement)
+    {
+        EXPECT_EQ(count, 1u);
+    }
+    // a single cluster that wraps around the end of the storage
+    EXPECT_EQ(histogram.maxClusterLength, 100u);
+    ASSERT_EQ(histogram.clusterLength.size(), 101u);
+    EXPECT_EQ(std::accumulate(histogram.clusterLength.begin(), histogram.clusterLength.end(), 0u), 1u);
+    EXPECT_EQ(histogram.clusterLength[100], 1u);
+
+    // tombstones don't have a displacement, but they still extend the cluster
+    for (int i = 0; i < 50; i++)
+    {
+        EXPECT_TRUE(ht.erase(i));
+    }
+    histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numTombstones, 50u);
+    EXPECT_EQ(std::accumulate(histogram.displacement.begin(), histogram.displacement.end(), 0u), 50u);
+    EXPECT_EQ(histogram.displacement[0], 0u);
+    EXPECT_EQ(histogram.maxDisplacement, 99u);
+    EXPECT_EQ(histogram.maxClusterLength, 100u);
+}
+
+TEST(ProbeHistogram, UniformHash)
+{
+    Excalibur::HashSet<int, 1, Excalibur::KeyInfo<int>, Excalibur::RobinHoodProbing> ht;
+    Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numElements, 0u);
+    EXPECT_TRUE(histogram.displacement.empty());
+    EXPECT_TRUE(histogram.clusterLength.empty());
+
+    for (int i = 0; i < 10000; i++)
+    {
+        ht.emplace(i * 7919);
+    }
+    histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numBuckets, ht.capacity());
+    EXPECT_EQ(std::accumulate(histogram.displacement.begin(), histogram.displacement.end(), 0u), ht.size());
+    EXPECT_EQ(histogram.displacement.size(), size_t(histogram.maxDisplacement) + 1);
+
+    uint32_t numOccupied = 0;
+    for (size_t length = 0; length < histogram.clusterLength.size(); length++)
+    {
+        numOccupied += uint32_t(length) * histogram.clusterLength[length];
+    }
+    EXPECT_EQ(numOccupied, ht.size());
+    EXPECT_EQ(histogram.clusterLength.size(), size_t(histogram.maxClusterLength) + 1);
+}
+
+#if defined(EXLBR_ENABLE_STATS)
+TEST(HashTableStats, Counters)
+{
+    Excalibur::HashMap<int, int> ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(i, i);
+    }
+    // 1 (inline) -> 64 -> 128 -> ... -> 2048
+    EXPECT_EQ(ht.getStats().numResizes, 6u);
+    EXPECT_GT(ht.getStats().numBytesMoved, 0u);
+
+    ht.resetStats();
+    EXPECT_EQ(ht.getStats().numFinds, 0u);
+    const auto& cht = ht;
+    for (int i = 0; i < 2000; i++)
+    {
+        EXPECT_EQ(cht.has(i), i < 1000);
+    }
+    const Excalibur::HashTableStats& stats = ht.getStats();
+    EXPECT_EQ(stats.numFinds, 2000u);
+    EXPECT_EQ(stats.numHits, 1000u);
+    EXPECT_EQ(stats.numMisses, 1000u);
+    EXPECT_GE(stats.totalProbeLength, 2000u);
+    EXPECT_GE(stats.maxProbeLength, 1u);
+    EXPECT_LE(stats.maxProbeLength, stats.totalProbeLength);
+    EXPECT_EQ(stats.numResizes, 0u);
+
+    ht.resetStats();
+    ht.rehash();
+    EXPECT_EQ(ht.getStats().numResizes, 1u);
+    EXPECT_EQ(ht.getStats().numBytesMoved % ht.size(), 0u);
+    EXPECT_GE(ht.getStats().numBytesMoved / ht.size(), sizeof(int) * 2);
+
+    // degraded hash function shows up as long probes
+    Excalibur::HashMap<int, int, 1, ConstantHashKeyInfo> bad;
+    bad.reserve(256);
+    for (int i = 0; i < 100; i++)
+    {
+        bad.emplace(i, i);
+    }
+    bad.resetStats();
+    EXPECT_FALSE(bad.has(1000));
+    EXPECT_EQ(bad.getStats().maxProbeLength, 101u);
+    EXPECT_TRUE(bad.has(0));
+    EXPECT_EQ(bad.getStats().totalProbeLength, 102u);
+}
+#endif
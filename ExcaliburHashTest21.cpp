@@ -0,0 +1,162 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+
+TEST(ShrinkPolicy, ShrinkToFit)
+{
+    Excalibur::HashMap<int, std::unique_ptr<int>> ht;
+    const uint32_t inlineCapacity = ht.capacity();
+    for (int i = 0; i < 100000; i++)
+    {
+        ht.emplace(i, std::make_unique<int>(i));
+    }
+    const uint32_t peakCapacity = ht.capacity();
+
+    // default policy never shrinks on its own
+    for (int i = 100; i < 100000; i++)
+    {
+        EXPECT_TRUE(ht.erase(i));
+    }
+    EXPECT_EQ(ht.capacity(), peakCapacity);
+
+    ht.shrink_to_fit();
+    EXPECT_EQ(ht.capacity(), 256u);
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_EQ(ht.size(), 100u);
+    for (int i = 0; i < 200; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_EQ(it != ht.iend(), i < 100);
+        if (i < 100)
+        {
+            EXPECT_EQ(*it.value(), i);
+        }
+    }
+
+    // already tight
+    ht.shrink_to_fit();
+    EXPECT_EQ(ht.capacity(), 256u);
+
+    ht.clear();
+    EXPECT_EQ(ht.capacity(), 256u);
+    ht.shrink_to_fit();
+    EXPECT_EQ(ht.capacity(), inlineCapacity);
+    EXPECT_TRUE(ht.empty());
+    ht.emplace(1, std::make_unique<int>(1));
+    EXPECT_EQ(*ht.find(1).value(), 1);
+}
+
+TEST(ShrinkPolicy, ShrinkOnClear)
+{
+    Excalibur::HashMap<std::string, int, 1, Excalibur::KeyInfo<std::string>, Excalibur::LinearProbing, Excalibur::DefaultAllocator,
+                       Excalibur::ShrinkIfSparse<8, false>>
+        ht;
+    for (int i = 0; i < 10000; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    const uint32_t peakCapacity = ht.capacity();
+
+    // a full table keeps its storage (refill won't have to grow again)
+    ht.clear();
+    EXPECT_EQ(ht.capacity(), peakCapacity);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    for (int i = 0; i < 990; i++)
+    {
+        // k_ShrinkOnErase is off
+        EXPECT_TRUE(ht.erase(std::to_string(i)));
+    }
+    EXPECT_EQ(ht.capacity(), peakCapacity);
+
+    // storage is re-allocated to fit the 10 items the table held
+    ht.clear();
+    EXPECT_EQ(ht.capacity(), 16u);
+    EXPECT_TRUE(ht.empty());
+    EXPECT_FALSE(ht.has("995"));
+    for (int i = 0; i < 12; i++)
+    {
+        ht.emplace(std::to_string(i), i);
+    }
+    EXPECT_EQ(ht.capacity(), 16u);
+}
+
+TEST(ShrinkPolicy, ShrinkOnClearAfterEraseAll)
+{
+    Excalibur::HashSet<int, 1, Excalibur::KeyInfo<int>, Excalibur::LinearProbing, Excalibur::DefaultAllocator,
+                       Excalibur::ShrinkIfSparse<8, false>>
+        ht;
+    const uint32_t inlineCapacity = ht.capacity();
+    for (int i = 0; i < 1000000; i++)
+    {
+        ht.emplace(i);
+    }
+    for (int i = 0; i < 1000000; i++)
+    {
+        EXPECT_TRUE(ht.erase(i));
+    }
+    EXPECT_TRUE(ht.empty());
+    EXPECT_GT(ht.capacity(), 1000000u);
+
+    // already empty, but the storage is still released
+    ht.clear();
+    EXPECT_EQ(ht.capacity(), inlineCapacity);
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_FALSE(ht.has(5));
+    ht.emplace(5);
+    EXPECT_TRUE(ht.has(5));
+}
+
+TEST(ShrinkPolicy, ShrinkOnErase)
+{
+    Excalibur::HashSet<int, 1, Excalibur::KeyInfo<int>, Excalibur::RobinHoodProbing, Excalibur::DefaultAllocator, Excalibur::ShrinkIfSparse<>>
+        ht;
+    for (int i = 0; i < 4096; i++)
+    {
+        ht.emplace(i);
+    }
+    EXPECT_EQ(ht.capacity(), 8192u);
+
+    uint32_t numShrinks = 0;
+    uint32_t prevCapacity = ht.capacity();
+    for (int i = 0; i < 4096; i++)
+    {
+        EXPECT_TRUE(ht.erase(i));
+        // never below 1/8 load (unless the table is at its minimal size)
+        EXPECT_TRUE(ht.capacity() == 16u || ht.size() >= ht.capacity() / 8);
+        // ...and never above 75% right after a shrink
+        EXPECT_LT(ht.size(), ht.capacity() * 3 / 4 + 1);
+        if (ht.capacity() != prevCapacity)
+        {
+            EXPECT_LT(ht.capacity(), prevCapacity);
+            numShrinks++;
+            prevCapacity = ht.capacity();
+        }
+        EXPECT_FALSE(ht.has(i));
+        EXPECT_EQ(ht.has(4095), i != 4095);
+    }
+    EXPECT_GT(numShrinks, 0u);
+    EXPECT_EQ(ht.capacity(), 16u);
+    EXPECT_FALSE(ht.erase(1));
+
+    // hysteresis: insert/erase around the shrink threshold doesn't reallocate every time
+    for (int i = 0; i < 4096; i++)
+    {
+        ht.emplace(i);
+    }
+    for (int i = 0; i < 3584; i++)
+    {
+        ht.erase(i);
+    }
+    const uint32_t capacity = ht.capacity();
+    for (int i = 0; i < 100; i++)
+    {
+        ht.emplace(-1);
+        ht.erase(-1);
+        EXPECT_EQ(ht.capacity(), capacity);
+    }
+}
@@ -0,0 +1,141 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+// home bucket = key / 4 (clusters of colliding keys)
+struct ClusteredKeyInfo : public Excalibur::KeyInfo<int>
+{
+    static inline size_t hash(const int& key) noexcept { return size_t(key / 4); }
+};
+
+struct CountingAllocator
+{
+    static inline int numAllocations = 0;
+    [[nodiscard]] static inline void* allocate(size_t numBytes, size_t alignment) noexcept
+    {
+        numAllocations++;
+        return Excalibur::DefaultAllocator::allocate(numBytes, alignment);
+    }
+    static inline void deallocate(void* ptr, size_t numBytes, size_t alignment) noexcept
+    {
+        Excalibur::DefaultAllocator::deallocate(ptr, numBytes, alignment);
+    }
+};
+} // namespace
+
+TEST(Tombstones, EraseBeforeEmptySlotLeavesNoTombstone)
+{
+    Excalibur::HashSet<int, 1, ClusteredKeyInfo> ht;
+    ht.reserve(64);
+    // buckets 0..9
+    for (int i = 0; i < 10; i++)
+    {
+        ht.emplace(i * 4);
+    }
+
+    // the next slot is occupied
+    EXPECT_TRUE(ht.erase(5 * 4));
+    EXPECT_EQ(ht.getNumTombstones(), 1u);
+
+    // the next slot is empty
+    EXPECT_TRUE(ht.erase(9 * 4));
+    EXPECT_EQ(ht.getNumTombstones(), 1u);
+
+    // the tombstone at bucket 7 is cleaned up once bucket 8 becomes empty (bucket 9 is already empty)
+    EXPECT_TRUE(ht.erase(7 * 4));
+    EXPECT_EQ(ht.getNumTombstones(), 2u);
+    EXPECT_TRUE(ht.erase(8 * 4));
+    EXPECT_EQ(ht.getNumTombstones(), 1u);
+
+    // the whole cluster 6..4 goes away
+    EXPECT_TRUE(ht.erase(4 * 4));
+    EXPECT_TRUE(ht.erase(6 * 4));
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(ht.has(i * 4), i < 4);
+    }
+
+    // collisions: the last item of a cluster doesn't need a tombstone either
+    ht.clear();
+    for (int i = 0; i < 8; i++)
+    {
+        ht.emplace(i);
+    }
+    EXPECT_TRUE(ht.erase(7));
+    EXPECT_TRUE(ht.erase(3));
+    EXPECT_EQ(ht.getNumTombstones(), 1u);
+    EXPECT_TRUE(ht.has(4));
+    EXPECT_TRUE(ht.has(6));
+}
+
+TEST(Tombstones, PurgeInPlace)
+{
+    Excalibur::HashMap<int, std::string, 1, ClusteredKeyInfo, Excalibur::LinearProbing, CountingAllocator> ht;
+    ht.reserve(4096);
+    std::unordered_map<int, std::string> reference;
+
+    std::mt19937 rnd(42);
+    for (int round = 0; round < 10; round++)
+    {
+        // offset makes clusters wrap around the end of the storage
+        const int offset = (round * 3079) % 16384;
+        for (int i = 0; i < 600; i++)
+        {
+            const int key = int(rnd() % 4000) + offset;
+            ht[key] = std::to_string(key);
+            reference[key] = std::to_string(key);
+        }
+        for (int i = 0; i < 400; i++)
+        {
+            const int key = int(rnd() % 4000) + offset;
+            EXPECT_EQ(ht.erase(key), reference.erase(key) != 0);
+        }
+        ASSERT_EQ(ht.size(), uint32_t(reference.size()));
+
+        const uint32_t capacity = ht.capacity();
+        const int numAllocations = CountingAllocator::numAllocations;
+        ht.purgeTombstones();
+        EXPECT_EQ(CountingAllocator::numAllocations, numAllocations);
+        EXPECT_EQ(ht.capacity(), capacity);
+        EXPECT_EQ(ht.getNumTombstones(), 0u);
+        ASSERT_EQ(ht.size(), uint32_t(reference.size()));
+
+        Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+        uint32_t numOccupied = 0;
+        for (size_t length = 0; length < histogram.clusterLength.size(); length++)
+        {
+            numOccupied += uint32_t(length) * histogram.clusterLength[length];
+        }
+        EXPECT_EQ(numOccupied, ht.size());
+
+        for (const auto& kv : reference)
+        {
+            auto it = ht.find(kv.first);
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value(), kv.second);
+        }
+        for (auto it = ht.ibegin(); it != ht.iend(); ++it)
+        {
+            EXPECT_EQ(reference.count(it.key()), 1u);
+        }
+    }
+}
+
+TEST(Tombstones, PurgeFullInlineStorage)
+{
+    Excalibur::HashSet<int, 2> ht;
+    ht.emplace(1);
+    ht.emplace(2);
+    ht.erase(ht.find(1));
+    EXPECT_EQ(ht.getNumTombstones(), 1u);
+    ht.purgeTombstones();
+    EXPECT_EQ(ht.getNumTombstones(), 0u);
+    EXPECT_TRUE(ht.has(2));
+    EXPECT_FALSE(ht.has(1));
+}
@@ -0,0 +1,230 @@
+#include "ExcaliburSnapshot.h"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Record
+{
+    uint64_t id;
+    uint32_t flags;
+    float score;
+};
+
+// over-aligned value, the items are re-created in an aligned buffer when saving
+struct alignas(64) AlignedRecord
+{
+    uint64_t id;
+};
+
+struct OtherHashKeyInfo : public Excalibur::KeyInfo<uint64_t>
+{
+    static inline size_t hash(const uint64_t& key) noexcept { return size_t(key * 0x9E3779B97F4A7C15ull); }
+};
+
+std::string getSnapshotPath(const char* name) { return testing::TempDir() + name; }
+
+std::vector<char> readFile(const std::string& path)
+{
+    std::vector<char> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return bytes;
+    }
+    char buffer[4096];
+    size_t numBytes = 0;
+    while ((numBytes = fread(buffer, 1, sizeof(buffer), file)) != 0)
+    {
+        bytes.insert(bytes.end(), buffer, buffer + numBytes);
+    }
+    fclose(file);
+    return bytes;
+}
+
+void writeFile(const std::string& path, const std::vector<char>& bytes)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fwrite(bytes.data(), 1, bytes.size(), file), bytes.size());
+    fclose(file);
+}
+} // namespace
+
+TEST(Snapshot, SaveAndMap)
+{
+    using Map = Excalibur::HashMap<uint64_t, Record>;
+    Map ht;
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        ht.emplace(i * 3, Record{i, uint32_t(i & 0xff), float(i) * 0.5f});
+    }
+    // tombstones are stored as is
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        ht.erase(i * 30);
+    }
+
+    const std::string path = getSnapshotPath("exlbr_snapshot_map.bin");
+    ASSERT_EQ(Excalibur::saveSnapshot(ht, path.c_str()), Excalibur::SnapshotStatus::Ok);
+
+    Excalibur::HashTableView<Map> view;
+    EXPECT_FALSE(view.isOpen());
+    EXPECT_FALSE(view.has(3));
+    ASSERT_EQ(view.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    EXPECT_TRUE(view.isOpen());
+    EXPECT_EQ(view.size(), ht.size());
+    EXPECT_EQ(view.capacity(), ht.capacity());
+
+    for (uint64_t i = 0; i < 300000; i++)
+    {
+        auto it = ht.find(i);
+        const Record* record = view.find(i);
+        ASSERT_EQ(record != nullptr, it != ht.iend());
+        if (record)
+        {
+            EXPECT_EQ(record->id, it.value().id);
+            EXPECT_EQ(record->flags, it.value().flags);
+            EXPECT_EQ(record->score, it.value().score);
+        }
+    }
+
+    // the view owns the mapping
+    Excalibur::HashTableView<Map> moved(std::move(view));
+    EXPECT_FALSE(view.isOpen());
+    EXPECT_EQ(moved.find(9)->id, 3u);
+    view = std::move(moved);
+    EXPECT_EQ(view.find(9)->id, 3u);
+    view.close();
+    EXPECT_FALSE(view.has(9));
+
+    // same table, same bytes
+    const std::string path2 = getSnapshotPath("exlbr_snapshot_map2.bin");
+    ASSERT_EQ(Excalibur::saveSnapshot(ht, path2.c_str()), Excalibur::SnapshotStatus::Ok);
+    EXPECT_EQ(readFile(path), readFile(path2));
+    remove(path.c_str());
+    remove(path2.c_str());
+}
+
+TEST(Snapshot, SetsAndPolicies)
+{
+    using Set = Excalibur::HashSet<uint32_t, 8, Excalibur::KeyInfo<uint32_t>, Excalibur::RobinHoodProbing>;
+    using CachedMap = Excalibur::HashMap<uint64_t, uint16_t, 1, Excalibur::CachedHashKeyInfo<Excalibur::KeyInfo<uint64_t>>>;
+    const std::string path = getSnapshotPath("exlbr_snapshot_set.bin");
+
+    // inline storage
+    Set small;
+    small.emplace(7u);
+    ASSERT_EQ(Excalibur::saveSnapshot(small, path.c_str()), Excalibur::SnapshotStatus::Ok);
+    Excalibur::HashTableView<Set> smallView;
+    ASSERT_EQ(smallView.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    EXPECT_EQ(smallView.capacity(), 8u);
+    EXPECT_TRUE(smallView.has(7));
+    EXPECT_FALSE(smallView.has(8));
+
+    Set set;
+    for (uint32_t i = 0; i < 50000; i++)
+    {
+        set.emplace(i * 7);
+    }
+    ASSERT_EQ(Excalibur::saveSnapshot(set, path.c_str()), Excalibur::SnapshotStatus::Ok);
+    Excalibur::HashTableView<Set> setView;
+    ASSERT_EQ(setView.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    for (uint32_t i = 0; i < 350000; i++)
+    {
+        ASSERT_EQ(setView.has(i), (i % 7) == 0);
+    }
+
+    CachedMap cached;
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        cached.emplace(i << 20, uint16_t(i));
+    }
+    ASSERT_EQ(Excalibur::saveSnapshot(cached, path.c_str()), Excalibur::SnapshotStatus::Ok);
+    Excalibur::HashTableView<CachedMap> cachedView;
+    ASSERT_EQ(cachedView.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        ASSERT_NE(cachedView.find(i << 20), nullptr);
+        EXPECT_EQ(*cachedView.find(i << 20), uint16_t(i));
+        EXPECT_EQ(cachedView.find((i << 20) + 1), nullptr);
+    }
+    cachedView.close();
+
+    using AlignedMap = Excalibur::HashMap<uint64_t, AlignedRecord>;
+    AlignedMap aligned;
+    for (uint64_t i = 0; i < 5000; i++)
+    {
+        aligned.emplace(i, AlignedRecord{i * 3});
+    }
+    ASSERT_EQ(Excalibur::saveSnapshot(aligned, path.c_str()), Excalibur::SnapshotStatus::Ok);
+    Excalibur::HashTableView<AlignedMap> alignedView;
+    ASSERT_EQ(alignedView.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    for (uint64_t i = 0; i < 5000; i++)
+    {
+        ASSERT_NE(alignedView.find(i), nullptr);
+        EXPECT_EQ(alignedView.find(i)->id, i * 3);
+    }
+    alignedView.close();
+    remove(path.c_str());
+}
+
+TEST(Snapshot, Validation)
+{
+    using Map = Excalibur::HashMap<uint64_t, Record>;
+    Map ht;
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        ht.emplace(i, Record{i, 0, 0.0f});
+    }
+    const std::string path = getSnapshotPath("exlbr_snapshot_validation.bin");
+    ASSERT_EQ(Excalibur::saveSnapshot(ht, path.c_str()), Excalibur::SnapshotStatus::Ok);
+
+    Excalibur::HashTableView<Map> view;
+    EXPECT_EQ(view.open(getSnapshotPath("exlbr_snapshot_does_not_exist.bin").c_str()), Excalibur::SnapshotStatus::IoError);
+    EXPECT_EQ(Excalibur::saveSnapshot(ht, getSnapshotPath("no_such_dir/snapshot.bin").c_str()), Excalibur::SnapshotStatus::IoError);
+
+    // different value type
+    Excalibur::HashTableView<Excalibur::HashMap<uint64_t, uint64_t>> otherLayout;
+    EXPECT_EQ(otherLayout.open(path.c_str()), Excalibur::SnapshotStatus::LayoutMismatch);
+    // different probing
+    Excalibur::HashTableView<Excalibur::HashMap<uint64_t, Record, 1, Excalibur::KeyInfo<uint64_t>, Excalibur::RobinHoodProbing>> otherProbing;
+    EXPECT_EQ(otherProbing.open(path.c_str()), Excalibur::SnapshotStatus::LayoutMismatch);
+    // different hash function
+    Excalibur::HashTableView<Excalibur::HashMap<uint64_t, Record, 1, OtherHashKeyInfo>> otherHash;
+    EXPECT_EQ(otherHash.open(path.c_str()), Excalibur::SnapshotStatus::HashMismatch);
+    EXPECT_FALSE(otherHash.isOpen());
+
+    const std::vector<char> bytes = readFile(path);
+    const std::string brokenPath = getSnapshotPath("exlbr_snapshot_broken.bin");
+
+    // truncated
+    writeFile(brokenPath, std::vector<char>(bytes.begin(), bytes.end() - 64));
+    EXPECT_EQ(view.open(brokenPath.c_str()), Excalibur::SnapshotStatus::BadFormat);
+    writeFile(brokenPath, std::vector<char>(bytes.begin(), bytes.begin() + 16));
+    EXPECT_EQ(view.open(brokenPath.c_str()), Excalibur::SnapshotStatus::BadFormat);
+
+    // not a snapshot
+    std::vector<char> broken = bytes;
+    broken[0] = 'x';
+    writeFile(brokenPath, broken);
+    EXPECT_EQ(view.open(brokenPath.c_str()), Excalibur::SnapshotStatus::BadFormat);
+
+    // future version
+    broken = bytes;
+    broken[offsetof(Excalibur::SnapshotHeader, version)]++;
+    writeFile(brokenPath, broken);
+    EXPECT_EQ(view.open(brokenPath.c_str()), Excalibur::SnapshotStatus::VersionMismatch);
+    EXPECT_FALSE(view.isOpen());
+
+    EXPECT_EQ(view.open(path.c_str()), Excalibur::SnapshotStatus::Ok);
+    EXPECT_EQ(view.find(999)->id, 999u);
+    // a failed open closes the previous snapshot
+    EXPECT_EQ(view.open(brokenPath.c_str()), Excalibur::SnapshotStatus::VersionMismatch);
+    EXPECT_FALSE(view.isOpen());
+
+    remove(path.c_str());
+    remove(brokenPath.c_str());
+}
@@ -0,0 +1,135 @@
+#include "ExcaliburFrozenHash.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace
+{
+// every pair of keys shares the same hash value
+struct PairCollisionKeyInfo : public Excalibur::KeyInfo<uint32_t>
+{
+    static inline size_t hash(const uint32_t& key) noexcept { return size_t(key / 2); }
+};
+} // namespace
+
+TEST(FrozenHashMap, BuildFromTable)
+{
+    Excalibur::HashMap<uint64_t, uint64_t> ht;
+    const uint64_t kNumElements = 100000;
+    for (uint64_t i = 0; i < kNumElements; i++)
+    {
+        ht.emplace(i * 13, i);
+    }
+
+    Excalibur::FrozenHashMap<uint64_t, uint64_t> frozen(ht);
+    EXPECT_EQ(ht.size(), uint32_t(kNumElements));
+    EXPECT_EQ(frozen.size(), uint32_t(kNumElements));
+    EXPECT_EQ(frozen.getNumOverflowItems(), 0u);
+    for (uint64_t i = 0; i < kNumElements * 13; i++)
+    {
+        const uint64_t* value = frozen.find(i);
+        ASSERT_EQ(value != nullptr, (i % 13) == 0);
+        if (value)
+        {
+            EXPECT_EQ(*value, i / 13);
+        }
+        EXPECT_EQ(frozen.has(i), value != nullptr);
+    }
+
+    // no empty slots
+    EXPECT_LT(frozen.getMemoryUsage(), size_t(kNumElements) * sizeof(uint64_t) * 2 * 11 / 10);
+    EXPECT_LT(frozen.getMemoryUsage(), size_t(ht.capacity()) * sizeof(uint64_t) * 2);
+
+    uint64_t sum = 0;
+    uint32_t count = 0;
+    frozen.forEach([&sum, &count](const uint64_t& key, const uint64_t& value) {
+        EXPECT_EQ(key, value * 13);
+        sum += value;
+        count++;
+    });
+    EXPECT_EQ(count, uint32_t(kNumElements));
+    EXPECT_EQ(sum, kNumElements * (kNumElements - 1) / 2);
+}
+
+TEST(FrozenHashMap, MoveFromTable)
+{
+    Excalibur::HashMap<std::string, std::unique_ptr<int>> ht;
+    for (int i = 0; i < 5000; i++)
+    {
+        ht.emplace("route/" + std::to_string(i), std::make_unique<int>(i));
+    }
+
+    Excalibur::FrozenHashMap<std::string, std::unique_ptr<int>> frozen(std::move(ht));
+    EXPECT_TRUE(ht.empty());
+    EXPECT_EQ(frozen.size(), 5000u);
+    for (int i = 0; i < 5000; i++)
+    {
+        const std::string key = "route/" + std::to_string(i);
+        const std::unique_ptr<int>* value = frozen.find(key);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(**value, i);
+        // transparent lookup
+        EXPECT_TRUE(frozen.has(std::string_view(key)));
+    }
+    EXPECT_EQ(frozen.find(std::string_view("route/5000")), nullptr);
+    EXPECT_FALSE(frozen.has("route/"));
+}
+
+TEST(FrozenHashMap, SmallAndEmpty)
+{
+    Excalibur::FrozenHashMap<int, int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.find(1), nullptr);
+    EXPECT_FALSE(empty.has(1));
+
+    Excalibur::HashMap<int, int> ht;
+    Excalibur::FrozenHashMap<int, int> frozenEmpty(ht);
+    EXPECT_TRUE(frozenEmpty.empty());
+    EXPECT_FALSE(frozenEmpty.has(0));
+
+    for (int numKeys = 1; numKeys < 70; numKeys++)
+    {
+        ht.clear();
+        for (int i = 0; i < numKeys; i++)
+        {
+            ht.emplace(-i, i);
+        }
+        Excalibur::FrozenHashMap<int, int> frozen(ht);
+        ASSERT_EQ(frozen.size(), uint32_t(numKeys));
+        for (int i = -100; i < 100; i++)
+        {
+            const int* value = frozen.find(i);
+            ASSERT_EQ(value != nullptr, i <= 0 && i > -numKeys);
+            if (value)
+            {
+                EXPECT_EQ(*value, -i);
+            }
+        }
+    }
+}
+
+TEST(FrozenHashSet, HashCollisions)
+{
+    Excalibur::HashSet<uint32_t, 1, PairCollisionKeyInfo> ht;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        ht.emplace(i);
+    }
+
+    Excalibur::FrozenHashSet<uint32_t, PairCollisionKeyInfo> frozen(ht);
+    EXPECT_EQ(frozen.size(), 2000u);
+    // one key of every pair can't be separated by the perfect hash
+    EXPECT_EQ(frozen.getNumOverflowItems(), 1000u);
+    for (uint32_t i = 0; i < 4000; i++)
+    {
+        EXPECT_EQ(frozen.has(i), i < 2000);
+    }
+
+    uint32_t count = 0;
+    frozen.forEach([&count](const uint32_t& key) {
+        EXPECT_LT(key, 2000u);
+        count++;
+    });
+    EXPECT_EQ(count, 2000u);
+}
@@ -0,0 +1,129 @@
+#include "ExcaliburStaticHash.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <string_view>
+
+namespace
+{
+enum class Opcode : uint8_t
+{
+    Nop,
+    Load,
+    Store,
+    Add,
+    Jump
+};
+
+constexpr auto kOpcodes = Excalibur::makeStaticHashMap<std::string_view, Opcode>(
+    {{"nop", Opcode::Nop}, {"load", Opcode::Load}, {"store", Opcode::Store}, {"add", Opcode::Add}, {"jmp", Opcode::Jump}});
+
+constexpr auto kOpcodeNames = Excalibur::makeStaticHashMap<Opcode, std::string_view>(
+    {{Opcode::Nop, "nop"}, {Opcode::Load, "load"}, {Opcode::Store, "store"}, {Opcode::Add, "add"}, {Opcode::Jump, "jmp"}});
+
+// compile-time lookups
+static_assert(kOpcodes.size() == 5, "");
+static_assert(kOpcodes.find("store").value() == Opcode::Store, "");
+static_assert(kOpcodes.find("jmp")->second == Opcode::Jump, "");
+static_assert(kOpcodes.has("add"), "");
+static_assert(!kOpcodes.has("mul"), "");
+static_assert(!kOpcodes.has(""), "");
+static_assert(kOpcodes.find("sub") == kOpcodes.iend(), "");
+static_assert(kOpcodeNames.find(Opcode::Load).value() == "load", "");
+static_assert(kOpcodes.getMaxProbeLength() == 1, "");
+
+struct CaseInsensitiveKeyInfo
+{
+    static constexpr char toLower(char c) noexcept { return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c; }
+    static constexpr size_t hash(std::string_view key) noexcept
+    {
+        uint64_t hashValue = 0;
+        for (char c : key)
+        {
+            hashValue = hashValue * 31 + uint64_t(uint8_t(toLower(c)));
+        }
+        return size_t(hashValue);
+    }
+    static constexpr bool isEqual(std::string_view lhs, std::string_view rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.size(); i++)
+        {
+            if (toLower(lhs[i]) != toLower(rhs[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+constexpr auto kHeaders = Excalibur::makeStaticHashMap<std::string_view, int, CaseInsensitiveKeyInfo>(
+    {{"Content-Type", 1}, {"Content-Length", 2}, {"Host", 3}, {"Accept", 4}, {"Connection", 5}, {"User-Agent", 6}});
+static_assert(kHeaders.find("content-length").value() == 2, "");
+static_assert(kHeaders.has("HOST"), "");
+
+template <size_t... I> constexpr auto makeIntMap(std::index_sequence<I...>)
+{
+    return Excalibur::makeStaticHashMap<int, int>({{int(I * 7), int(I)}...});
+}
+} // namespace
+
+TEST(StaticHashMap, RuntimeLookups)
+{
+    // runtime strings, not literals
+    const std::string store = std::string("st") + "ore";
+    EXPECT_EQ(kOpcodes.find(store).value(), Opcode::Store);
+    EXPECT_FALSE(kOpcodes.has(store + "x"));
+
+    volatile int opIndex = 3;
+    EXPECT_EQ(kOpcodeNames.find(Opcode(opIndex)).value(), "add");
+
+    EXPECT_EQ(kHeaders.find(std::string("USER-agent")).value(), 6);
+    EXPECT_FALSE(kHeaders.has("Cookie"));
+}
+
+TEST(StaticHashMap, Iteration)
+{
+    // declaration order
+    const char* expected[] = {"nop", "load", "store", "add", "jmp"};
+    size_t index = 0;
+    for (const auto& kv : kOpcodes.items())
+    {
+        EXPECT_EQ(kv.first, expected[index]);
+        EXPECT_EQ(kv.second, Opcode(index));
+        index++;
+    }
+    EXPECT_EQ(index, size_t(5));
+
+    index = 0;
+    for (auto it = kOpcodeNames.ibegin(); it != kOpcodeNames.iend(); ++it)
+    {
+        EXPECT_EQ(it.key(), Opcode(index));
+        index++;
+    }
+    EXPECT_EQ(index, size_t(5));
+}
+
+TEST(StaticHashMap, ManyKeys)
+{
+    static constexpr auto kMap = makeIntMap(std::make_index_sequence<200>());
+    static_assert(kMap.size() == 200, "");
+    static_assert(kMap.find(7 * 199).value() == 199, "");
+    EXPECT_GE(kMap.capacity(), kMap.size() * 2);
+    EXPECT_GE(kMap.getMaxProbeLength(), 1u);
+
+    for (int i = -10; i < 200 * 7 + 10; i++)
+    {
+        auto it = kMap.find(i);
+        const bool expectedHit = (i >= 0) && (i % 7) == 0 && (i / 7) < 200;
+        ASSERT_EQ(it != kMap.iend(), expectedHit);
+        if (expectedHit)
+        {
+            EXPECT_EQ(it.key(), i);
+            EXPECT_EQ(it.value(), i / 7);
+        }
+    }
+}
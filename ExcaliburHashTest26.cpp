@@ -0,0 +1,168 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashTestUtils.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using ExcaliburTest::forEachSimdLevel;
+
+namespace
+{
+template <typename TKey, typename TValue, typename TProbing> void testBulkPaths()
+{
+    using Table = Excalibur::HashTable<TKey, TValue, 1, Excalibur::KeyInfo<TKey>, TProbing>;
+    Table ht;
+    const TKey kNumKeys = 20000;
+    for (int round = 0; round < 2; round++)
+    {
+        for (TKey i = 0; i < kNumKeys; i++)
+        {
+            ht.emplace(i * 3, TValue());
+        }
+        EXPECT_EQ(ht.size(), uint32_t(kNumKeys));
+
+        // long runs of tombstones and empty slots
+        for (TKey i = 0; i < kNumKeys; i++)
+        {
+            if ((i % 97) != 0)
+            {
+                EXPECT_TRUE(ht.erase(i * 3));
+            }
+        }
+
+        std::vector<bool> visited(size_t(kNumKeys), false);
+        uint32_t numVisited = 0;
+        for (auto it = ht.ibegin(); it != ht.iend(); ++it)
+        {
+            const TKey key = it.key();
+            ASSERT_EQ(key % 3, TKey(0));
+            ASSERT_EQ((key / 3) % 97, TKey(0));
+            ASSERT_FALSE(visited[size_t(key / 3)]);
+            visited[size_t(key / 3)] = true;
+            numVisited++;
+        }
+        EXPECT_EQ(numVisited, ht.size());
+
+        // lookups over the same storage
+        std::vector<TKey> keys;
+        for (TKey i = 0; i < kNumKeys * 3 + 10; i++)
+        {
+            keys.push_back(i);
+        }
+        const Table& cht = ht;
+        std::vector<typename Table::ConstIteratorKV> results(keys.size(), cht.iend());
+        cht.findBatch(keys.data(), keys.size(), results.data());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            ASSERT_TRUE(results[i] == cht.find(keys[i]));
+        }
+
+        ht.clear();
+        EXPECT_TRUE(ht.empty());
+        EXPECT_TRUE(ht.begin() == ht.end());
+        EXPECT_FALSE(ht.has(0));
+    }
+}
+
+} // namespace
+
+TEST(SimdDispatch, Levels)
+{
+    EXPECT_TRUE(Excalibur::isSimdLevelSupported(Excalibur::SimdLevel::Scalar));
+    EXPECT_TRUE(Excalibur::isSimdLevelSupported(Excalibur::getBestSimdLevel()));
+    EXPECT_EQ(Excalibur::getSimdLevel(), Excalibur::getBestSimdLevel());
+
+    uint32_t numLevels = 0;
+    forEachSimdLevel([&numLevels](Excalibur::SimdLevel) { numLevels++; });
+    EXPECT_GE(numLevels, 1u);
+    EXPECT_EQ(Excalibur::getSimdLevel(), Excalibur::getBestSimdLevel());
+
+#if defined(EXLBR_SIMD_X86)
+    EXPECT_TRUE(Excalibur::isSimdLevelSupported(Excalibur::SimdLevel::SSE2));
+    EXPECT_FALSE(Excalibur::setSimdLevel(Excalibur::SimdLevel::NEON));
+#endif
+}
+
+TEST(SimdDispatch, KernelsMatchScalar)
+{
+    const Excalibur::detail::SimdKernels& scalar = *Excalibur::detail::getSimdKernels(Excalibur::SimdLevel::Scalar);
+    forEachSimdLevel([&scalar](Excalibur::SimdLevel level) {
+        const Excalibur::detail::SimdKernels& kernels = *Excalibur::detail::getSimdKernels(level);
+        uint64_t rnd = 0x9E3779B97F4A7C15ull;
+        auto next = [&rnd]() {
+            rnd = rnd * 6364136223846793005ull + 1442695040888963407ull;
+            return rnd >> 17;
+        };
+
+        // built-in sentinels (differ in one bit = single compare) and arbitrary ones (two compares)
+        const uint64_t kSentinels[][3] = {{4, 0x7ffffffeull, 0x7fffffffull},
+                                          {8, 0xffffffffffffffffull, 0xfffffffffffffffeull},
+                                          {4, 0x5a5a5a5aull, 0x0ull},
+                                          {8, 0x0ull, 0x8000000000000001ull}};
+        for (const uint64_t(&sentinels)[3] : kSentinels)
+        {
+            const size_t keySize = size_t(sentinels[0]);
+            const uint64_t emptyKey = sentinels[1];
+            const uint64_t tombstoneKey = sentinels[2];
+            for (size_t itemSize = keySize; itemSize <= 64; itemSize *= 2)
+            {
+                const size_t kNumItems = 300;
+                std::vector<uint8_t> items(kNumItems * itemSize);
+                std::vector<uint8_t> expected(kNumItems * itemSize);
+                std::vector<uint8_t> pattern(itemSize);
+                for (uint8_t& b : pattern)
+                {
+                    b = uint8_t(next());
+                }
+
+                // fill (all sizes, including tails)
+                for (size_t numItems : {size_t(0), size_t(1), size_t(7), size_t(64), size_t(kNumItems)})
+                {
+                    std::fill(items.begin(), items.end(), uint8_t(0));
+                    std::fill(expected.begin(), expected.end(), uint8_t(0));
+                    kernels.fillItems(items.data(), numItems, pattern.data(), itemSize);
+                    scalar.fillItems(expected.data(), numItems, pattern.data(), itemSize);
+                    ASSERT_EQ(items, expected);
+                }
+
+                // scan: random garbage outside of the keys, a single valid key at every position
+                for (uint8_t& b : items)
+                {
+                    b = uint8_t(next());
+                }
+                for (size_t i = 0; i < kNumItems; i++)
+                {
+                    Excalibur::detail::storeKey(&items[i * itemSize], keySize, (next() & 1) ? emptyKey : tombstoneKey);
+                }
+                for (size_t start = 0; start < 70; start++)
+                {
+                    for (size_t validIndex = start; validIndex <= kNumItems; validIndex += 5)
+                    {
+                        std::vector<uint8_t> data = items;
+                        if (validIndex < kNumItems)
+                        {
+                            // differs from the empty key in the last byte only
+                            const uint64_t validKey = emptyKey ^ (uint64_t(0x80) << ((keySize - 1) * 8));
+                            Excalibur::detail::storeKey(&data[validIndex * itemSize], keySize, validKey);
+                        }
+                        const size_t numItems = kNumItems - start;
+                        const size_t res =
+                            kernels.findValidKey(&data[start * itemSize], numItems, itemSize, keySize, emptyKey, tombstoneKey);
+                        ASSERT_EQ(res, validIndex - start);
+                    }
+                }
+            }
+        }
+    });
+}
+
+TEST(SimdDispatch, TableBulkPaths)
+{
+    forEachSimdLevel([](Excalibur::SimdLevel) {
+        testBulkPaths<uint64_t, uint64_t, Excalibur::LinearProbing>();
+        testBulkPaths<int32_t, uint32_t, Excalibur::LinearProbing>();
+        testBulkPaths<uint32_t, std::nullptr_t, Excalibur::LinearProbing>();
+        testBulkPaths<int64_t, std::nullptr_t, Excalibur::RobinHoodProbing>();
+        testBulkPaths<uint32_t, std::string, Excalibur::LinearProbing>();
+    });
+}
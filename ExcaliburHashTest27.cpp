@@ -0,0 +1,171 @@
+#include "ExcaliburHash.h"
+#include "ExcaliburHashTestUtils.h"
+#include "gtest/gtest.h"
+#include <limits>
+#include <vector>
+
+using ExcaliburTest::forEachSimdLevel;
+
+namespace
+{
+template <typename TKey> std::vector<TKey> makeTestKeys()
+{
+    std::vector<TKey> keys = {TKey(0), TKey(1), TKey(-1), TKey(2), TKey(0x7fffffff), TKey(0x80000000u), TKey(0xffffffffu)};
+    keys.push_back(std::numeric_limits<TKey>::min());
+    keys.push_back(std::numeric_limits<TKey>::max());
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+    while (keys.size() < 1000)
+    {
+        rnd = rnd * 6364136223846793005ull + 1442695040888963407ull;
+        keys.push_back(TKey(rnd ^ (rnd >> 29)));
+    }
+    return keys;
+}
+
+template <typename TKey> void testHashN()
+{
+    const std::vector<TKey> keys = makeTestKeys<TKey>();
+    forEachSimdLevel(
+        [&keys](Excalibur::SimdLevel)
+        {
+            // every length (vector body + scalar tail) and unaligned starts
+            for (size_t offset = 0; offset < 3; offset++)
+            {
+                for (size_t numKeys = 0; numKeys <= 40; numKeys++)
+                {
+                    std::vector<size_t> hashes(numKeys + 1, 0xdeadbeef);
+                    Excalibur::wyhash::hashN(keys.data() + offset, hashes.data(), numKeys);
+                    for (size_t i = 0; i < numKeys; i++)
+                    {
+                        ASSERT_EQ(hashes[i], Excalibur::wyhash::hash(keys[offset + i])) << numKeys << " " << i;
+                    }
+                    EXPECT_EQ(hashes[numKeys], size_t(0xdeadbeef));
+                }
+            }
+
+            std::vector<size_t> hashes(keys.size());
+            Excalibur::wyhash::hashN(keys.data(), hashes.data(), keys.size());
+            for (size_t i = 0; i < keys.size(); i++)
+            {
+                ASSERT_EQ(hashes[i], Excalibur::wyhash::hash(keys[i]));
+                ASSERT_EQ(hashes[i], Excalibur::KeyInfo<TKey>::hash(keys[i]));
+            }
+        });
+}
+
+// hashN has to agree with hash, counts the keys hashed in bulk
+struct BulkKeyInfo
+{
+    static inline size_t numBulkHashed = 0;
+
+    static inline bool isValid(const uint64_t& key) noexcept { return key < UINT64_C(0xfffffffffffffffe); }
+    static inline uint64_t getTombstone() noexcept { return UINT64_C(0xfffffffffffffffe); }
+    static inline uint64_t getEmpty() noexcept { return UINT64_C(0xffffffffffffffff); }
+    static inline size_t hash(const uint64_t& key) noexcept { return size_t(key * 31); }
+    static inline void hashN(const uint64_t* keys, size_t* out, size_t numKeys) noexcept
+    {
+        numBulkHashed += numKeys;
+        for (size_t i = 0; i < numKeys; i++)
+        {
+            out[i] = hash(keys[i]);
+        }
+    }
+    static inline bool isEqual(const uint64_t& lhs, const uint64_t& rhs) noexcept { return lhs == rhs; }
+};
+
+// derives from the built-in KeyInfo and changes hash() only, the inherited hashN() must not be used
+struct DerivedKeyInfo : public Excalibur::KeyInfo<uint64_t>
+{
+    static inline size_t hash(const uint64_t& key) noexcept { return size_t(key >> 3); }
+};
+
+} // namespace
+
+TEST(WyHashN, MatchesScalar)
+{
+    testHashN<uint64_t>();
+    testHashN<int64_t>();
+    testHashN<uint32_t>();
+    testHashN<int32_t>();
+}
+
+TEST(WyHashN, TableBulkPaths)
+{
+    forEachSimdLevel(
+        [](Excalibur::SimdLevel)
+        {
+            Excalibur::HashMap<int32_t, int32_t> ht;
+            std::vector<int32_t> keys;
+            std::vector<int32_t> values;
+            for (int32_t i = 0; i < 5000; i++)
+            {
+                keys.push_back(i * 7 - 10000);
+                values.push_back(i);
+            }
+
+            // batch insert + several rehashes
+            EXPECT_EQ(ht.emplaceBatch(keys.data(), values.data(), 2500), 2500u);
+            for (size_t i = 2500; i < keys.size(); i++)
+            {
+                ht.emplace(keys[i], values[i]);
+            }
+            EXPECT_EQ(ht.size(), uint32_t(keys.size()));
+            ht.rehash();
+
+            keys.push_back(-10001);
+            keys.push_back(25000);
+            const Excalibur::HashMap<int32_t, int32_t>& cht = ht;
+            std::vector<Excalibur::HashMap<int32_t, int32_t>::ConstIteratorKV> found(keys.size(), cht.iend());
+            cht.findBatch(keys.data(), keys.size(), found.data());
+            for (size_t i = 0; i < keys.size(); i++)
+            {
+                if (i < values.size())
+                {
+                    ASSERT_NE(found[i], cht.iend());
+                    EXPECT_EQ(found[i].value(), values[i]);
+                }
+                else
+                {
+                    EXPECT_EQ(found[i], cht.iend());
+                }
+            }
+        });
+}
+
+TEST(WyHashN, CustomKeyInfo)
+{
+    Excalibur::HashSet<uint64_t, 1, BulkKeyInfo> ht;
+    BulkKeyInfo::numBulkHashed = 0;
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        ht.emplace(i * 12345);
+    }
+    // every grow re-hashes the existing keys in bulk
+    EXPECT_GT(BulkKeyInfo::numBulkHashed, size_t(0));
+
+    BulkKeyInfo::numBulkHashed = 0;
+    ht.rehash();
+    EXPECT_EQ(BulkKeyInfo::numBulkHashed, size_t(1000));
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        ASSERT_TRUE(ht.has(i * 12345));
+    }
+    EXPECT_FALSE(ht.has(1));
+}
+
+TEST(WyHashN, DerivedKeyInfo)
+{
+    Excalibur::HashSet<uint64_t, 1, DerivedKeyInfo> ht;
+    std::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 3000; i++)
+    {
+        keys.push_back(i * 3);
+    }
+    EXPECT_EQ(ht.emplaceBatch(keys.data(), keys.size()), 3000u);
+    ht.rehash();
+    for (uint64_t key : keys)
+    {
+        EXPECT_TRUE(ht.has(key));
+    }
+    EXPECT_FALSE(ht.has(1));
+}
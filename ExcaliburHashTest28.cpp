@@ -0,0 +1,159 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(WyHashBytes, TestVectors)
+{
+    // reference values of wyhash final4 (seed = index)
+    const char* messages[] = {"",
+                              "a",
+                              "abc",
+                              "message digest",
+                              "abcdefghijklmnopqrstuvwxyz",
+                              "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+                              "12345678901234567890123456789012345678901234567890123456789012345678901234567890"};
+    const uint64_t expected[] = {UINT64_C(0x93228a4de0eec5a2), UINT64_C(0xc5bac3db178713c4), UINT64_C(0xa97f2f7b1d9b3314),
+                                 UINT64_C(0x786d1f1df3801df4), UINT64_C(0xdca5a8138ad37c87), UINT64_C(0xb9e734f117cfaf70),
+                                 UINT64_C(0x6cc5eab49a92d617)};
+    for (size_t i = 0; i < std::size(messages); i++)
+    {
+        EXPECT_EQ(Excalibur::wyhash::hashBytes64(messages[i], strlen(messages[i]), i), expected[i]) << messages[i];
+    }
+}
+
+TEST(WyHashBytes, AllLengths)
+{
+    // every code path (0, 1..3, 4..16, 17..47, 48+ with tails), unaligned data, no two lengths/offsets collide
+    std::vector<uint8_t> buffer(1100);
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = uint8_t(i * 131 + 7);
+    }
+
+    std::set<uint64_t> hashes;
+    size_t numHashes = 0;
+    for (size_t offset = 0; offset < 4; offset++)
+    {
+        // the empty input is the same at every offset
+        for (size_t len = (offset == 0) ? 0 : 1; len <= 1025; len++)
+        {
+            const uint64_t h = Excalibur::wyhash::hashBytes64(buffer.data() + offset, len);
+            hashes.insert(h);
+            numHashes++;
+
+            // the result only depends on the bytes, not on the address
+            std::vector<uint8_t> copy(buffer.begin() + ptrdiff_t(offset), buffer.begin() + ptrdiff_t(offset + len));
+            ASSERT_EQ(Excalibur::wyhash::hashBytes64(copy.data(), copy.size()), h);
+            // seeded hashes differ
+            ASSERT_NE(Excalibur::wyhash::hashBytes64(copy.data(), copy.size(), 1), h);
+        }
+    }
+    EXPECT_EQ(hashes.size(), numHashes);
+
+    // every single bit flip changes the hash
+    for (size_t len : {1, 3, 4, 15, 16, 17, 47, 48, 49, 100})
+    {
+        std::vector<uint8_t> data(buffer.begin(), buffer.begin() + ptrdiff_t(len));
+        const uint64_t h = Excalibur::wyhash::hashBytes64(data.data(), len);
+        for (size_t bit = 0; bit < len * 8; bit++)
+        {
+            data[bit / 8] ^= uint8_t(1u << (bit % 8));
+            ASSERT_NE(Excalibur::wyhash::hashBytes64(data.data(), len), h) << len << " " << bit;
+            data[bit / 8] ^= uint8_t(1u << (bit % 8));
+        }
+    }
+}
+
+TEST(WyHashBytes, StringKeyInfosAgree)
+{
+    const std::string str = "https://example.com/some/long/path?with=query&and=more";
+    const std::string_view view = str;
+    const size_t h = Excalibur::KeyInfo<std::string>::hash(str);
+    EXPECT_EQ(h, Excalibur::wyhash::hashBytes(str.data(), str.size()));
+    EXPECT_EQ(h, Excalibur::KeyInfo<std::string>::hash(view));
+    EXPECT_EQ(h, Excalibur::KeyInfo<std::string>::hash(str.c_str()));
+    EXPECT_EQ(h, Excalibur::KeyInfo<std::string_view>::hash(view));
+    EXPECT_EQ(h, Excalibur::KeyInfo<const char*>::hash(str.c_str()));
+}
+
+TEST(WyHashBytes, StringViewKeys)
+{
+    // keys point into 'storage'
+    std::vector<std::string> storage;
+    for (int i = 0; i < 2000; i++)
+    {
+        storage.push_back("/api/v1/items/" + std::to_string(i));
+    }
+
+    Excalibur::HashMap<std::string_view, int> ht;
+    for (int i = 0; i < 2000; i++)
+    {
+        EXPECT_TRUE(ht.emplace(std::string_view(storage[size_t(i)]), i).second);
+    }
+    for (int i = 0; i < 2000; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(std::string_view(storage[size_t(i)])));
+    }
+    EXPECT_EQ(ht.size(), 1000u);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        // a different buffer with the same characters
+        const std::string key = "/api/v1/items/" + std::to_string(i);
+        auto it = ht.find(std::string_view(key));
+        if ((i % 2) == 0)
+        {
+            EXPECT_EQ(it, ht.iend());
+        }
+        else
+        {
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value(), i);
+        }
+    }
+    EXPECT_FALSE(ht.has(std::string_view("/api/v1/items/")));
+}
+
+TEST(WyHashBytes, CStringKeys)
+{
+    std::vector<std::string> storage;
+    for (int i = 0; i < 1000; i++)
+    {
+        storage.push_back(std::to_string(i * 7));
+    }
+    storage.push_back("");
+
+    Excalibur::HashMap<const char*, int> ht;
+    for (size_t i = 0; i < storage.size(); i++)
+    {
+        EXPECT_TRUE(ht.emplace(storage[i].c_str(), int(i)).second);
+    }
+    // compared by content
+    const std::string dup = storage[10];
+    EXPECT_FALSE(ht.emplace(dup.c_str(), -1).second);
+    EXPECT_EQ(ht.size(), uint32_t(storage.size()));
+
+    for (size_t i = 0; i < storage.size(); i += 3)
+    {
+        const std::string key = storage[i];
+        EXPECT_TRUE(ht.erase(key.c_str()));
+    }
+    for (size_t i = 0; i < storage.size(); i++)
+    {
+        const std::string key = storage[i];
+        auto it = ht.find(key.c_str());
+        if ((i % 3) == 0)
+        {
+            EXPECT_EQ(it, ht.iend());
+        }
+        else
+        {
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value(), int(i));
+        }
+    }
+    EXPECT_FALSE(ht.has("not there"));
+}
@@ -0,0 +1,120 @@
+#include "ExcaliburHashPolicies.h"
+#include "gtest/gtest.h"
+#include <set>
+
+namespace
+{
+template <typename TKey, typename THashPolicy>
+using PolicyMap = Excalibur::HashMap<TKey, TKey, 1, Excalibur::HashPolicyKeyInfo<Excalibur::KeyInfo<TKey>, THashPolicy>>;
+
+template <typename TKey, typename THashPolicy> void testPolicyMap()
+{
+    PolicyMap<TKey, THashPolicy> ht;
+    // strided keys are a bad case for the weaker hashes, the table still has to work
+    const int kNumKeys = 5000;
+    for (int i = 0; i < kNumKeys; i++)
+    {
+        const TKey key = TKey(i) * TKey(64);
+        EXPECT_TRUE(ht.emplace(key, key + 1).second);
+    }
+    for (int i = 0; i < kNumKeys; i += 2)
+    {
+        EXPECT_TRUE(ht.erase(TKey(i) * TKey(64)));
+    }
+    EXPECT_EQ(ht.size(), uint32_t(kNumKeys / 2));
+
+    for (int i = 0; i < kNumKeys; i++)
+    {
+        const TKey key = TKey(i) * TKey(64);
+        auto it = ht.find(key);
+        if ((i % 2) == 0)
+        {
+            EXPECT_EQ(it, ht.iend());
+        }
+        else
+        {
+            ASSERT_NE(it, ht.iend());
+            EXPECT_EQ(it.value(), key + 1);
+        }
+        EXPECT_FALSE(ht.has(key + 1));
+    }
+}
+} // namespace
+
+TEST(HashPolicies, Crc32cVectors)
+{
+    // standard CRC32C of the little-endian key bytes
+    EXPECT_EQ(Excalibur::crc32c::hash(uint32_t(0)), UINT32_C(0x48674bc7));
+    EXPECT_EQ(Excalibur::crc32c::hash(uint32_t(1)), UINT32_C(0x9522e17f));
+    EXPECT_EQ(Excalibur::crc32c::hash(uint32_t(0x12345678)), UINT32_C(0xb2131df3));
+    EXPECT_EQ(Excalibur::crc32c::hash(uint64_t(0)), UINT32_C(0x8c28b28a));
+    EXPECT_EQ(Excalibur::crc32c::hash(uint64_t(1)), UINT32_C(0xc514cfad));
+    EXPECT_EQ(Excalibur::crc32c::hash(UINT64_C(0x0123456789abcdef)), UINT32_C(0x65b0d823));
+}
+
+TEST(HashPolicies, Crc32cHardwareMatchesSoftware)
+{
+    uint64_t v = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 10000; i++)
+    {
+        v = v * 6364136223846793005ull + 1442695040888963407ull;
+        EXPECT_EQ(Excalibur::crc32c::hash(v), ~Excalibur::crc32c::detail::updateSoftware(UINT32_C(0xffffffff), v, 8));
+        EXPECT_EQ(Excalibur::crc32c::hash(uint32_t(v)), ~Excalibur::crc32c::detail::updateSoftware(UINT32_C(0xffffffff), uint32_t(v), 4));
+    }
+}
+
+TEST(HashPolicies, Values)
+{
+    // WyHash is what the built-in KeyInfo uses
+    for (int32_t key : {0, 1, -1, 12345, INT32_C(0x7ffffffd), INT32_MIN})
+    {
+        EXPECT_EQ(Excalibur::WyHash::hash(key), Excalibur::KeyInfo<int32_t>::hash(key));
+        EXPECT_EQ(Excalibur::WyHash::hash(uint32_t(key)), Excalibur::KeyInfo<uint32_t>::hash(uint32_t(key)));
+        EXPECT_EQ(Excalibur::WyHash::hash(int64_t(key)), Excalibur::KeyInfo<int64_t>::hash(int64_t(key)));
+        EXPECT_EQ(Excalibur::WyHash::hash(uint64_t(key)), Excalibur::KeyInfo<uint64_t>::hash(uint64_t(key)));
+        // signed keys are hashed like their unsigned representation
+        EXPECT_EQ(Excalibur::Crc32cHash::hash(key), Excalibur::Crc32cHash::hash(uint32_t(key)));
+        EXPECT_EQ(Excalibur::Fmix64Hash::hash(key), Excalibur::Fmix64Hash::hash(uint32_t(key)));
+    }
+
+    EXPECT_EQ(Excalibur::IdentityHash::hash(uint32_t(0xdeadbeef)), size_t(0xdeadbeef));
+    EXPECT_EQ(Excalibur::Fmix64Hash::hash(uint64_t(0)), size_t(0));
+    EXPECT_EQ(uint64_t(Excalibur::Fmix64Hash::hash(uint64_t(1))), Excalibur::detail::fmix64(1));
+
+    // bijections: no collisions on sequential keys
+    std::set<size_t> crcHashes;
+    std::set<size_t> fmixHashes;
+    for (uint32_t i = 0; i < 4096; i++)
+    {
+        crcHashes.insert(Excalibur::Crc32cHash::hash(i));
+        fmixHashes.insert(Excalibur::Fmix64Hash::hash(uint64_t(i) << 32));
+    }
+    EXPECT_EQ(crcHashes.size(), 4096u);
+    EXPECT_EQ(fmixHashes.size(), 4096u);
+}
+
+TEST(HashPolicies, Tables)
+{
+    testPolicyMap<uint32_t, Excalibur::WyHash>();
+    testPolicyMap<uint32_t, Excalibur::Crc32cHash>();
+    testPolicyMap<uint32_t, Excalibur::Fmix64Hash>();
+    testPolicyMap<uint32_t, Excalibur::IdentityHash>();
+    testPolicyMap<int64_t, Excalibur::WyHash>();
+    testPolicyMap<int64_t, Excalibur::Crc32cHash>();
+    testPolicyMap<int64_t, Excalibur::Fmix64Hash>();
+    testPolicyMap<int64_t, Excalibur::IdentityHash>();
+}
+
+TEST(HashPolicies, IdentityForPrehashedKeys)
+{
+    // identity keeps the key order inside the bucket array: pre-hashed keys land in their home bucket
+    PolicyMap<uint64_t, Excalibur::IdentityHash> ht;
+    ht.reserve(1024);
+    for (uint64_t i = 0; i < 512; i++)
+    {
+        ht.emplace(i, i);
+    }
+    const Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numElements, 512u);
+    EXPECT_EQ(histogram.maxDisplacement, 0u);
+}
@@ -0,0 +1,203 @@
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+using SeededKeyInfo64 = Excalibur::SeededKeyInfo<Excalibur::KeyInfo<uint64_t>>;
+
+// keys that share the low 12 bits of their hash under seed 0, i.e. an attacker who knows the hash function
+std::vector<uint64_t> makeFloodingKeys(size_t numKeys)
+{
+    std::vector<uint64_t> keys;
+    for (uint64_t key = 0; keys.size() < numKeys; key++)
+    {
+        if ((SeededKeyInfo64::hash(key, 0) & 0xfff) == 0)
+        {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+// flooded keys sit hundreds of buckets away from home, spread out ones a few buckets at most.
+// note: not the maximum, a single natural long probe after the one reseed per table size is a matter of luck
+double getAverageDisplacement(const Excalibur::ProbeHistogram& histogram)
+{
+    uint64_t totalDisplacement = 0;
+    for (size_t d = 0; d < histogram.displacement.size(); d++)
+    {
+        totalDisplacement += uint64_t(d) * histogram.displacement[d];
+    }
+    return double(totalDisplacement) / double(std::max(histogram.numElements, 1u));
+}
+
+// every key has the same full hash, reseeding can't help
+struct ConstantHashKeyInfo : public Excalibur::KeyInfo<int32_t>
+{
+    static inline size_t hash(const int32_t& /*key*/) noexcept { return 3; }
+};
+
+template <typename TProbing, bool kBatch = false> void testFlooding()
+{
+    const std::vector<uint64_t> keys = makeFloodingKeys(1500);
+
+    Excalibur::HashMap<uint64_t, uint64_t, 1, SeededKeyInfo64, TProbing> ht;
+    // the worst case: the attacker knows the seed
+    ht.reseed(0);
+    EXPECT_EQ(ht.getHashSeed(), 0u);
+#if defined(EXLBR_ENABLE_STATS)
+    const uint64_t numExplicitReseeds = ht.getStats().numReseeds;
+#endif
+    if constexpr (kBatch)
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> items;
+        for (uint64_t key : keys)
+        {
+            items.emplace_back(key, key * 3);
+        }
+        EXPECT_EQ(ht.insertBatch(items.begin(), items.end()), uint32_t(keys.size()));
+    }
+    else
+    {
+        for (uint64_t key : keys)
+        {
+            EXPECT_TRUE(ht.emplace(key, key * 3).second);
+        }
+    }
+    EXPECT_NE(ht.getHashSeed(), 0u);
+#if defined(EXLBR_ENABLE_STATS)
+    EXPECT_GT(ht.getStats().numReseeds, numExplicitReseeds);
+#endif
+
+    // the keys no longer collide
+    const Excalibur::ProbeHistogram histogram = ht.computeProbeHistogram();
+    EXPECT_EQ(histogram.numElements, uint32_t(keys.size()));
+    EXPECT_LT(getAverageDisplacement(histogram), 8.0);
+
+    EXPECT_EQ(ht.size(), uint32_t(keys.size()));
+    for (uint64_t key : keys)
+    {
+        auto it = ht.find(key);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), key * 3);
+        EXPECT_FALSE(ht.emplace(key, 0).second);
+    }
+}
+} // namespace
+
+TEST(SeededHash, Hashes)
+{
+    for (uint64_t key : {uint64_t(0), uint64_t(1), uint64_t(123456789), UINT64_C(0xfffffffffffffffd)})
+    {
+        EXPECT_EQ(SeededKeyInfo64::hash(key, 17), Excalibur::wyhash::hash(key, 17));
+        EXPECT_NE(SeededKeyInfo64::hash(key, 17), SeededKeyInfo64::hash(key, 18));
+        // the unseeded hash is still there for other containers
+        EXPECT_EQ(SeededKeyInfo64::hash(key), Excalibur::KeyInfo<uint64_t>::hash(key));
+    }
+    EXPECT_EQ(Excalibur::KeyInfo<int32_t>::hash(-1, 5), Excalibur::KeyInfo<uint32_t>::hash(0xffffffffu, 5));
+
+    using SeededStringKeyInfo = Excalibur::SeededKeyInfo<Excalibur::KeyInfo<std::string>>;
+    const std::string str = "client-42";
+    EXPECT_EQ(SeededStringKeyInfo::hash(str, 9), Excalibur::wyhash::hashBytes(str.data(), str.size(), 9));
+    EXPECT_EQ(SeededStringKeyInfo::hash(std::string_view(str), 9), SeededStringKeyInfo::hash(str, 9));
+    EXPECT_EQ(SeededStringKeyInfo::hash(str.c_str(), 9), SeededStringKeyInfo::hash(str, 9));
+
+    // a base KeyInfo without a seeded hash gets its hash mixed with the seed
+    using SeededConstant = Excalibur::SeededKeyInfo<ConstantHashKeyInfo>;
+    EXPECT_EQ(SeededConstant::hash(1, 7), size_t(Excalibur::detail::fmix64(3 ^ 7)));
+    EXPECT_EQ(SeededConstant::hash(1, 7), SeededConstant::hash(2, 7));
+}
+
+TEST(SeededHash, RandomSeedPerTable)
+{
+    using TMap = Excalibur::HashMap<uint64_t, uint64_t, 1, SeededKeyInfo64>;
+    TMap a;
+    TMap b;
+    EXPECT_NE(a.getHashSeed(), b.getHashSeed());
+
+    // keys chosen against seed 0 don't collide in a fresh table
+    const std::vector<uint64_t> keys = makeFloodingKeys(1500);
+    for (uint64_t key : keys)
+    {
+        a.emplace(key, key);
+    }
+    EXPECT_LT(getAverageDisplacement(a.computeProbeHistogram()), 8.0);
+#if defined(EXLBR_ENABLE_STATS)
+    EXPECT_EQ(a.getStats().numReseeds, 0u);
+#endif
+}
+
+TEST(SeededHash, FloodingTriggersReseed)
+{
+    testFlooding<Excalibur::LinearProbing>();
+    testFlooding<Excalibur::RobinHoodProbing>();
+}
+
+TEST(SeededHash, BatchFloodingTriggersReseed)
+{
+    testFlooding<Excalibur::LinearProbing, true>();
+    testFlooding<Excalibur::RobinHoodProbing, true>();
+}
+
+TEST(SeededHash, IdenticalHashes)
+{
+    // reseeding doesn't help here, the table still works and only reseeds once per size
+    Excalibur::HashMap<int32_t, int32_t, 1, Excalibur::SeededKeyInfo<ConstantHashKeyInfo, 16>> ht;
+    const int kNumElements = 600;
+    for (int i = 0; i < kNumElements; i++)
+    {
+        EXPECT_TRUE(ht.emplace(i, i + 1).second);
+    }
+#if defined(EXLBR_ENABLE_STATS)
+    EXPECT_GE(ht.getStats().numReseeds, 1u);
+    EXPECT_LE(ht.getStats().numReseeds, ht.getStats().numResizes);
+#endif
+    for (int i = 0; i < kNumElements; i++)
+    {
+        auto it = ht.find(i);
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i + 1);
+    }
+    EXPECT_FALSE(ht.has(kNumElements));
+}
+
+TEST(SeededHash, ExplicitSeedCopyAndMove)
+{
+    using TMap = Excalibur::HashMap<std::string, int, 1, Excalibur::SeededKeyInfo<Excalibur::CachedHashKeyInfo<Excalibur::KeyInfo<std::string>>>>;
+    TMap ht;
+    for (int i = 0; i < 1000; i++)
+    {
+        ht.emplace("key" + std::to_string(i), i);
+    }
+
+    // cached hashes are recomputed with the new seed
+    ht.reseed(0x1234);
+    EXPECT_EQ(ht.getHashSeed(), 0x1234u);
+    ht.reseed();
+    const uint64_t seed = ht.getHashSeed();
+    EXPECT_NE(seed, 0x1234u);
+    for (int i = 0; i < 1000; i++)
+    {
+        auto it = ht.find(std::string_view("key" + std::to_string(i)));
+        ASSERT_NE(it, ht.iend());
+        EXPECT_EQ(it.value(), i);
+    }
+
+    TMap copy(ht);
+    EXPECT_EQ(copy.getHashSeed(), seed);
+    TMap assigned;
+    assigned = copy;
+    EXPECT_EQ(assigned.getHashSeed(), seed);
+    TMap moved(std::move(copy));
+    EXPECT_EQ(moved.getHashSeed(), seed);
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT_EQ(assigned.size(), 1000u);
+    for (int i = 0; i < 1000; i += 7)
+    {
+        EXPECT_EQ(moved.find("key" + std::to_string(i)).value(), i);
+        EXPECT_EQ(assigned.find("key" + std::to_string(i)).value(), i);
+    }
+}
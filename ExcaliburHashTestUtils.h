@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ExcaliburHash.h"
+#include "gtest/gtest.h"
+
+// helpers shared by the tests
+
+namespace ExcaliburTest
+{
+
+struct AllocStats
+{
+    int numAllocs = 0;
+    int numFrees = 0;
+    size_t numBytesAlive = 0;
+};
+
+// stateful allocator (handle to the stats object)
+struct CountingAllocator
+{
+    explicit CountingAllocator(AllocStats& _stats)
+        : stats(&_stats)
+    {
+    }
+
+    void* allocate(size_t numBytes, size_t alignment)
+    {
+        stats->numAllocs++;
+        stats->numBytesAlive += numBytes;
+        return EXLBR_ALLOC(numBytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t numBytes, size_t /*alignment*/)
+    {
+        stats->numFrees++;
+        EXPECT_GE(stats->numBytesAlive, numBytes);
+        stats->numBytesAlive -= numBytes;
+        EXLBR_FREE(ptr);
+    }
+
+    AllocStats* stats;
+};
+
+inline constexpr Excalibur::SimdLevel kAllSimdLevels[] = {Excalibur::SimdLevel::Scalar, Excalibur::SimdLevel::SSE2, Excalibur::SimdLevel::AVX2,
+                                                          Excalibur::SimdLevel::AVX512, Excalibur::SimdLevel::NEON};
+
+// runs func(level) once for every instruction set this CPU supports
+template <typename TFunc> void forEachSimdLevel(TFunc&& func)
+{
+    for (Excalibur::SimdLevel level : kAllSimdLevels)
+    {
+        if (!Excalibur::setSimdLevel(level))
+        {
+            continue;
+        }
+        SCOPED_TRACE(Excalibur::getSimdLevelName(level));
+        EXPECT_EQ(Excalibur::getSimdLevel(), level);
+        func(level);
+    }
+    EXPECT_TRUE(Excalibur::setSimdLevel(Excalibur::getBestSimdLevel()));
+}
+
+} // namespace ExcaliburTest